@@ -217,10 +217,8 @@ void AsYouTypeFormatter::NarrowDownPossibleFormats(
     int last_leading_digits_pattern = format.leading_digits_pattern_size() - 1;
     if (last_leading_digits_pattern > index_of_leading_digits_pattern)
       last_leading_digits_pattern = index_of_leading_digits_pattern;
-    const scoped_ptr<RegExpInput> input(
-        regexp_factory_->CreateInput(leading_digits));
     if (!regexp_cache_.GetRegExp(format.leading_digits_pattern().Get(
-            last_leading_digits_pattern)).Consume(input.get())) {
+            last_leading_digits_pattern)).Consume(leading_digits, NULL)) {
       it = possible_formats_.erase(it);
       continue;
     }
@@ -614,16 +612,14 @@ void AsYouTypeFormatter::RemoveNationalPrefixFromNationalNumber(
     prefix_before_national_number_.push_back(kSeparatorBeforeNationalNumber);
     is_complete_number_ = true;
   } else if (current_metadata_->has_national_prefix_for_parsing()) {
-    const scoped_ptr<RegExpInput> consumed_input(
-        regexp_factory_->CreateInput(national_number_));
     const RegExp& pattern = regexp_cache_.GetRegExp(
         current_metadata_->national_prefix_for_parsing());
 
     // Since some national prefix patterns are entirely optional, check that a
     // national prefix could actually be extracted.
-    if (pattern.Consume(consumed_input.get())) {
-      start_of_national_number = static_cast<int>(
-          national_number_.length() - consumed_input->ToString().length());
+    size_t end_of_national_prefix;
+    if (pattern.Consume(national_number_, &end_of_national_prefix)) {
+      start_of_national_number = static_cast<int>(end_of_national_prefix);
       if (start_of_national_number > 0) {
         // When the national prefix is detected, we use international formatting
         // rules instead of national ones, because national formatting rules
@@ -15,7 +15,8 @@
 #ifndef I18N_PHONENUMBERS_BASE_MEMORY_SINGLETON_BOOST_H_
 #define I18N_PHONENUMBERS_BASE_MEMORY_SINGLETON_BOOST_H_
 
-#include <boost/scoped_ptr.hpp>
+#include <atomic>
+
 #include <boost/thread/once.hpp>
 #include <boost/utility.hpp>
 
@@ -28,21 +29,26 @@ class Singleton : private boost::noncopyable {
   Singleton() {}
   virtual ~Singleton() {}
 
+  // Once the instance has been published, this is a single acquire load.
   static T* GetInstance() {
-    boost::call_once(Init, flag_);
-    return instance_.get();
+    T* instance = instance_.load(std::memory_order_acquire);
+    if (!instance) {
+      boost::call_once(Init, flag_);
+      instance = instance_.load(std::memory_order_acquire);
+    }
+    return instance;
   }
 
  private:
   static void Init() {
-    instance_.reset(new T());
+    instance_.store(new T(), std::memory_order_release);
   }
 
-  static boost::scoped_ptr<T> instance_;
+  static std::atomic<T*> instance_;  // Leaky singleton.
   static boost::once_flag flag_;
 };
 
-template <class T> boost::scoped_ptr<T> Singleton<T>::instance_;
+template <class T> std::atomic<T*> Singleton<T>::instance_(NULL);
 template <class T> boost::once_flag Singleton<T>::flag_ = BOOST_ONCE_INIT;
 
 }  // namespace phonenumbers
@@ -17,6 +17,8 @@
 
 #include <pthread.h>
 
+#include <atomic>
+
 #include "phonenumbers/base/logging.h"
 
 namespace i18n {
@@ -27,23 +29,28 @@ class Singleton {
  public:
   virtual ~Singleton() {}
 
+  // Once the instance has been published, this is a single acquire load.
   static T* GetInstance() {
-    const int ret = pthread_once(&once_control_, &Init);
-    (void) ret;
-    DCHECK_EQ(0, ret);
-    return instance_;
+    T* instance = instance_.load(std::memory_order_acquire);
+    if (!instance) {
+      const int ret = pthread_once(&once_control_, &Init);
+      (void) ret;
+      DCHECK_EQ(0, ret);
+      instance = instance_.load(std::memory_order_acquire);
+    }
+    return instance;
   }
 
  private:
   static void Init() {
-    instance_ = new T();
+    instance_.store(new T(), std::memory_order_release);
   }
 
-  static T* instance_;  // Leaky singleton.
+  static std::atomic<T*> instance_;  // Leaky singleton.
   static pthread_once_t once_control_;
 };
 
-template <class T> T* Singleton<T>::instance_;
+template <class T> std::atomic<T*> Singleton<T>::instance_(NULL);
 template <class T> pthread_once_t Singleton<T>::once_control_ =
     PTHREAD_ONCE_INIT;
 
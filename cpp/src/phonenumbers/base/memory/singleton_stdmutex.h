@@ -15,6 +15,7 @@
 #ifndef I18N_PHONENUMBERS_BASE_MEMORY_SINGLETON_STDMUTEX_H_
 #define I18N_PHONENUMBERS_BASE_MEMORY_SINGLETON_STDMUTEX_H_
 
+#include <atomic>
 #include <mutex>
 
 #include "phonenumbers/base/basictypes.h"
@@ -28,33 +29,29 @@ class Singleton {
   Singleton() {}
   virtual ~Singleton() {}
 
+  // Once the instance has been published, this is a single acquire load.
   static T* GetInstance() {
-    if (once_init_) {
-      singleton_mutex_.lock();
-      if (once_init_) {
-        Init();
-        once_init_ = false;
-      }
-      singleton_mutex_.unlock();
+    T* instance = instance_.load(std::memory_order_acquire);
+    if (!instance) {
+      std::call_once(once_flag_, &Init);
+      instance = instance_.load(std::memory_order_acquire);
     }
-    return instance_;
+    return instance;
   }
 
  private:
   DISALLOW_COPY_AND_ASSIGN(Singleton);
 
   static void Init() {
-    instance_ = new T();
+    instance_.store(new T(), std::memory_order_release);
   }
 
-  static T* instance_;  // Leaky singleton.
-  static std::mutex singleton_mutex_;
-  static bool once_init_;
+  static std::atomic<T*> instance_;  // Leaky singleton.
+  static std::once_flag once_flag_;
 };
 
-template <class T> T* Singleton<T>::instance_;
-template <class T> std::mutex Singleton<T>::singleton_mutex_;
-template <class T> bool Singleton<T>::once_init_ = true;
+template <class T> std::atomic<T*> Singleton<T>::instance_(NULL);
+template <class T> std::once_flag Singleton<T>::once_flag_;
 
 }  // namespace phonenumbers
 }  // namespace i18n
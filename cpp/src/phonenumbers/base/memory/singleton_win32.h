@@ -18,6 +18,8 @@
 #include <windows.h>
 #include <synchapi.h>
 
+#include <atomic>
+
 #include "phonenumbers/base/basictypes.h"
 
 namespace i18n {
@@ -29,39 +31,30 @@ class Singleton {
   Singleton() {}
   virtual ~Singleton() {}
 
+  // Once the instance has been published, this is a single acquire load.
   static T* GetInstance() {
-    if (once_init_) {
-      EnterCriticalSection(&critical_section_);
-      if (once_init_) {
-        Init();
-        once_init_ = false;
-      }
-      LeaveCriticalSection(&critical_section_);
+    T* instance = instance_.load(std::memory_order_acquire);
+    if (!instance) {
+      InitOnceExecuteOnce(&init_once_, &Init, NULL, NULL);
+      instance = instance_.load(std::memory_order_acquire);
     }
-    return instance_;
+    return instance;
   }
 
  private:
   DISALLOW_COPY_AND_ASSIGN(Singleton);
 
-  static void Init() {
-    instance_ = new T();
+  static BOOL CALLBACK Init(PINIT_ONCE, PVOID, PVOID*) {
+    instance_.store(new T(), std::memory_order_release);
+    return TRUE;
   }
 
-  static T* instance_;  // Leaky singleton.
-  static CRITICAL_SECTION critical_section_;
-  static bool once_init_;
+  static std::atomic<T*> instance_;  // Leaky singleton.
+  static INIT_ONCE init_once_;
 };
 
-static bool perform_init_crit(CRITICAL_SECTION& cs)
-{
-  InitializeCriticalSection(&cs);
-  return true;
-}
-
-template <class T> T* Singleton<T>::instance_;
-template <class T> CRITICAL_SECTION Singleton<T>::critical_section_;
-template <class T> bool Singleton<T>::once_init_=perform_init_crit(Singleton<T>::critical_section_);
+template <class T> std::atomic<T*> Singleton<T>::instance_(NULL);
+template <class T> INIT_ONCE Singleton<T>::init_once_ = INIT_ONCE_STATIC_INIT;
 
 }  // namespace phonenumbers
 }  // namespace i18n
@@ -0,0 +1,247 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/columnar_batch.h"
+
+#include <algorithm>
+#include <set>
+
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/default_logger.h"
+#include "phonenumbers/executor.h"
+#include "phonenumbers/phonenumber.pb.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::set;
+
+namespace {
+
+const char kUnknownRegion[] = "ZZ";
+const char kNonGeoEntityRegion[] = "001";
+
+// The rows are parsed in blocks of this size when an executor is used, each
+// block formatting its numbers into its own builder.
+const int64 kRowsPerBlock = 256;
+
+// About the cost of parsing a row, in nanoseconds.
+const int64 kRowCostNs = 2000;
+
+}  // namespace
+
+StringArrayBuilder::StringArrayBuilder() : null_count_(0) {
+  offsets_.push_back(0);
+}
+
+void StringArrayBuilder::Clear() {
+  data_.clear();
+  offsets_.resize(1);
+  validity_.clear();
+  null_count_ = 0;
+}
+
+void StringArrayBuilder::Reserve(int64 values, int64 data_size) {
+  offsets_.reserve(offsets_.size() + values);
+  data_.reserve(data_.size() + data_size);
+}
+
+void StringArrayBuilder::Append(absl::string_view value) {
+  data_.insert(data_.end(), value.begin(), value.end());
+  DCHECK(data_.size() <= static_cast<size_t>(kint32max));
+  offsets_.push_back(static_cast<int32>(data_.size()));
+  AppendValidity(true);
+}
+
+void StringArrayBuilder::AppendNull() {
+  offsets_.push_back(offsets_.back());
+  AppendValidity(false);
+}
+
+void StringArrayBuilder::AppendValidity(bool is_valid) {
+  const int64 i = length() - 1;
+  if (is_valid && null_count_ == 0) {
+    return;
+  }
+  if (!is_valid && null_count_ == 0) {
+    // The values appended so far were all valid.
+    validity_.assign((i >> 3) + 1, 0);
+    for (int64 j = 0; j < i; ++j) {
+      validity_[j >> 3] |= 1 << (j & 7);
+    }
+  }
+  if (static_cast<size_t>(i >> 3) == validity_.size()) {
+    validity_.push_back(0);
+  }
+  if (is_valid) {
+    validity_[i >> 3] |= 1 << (i & 7);
+  } else {
+    ++null_count_;
+  }
+}
+
+StringArray StringArrayBuilder::View() const {
+  return StringArray(data_.empty() ? NULL : &data_[0], &offsets_[0],
+                     validity_.empty() ? NULL : &validity_[0], length());
+}
+
+ColumnarPhoneNumberUtil::ColumnarPhoneNumberUtil(const PhoneNumberUtil& util)
+    : phone_util_(util) {
+  set<string> regions;
+  phone_util_.GetSupportedRegions(&regions);
+  regions.insert(kNonGeoEntityRegion);
+  region_codes_.reserve(regions.size() + 1);
+  region_codes_.push_back(kUnknownRegion);
+  region_codes_.insert(region_codes_.end(), regions.begin(), regions.end());
+}
+
+const string& ColumnarPhoneNumberUtil::GetRegionCodeForId(int id) const {
+  DCHECK_GE(id, 0);
+  DCHECK_LT(id, num_region_ids());
+  return region_codes_[id];
+}
+
+int ColumnarPhoneNumberUtil::GetIdForRegionCode(
+    absl::string_view region_code) const {
+  // The region codes after "ZZ" are sorted.
+  const vector<string>::const_iterator begin = region_codes_.begin() + 1;
+  const vector<string>::const_iterator it = std::lower_bound(
+      begin, region_codes_.end(), region_code,
+      [](const string& a, absl::string_view b) { return a < b; });
+  if (it == region_codes_.end() || *it != region_code) {
+    return 0;
+  }
+  return static_cast<int>(it - region_codes_.begin());
+}
+
+void ColumnarPhoneNumberUtil::ParseColumn(
+    const StringArray& numbers,
+    const StringArray* regions,
+    const string& default_region,
+    const ColumnarParseOptions& options,
+    ParsedNumberColumns* columns) const {
+  DCHECK(columns);
+  DCHECK(!regions || regions->length == numbers.length);
+  const size_t length = static_cast<size_t>(numbers.length);
+  // assign() keeps the capacity of the columns, so that they are only
+  // allocated for batches larger than the previous ones.
+  columns->errors.assign(length, PhoneNumberUtil::NOT_A_NUMBER);
+  columns->country_codes.assign(length, 0);
+  columns->national_numbers.assign(length, 0);
+  columns->leading_zeros.assign(length, 0);
+  columns->has_extensions.assign(length, 0);
+  columns->number_types.assign(options.number_types ? length : 0,
+                               PhoneNumberUtil::UNKNOWN);
+  columns->region_ids.assign(options.region_ids ? length : 0, 0);
+  columns->formatted.Clear();
+  if (options.formatted) {
+    // The formatted numbers are about as long as the input ones.
+    columns->formatted.Reserve(
+        numbers.length,
+        length > 0 ? numbers.offsets[length] - numbers.offsets[0] : 0);
+  }
+
+  if (!options.executor) {
+    ParseRows(numbers, regions, default_region, options, 0, numbers.length,
+              columns, &columns->formatted);
+    return;
+  }
+  const int64 num_blocks = (numbers.length + kRowsPerBlock - 1) / kRowsPerBlock;
+  vector<StringArrayBuilder> formatted_blocks(
+      options.formatted ? num_blocks : 0);
+  ParallelFor(options.executor, num_blocks, kRowsPerBlock * kRowCostNs,
+              [&](int64 begin, int64 end) {
+    for (int64 block = begin; block < end; ++block) {
+      ParseRows(numbers, regions, default_region, options,
+                block * kRowsPerBlock,
+                std::min((block + 1) * kRowsPerBlock, numbers.length), columns,
+                options.formatted ? &formatted_blocks[block] : NULL);
+    }
+  });
+  // The formatted numbers of the blocks are concatenated in order.
+  for (vector<StringArrayBuilder>::const_iterator it =
+           formatted_blocks.begin(); it != formatted_blocks.end(); ++it) {
+    const StringArray block = it->View();
+    for (int64 i = 0; i < block.length; ++i) {
+      if (block.IsNull(i)) {
+        columns->formatted.AppendNull();
+      } else {
+        columns->formatted.Append(block.Value(i));
+      }
+    }
+  }
+}
+
+void ColumnarPhoneNumberUtil::ParseRows(
+    const StringArray& numbers,
+    const StringArray* regions,
+    const string& default_region,
+    const ColumnarParseOptions& options,
+    int64 begin,
+    int64 end,
+    ParsedNumberColumns* columns,
+    StringArrayBuilder* formatted) const {
+  // Scratch space reused across rows, since Parse() takes strings.
+  string number_text;
+  string region;
+  string result;
+  PhoneNumber number;
+  for (int64 i = begin; i < end; ++i) {
+    if (numbers.IsNull(i)) {
+      if (options.formatted) {
+        formatted->AppendNull();
+      }
+      continue;
+    }
+    const absl::string_view value = numbers.Value(i);
+    number_text.assign(value.data(), value.size());
+    if (regions && !regions->IsNull(i)) {
+      const absl::string_view region_value = regions->Value(i);
+      region.assign(region_value.data(), region_value.size());
+    } else {
+      region.assign(default_region);
+    }
+    const PhoneNumberUtil::ErrorType error =
+        phone_util_.Parse(number_text, region, &number);
+    columns->errors[i] = static_cast<int8>(error);
+    if (error != PhoneNumberUtil::NO_PARSING_ERROR) {
+      if (options.formatted) {
+        formatted->AppendNull();
+      }
+      continue;
+    }
+    columns->country_codes[i] = number.country_code();
+    columns->national_numbers[i] = number.national_number();
+    if (number.italian_leading_zero()) {
+      columns->leading_zeros[i] =
+          static_cast<int8>(number.number_of_leading_zeros());
+    }
+    columns->has_extensions[i] = !number.extension().empty();
+    if (options.number_types) {
+      columns->number_types[i] =
+          static_cast<int8>(phone_util_.GetNumberType(number));
+    }
+    if (options.region_ids) {
+      phone_util_.GetRegionCodeForNumber(number, &result);
+      columns->region_ids[i] = static_cast<int16>(GetIdForRegionCode(result));
+    }
+    if (options.formatted) {
+      phone_util_.Format(number, options.format, &result);
+      formatted->Append(result);
+    }
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,256 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parses columns of phone numbers laid out like the string arrays of Apache
+// Arrow and similar columnar formats: the values are concatenated in a data
+// buffer, value i spanning [offsets[i], offsets[i + 1]), and an optional
+// validity bitmap tells which values are null. The results are columns as
+// well, so that analytics engines can hand their buffers over without
+// building a string per value, and without depending on Arrow.
+//
+// ColumnarPhoneNumberUtil columnar(*PhoneNumberUtil::GetInstance());
+// ParsedNumberColumns columns;
+// columnar.ParseColumn(StringArray(data, offsets, validity, length), NULL,
+//                      "CH", ColumnarParseOptions(), &columns);
+// // columns.country_codes[i] and columns.national_numbers[i] hold the number
+// // of row i if columns.errors[i] is NO_PARSING_ERROR.
+
+#ifndef I18N_PHONENUMBERS_COLUMNAR_BATCH_H_
+#define I18N_PHONENUMBERS_COLUMNAR_BATCH_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/phonenumberutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+class Executor;
+
+// Returns whether bit i of an Arrow validity bitmap is set, the bits of each
+// byte being numbered from the least significant one. A NULL bitmap means that
+// every value is valid.
+inline bool IsBitSet(const uint8* bitmap, int64 i) {
+  return !bitmap || (bitmap[i >> 3] >> (i & 7)) & 1;
+}
+
+// A read-only view of a column of strings owned by the caller. Sliced columns
+// are supported: the offsets of a slice point to the offset of its first value,
+// which doesn't need to be 0, and the bits of its values in the validity bitmap
+// start at validity_offset, the offset of the slice in an Arrow array.
+struct StringArray {
+  StringArray()
+      : data(NULL),
+        offsets(NULL),
+        validity(NULL),
+        validity_offset(0),
+        length(0) {}
+
+  StringArray(const char* data, const int32* offsets, const uint8* validity,
+              int64 length)
+      : data(data),
+        offsets(offsets),
+        validity(validity),
+        validity_offset(0),
+        length(length) {}
+
+  StringArray(const char* data, const int32* offsets, const uint8* validity,
+              int64 validity_offset, int64 length)
+      : data(data),
+        offsets(offsets),
+        validity(validity),
+        validity_offset(validity_offset),
+        length(length) {}
+
+  bool IsNull(int64 i) const {
+    return !IsBitSet(validity, validity_offset + i);
+  }
+
+  // Returns value i, which is empty if it is null.
+  absl::string_view Value(int64 i) const {
+    return absl::string_view(data + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+
+  const char* data;
+  // length + 1 offsets into data.
+  const int32* offsets;
+  // NULL if no value is null. Otherwise, bit validity_offset + i is set if
+  // value i isn't null.
+  const uint8* validity;
+  int64 validity_offset;
+  int64 length;
+};
+
+// Builds a column of strings. Clearing a builder keeps its buffers, so that a
+// builder reused for several batches stops allocating once its buffers fit the
+// largest batch.
+class StringArrayBuilder {
+ public:
+  StringArrayBuilder();
+
+  // Removes all the values, keeping the capacity of the buffers.
+  void Clear();
+
+  // Reserves space for values with data_size bytes in total.
+  void Reserve(int64 values, int64 data_size);
+
+  void Append(absl::string_view value);
+  void AppendNull();
+
+  int64 length() const {
+    return static_cast<int64>(offsets_.size()) - 1;
+  }
+
+  int64 null_count() const {
+    return null_count_;
+  }
+
+  const vector<char>& data() const {
+    return data_;
+  }
+
+  const vector<int32>& offsets() const {
+    return offsets_;
+  }
+
+  // Empty if no value is null.
+  const vector<uint8>& validity() const {
+    return validity_;
+  }
+
+  // Returns a view of the values, valid until the builder is next modified.
+  StringArray View() const;
+
+ private:
+  // Appends the validity bit of a new value.
+  void AppendValidity(bool is_valid);
+
+  vector<char> data_;
+  vector<int32> offsets_;
+  // Only filled in once the first null value is appended.
+  vector<uint8> validity_;
+  int64 null_count_;
+};
+
+// What ParseColumn() computes besides the parsing results.
+struct ColumnarParseOptions {
+  ColumnarParseOptions()
+      : number_types(false),
+        region_ids(false),
+        formatted(false),
+        format(PhoneNumberUtil::E164),
+        executor(NULL) {}
+
+  // Whether to fill in ParsedNumberColumns::number_types.
+  bool number_types;
+  // Whether to fill in ParsedNumberColumns::region_ids.
+  bool region_ids;
+  // Whether to fill in ParsedNumberColumns::formatted, in the given format.
+  bool formatted;
+  PhoneNumberUtil::PhoneNumberFormat format;
+  // If not NULL, the rows are parsed on the threads of executor as well as the
+  // calling one. The results are the same.
+  Executor* executor;
+};
+
+// The columns computed by ParseColumn(), one element per row. The values of the
+// rows which failed to parse are 0, and their formatted values are null.
+// Reusing the same instance for several batches avoids allocating its columns
+// for each of them.
+struct ParsedNumberColumns {
+  // PhoneNumberUtil::ErrorType values. Null rows get NOT_A_NUMBER.
+  vector<int8> errors;
+  vector<int32> country_codes;
+  vector<uint64> national_numbers;
+  // The number of leading zeros of the national significant number, which
+  // isn't part of national_numbers, e.g. 1 for the Italian fixed-line numbers.
+  vector<int8> leading_zeros;
+  // Whether the number has an extension. The extensions themselves are only
+  // kept in the formatted numbers.
+  vector<uint8> has_extensions;
+  // PhoneNumberUtil::PhoneNumberType values, if requested.
+  vector<int8> number_types;
+  // Identifiers of the regions of the numbers, see
+  // ColumnarPhoneNumberUtil::GetRegionCodeForId(), if requested.
+  vector<int16> region_ids;
+  // The numbers in the requested format, if requested.
+  StringArrayBuilder formatted;
+};
+
+// Parses columns of numbers with a PhoneNumberUtil. The columnar layer doesn't
+// allocate memory per row once its output columns have grown to the size of
+// the batches; each number is still parsed by PhoneNumberUtil::Parse().
+//
+// This class is immutable and thread-safe, but ParsedNumberColumns instances
+// may not be shared by concurrent calls.
+class ColumnarPhoneNumberUtil {
+ public:
+  explicit ColumnarPhoneNumberUtil(const PhoneNumberUtil& util);
+
+  // This type is neither copyable nor movable.
+  ColumnarPhoneNumberUtil(const ColumnarPhoneNumberUtil&) = delete;
+  ColumnarPhoneNumberUtil& operator=(const ColumnarPhoneNumberUtil&) = delete;
+
+  // Parses every value of numbers as PhoneNumberUtil::Parse() does. The region
+  // of row i is regions->Value(i) if regions isn't NULL and that value isn't
+  // null, and default_region otherwise. regions must have as many rows as
+  // numbers.
+  void ParseColumn(const StringArray& numbers,
+                   const StringArray* regions,
+                   const string& default_region,
+                   const ColumnarParseOptions& options,
+                   ParsedNumberColumns* columns) const;
+
+  // The identifiers of ParsedNumberColumns::region_ids are the indices of the
+  // region codes in a table of the supported regions sorted in alphabetical
+  // order. Identifier 0 stands for the unknown region "ZZ", and the
+  // non-geographical entity "001" comes before the region codes.
+  int num_region_ids() const {
+    return static_cast<int>(region_codes_.size());
+  }
+
+  // Returns the region code of id, which must be in [0, num_region_ids()).
+  const string& GetRegionCodeForId(int id) const;
+
+  // Returns the identifier of region_code, or 0 if it isn't supported.
+  int GetIdForRegionCode(absl::string_view region_code) const;
+
+ private:
+  // Parses the rows in [begin, end) into columns, whose columns other than
+  // the formatted numbers have been resized already, and appends their
+  // formatted numbers to formatted.
+  void ParseRows(const StringArray& numbers,
+                 const StringArray* regions,
+                 const string& default_region,
+                 const ColumnarParseOptions& options,
+                 int64 begin,
+                 int64 end,
+                 ParsedNumberColumns* columns,
+                 StringArrayBuilder* formatted) const;
+
+  const PhoneNumberUtil& phone_util_;
+  // "ZZ" followed by the sorted region codes, "001" first among them.
+  vector<string> region_codes_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_COLUMNAR_BATCH_H_
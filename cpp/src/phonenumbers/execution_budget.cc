@@ -0,0 +1,98 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/execution_budget.h"
+
+#include <limits>
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+thread_local ExecutionBudget* current_budget = NULL;
+
+}  // namespace
+
+ExecutionBudget::ExecutionBudget()
+    : has_deadline_(false),
+      max_steps_(-1),
+      steps_(0),
+      exhausted_(false) {}
+
+void ExecutionBudget::set_deadline(Clock::time_point deadline) {
+  deadline_ = deadline;
+  has_deadline_ = true;
+}
+
+void ExecutionBudget::set_timeout(Clock::duration timeout) {
+  set_deadline(Clock::now() + timeout);
+}
+
+void ExecutionBudget::set_max_steps(int64 max_steps) {
+  max_steps_ = max_steps;
+}
+
+bool ExecutionBudget::Consume() {
+  if (exhausted_) {
+    return false;
+  }
+  ++steps_;
+  if ((max_steps_ >= 0 && steps_ > max_steps_) ||
+      (has_deadline_ && Clock::now() >= deadline_)) {
+    exhausted_ = true;
+  }
+  return !exhausted_;
+}
+
+void ExecutionBudget::MarkExhausted() {
+  exhausted_ = true;
+}
+
+int32 ExecutionBudget::RemainingMilliseconds() const {
+  if (!has_deadline_) {
+    return 0;
+  }
+  const std::chrono::milliseconds::rep remaining =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          deadline_ - Clock::now()).count();
+  if (remaining < 1) {
+    return 1;
+  }
+  return remaining > std::numeric_limits<int32>::max()
+      ? std::numeric_limits<int32>::max()
+      : static_cast<int32>(remaining);
+}
+
+// static
+ExecutionBudget* ExecutionBudget::Current() {
+  return current_budget;
+}
+
+ScopedExecutionBudget::ScopedExecutionBudget(ExecutionBudget* budget)
+    : budget_(budget),
+      previous_budget_(current_budget) {
+  if (budget_) {
+    current_budget = budget_;
+  }
+}
+
+ScopedExecutionBudget::~ScopedExecutionBudget() {
+  if (budget_) {
+    current_budget = previous_budget_;
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
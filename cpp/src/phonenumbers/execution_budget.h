@@ -0,0 +1,114 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Bounds the work done on adversarial input, such as very long runs of digits
+// and punctuation, by a deadline and a maximum number of steps.
+//
+// ExecutionBudget budget;
+// budget.set_timeout(std::chrono::milliseconds(2));
+// budget.set_max_steps(1000);
+// if (phone_util.ParseWithBudget(text, "CH", &budget, &number) ==
+//     PhoneNumberUtil::DEADLINE_EXCEEDED) {
+//   // Gave up on text.
+// }
+//
+// A step is an evaluation of a regular expression or a candidate considered by
+// the PhoneNumberMatcher. While a ScopedExecutionBudget is alive, the regular
+// expressions evaluated on its thread consume steps of its budget, and fail
+// without being evaluated once it is exhausted. The ICU adapter additionally
+// bounds every single evaluation by the time remaining before the deadline.
+//
+// An ExecutionBudget isn't thread-safe and must only be used by one operation
+// at a time.
+
+#ifndef I18N_PHONENUMBERS_EXECUTION_BUDGET_H_
+#define I18N_PHONENUMBERS_EXECUTION_BUDGET_H_
+
+#include <chrono>
+
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+class ExecutionBudget {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  // Constructs an unlimited budget.
+  ExecutionBudget();
+
+  // This type is neither copyable nor movable.
+  ExecutionBudget(const ExecutionBudget&) = delete;
+  ExecutionBudget& operator=(const ExecutionBudget&) = delete;
+
+  void set_deadline(Clock::time_point deadline);
+  // Sets the deadline to timeout from now.
+  void set_timeout(Clock::duration timeout);
+  // A negative value means no limit, which is the default.
+  void set_max_steps(int64 max_steps);
+
+  // Accounts for one step. Returns false if the budget is exhausted, either
+  // because of this step or beforehand.
+  bool Consume();
+
+  // Marks the budget as exhausted, for instance because a regular expression
+  // engine gave up on its own limits.
+  void MarkExhausted();
+
+  bool IsExhausted() const {
+    return exhausted_;
+  }
+
+  int64 steps() const {
+    return steps_;
+  }
+
+  // Returns the number of whole milliseconds left before the deadline, at least
+  // one, or 0 if there is no deadline.
+  int32 RemainingMilliseconds() const;
+
+  // Returns the budget of the innermost ScopedExecutionBudget alive on the
+  // current thread, or NULL if there is none.
+  static ExecutionBudget* Current();
+
+ private:
+  Clock::time_point deadline_;
+  bool has_deadline_;
+  int64 max_steps_;
+  int64 steps_;
+  bool exhausted_;
+};
+
+// Makes budget the current budget of the thread for the lifetime of this
+// object, and restores the previous one afterwards. Does nothing if budget is
+// NULL.
+class ScopedExecutionBudget {
+ public:
+  explicit ScopedExecutionBudget(ExecutionBudget* budget);
+  ~ScopedExecutionBudget();
+
+  // This type is neither copyable nor movable.
+  ScopedExecutionBudget(const ScopedExecutionBudget&) = delete;
+  ScopedExecutionBudget& operator=(const ScopedExecutionBudget&) = delete;
+
+ private:
+  ExecutionBudget* const budget_;
+  ExecutionBudget* const previous_budget_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_EXECUTION_BUDGET_H_
@@ -0,0 +1,228 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "phonenumbers/stl_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+// The minimum cost of the chunks of ParallelFor(), in nanoseconds.
+const int64 kMinChunkCostNs = 50000;
+
+// ParallelFor() cuts batches into up to this many chunks per task which may
+// run concurrently, so that threads finishing early have chunks left to take.
+const int64 kChunksPerTask = 4;
+
+// The executor whose thread this is, and the index of the queue of the
+// thread, or NULL on threads not belonging to a WorkStealingExecutor.
+thread_local const WorkStealingExecutor* current_executor = NULL;
+thread_local int current_queue = 0;
+
+// The state of a ParallelFor() call, shared with the tasks it scheduled, which
+// may run after it returned.
+struct ParallelForState {
+  ParallelForState(const std::function<void(int64, int64)>* body, int64 size,
+                   int64 chunk_size, int64 num_chunks)
+      : body(body),
+        size(size),
+        chunk_size(chunk_size),
+        num_chunks(num_chunks),
+        next_chunk(0),
+        chunks_done(0) {}
+
+  // Only used while chunks are left, which is before ParallelFor() returns.
+  const std::function<void(int64, int64)>* const body;
+  const int64 size;
+  const int64 chunk_size;
+  const int64 num_chunks;
+  std::atomic<int64> next_chunk;
+
+  std::mutex mutex;
+  std::condition_variable all_done;
+  int64 chunks_done;
+};
+
+// Processes chunks until none is left.
+void RunChunks(ParallelForState* state) {
+  int64 chunks_done = 0;
+  for (;;) {
+    const int64 chunk = state->next_chunk.fetch_add(1);
+    if (chunk >= state->num_chunks) {
+      break;
+    }
+    const int64 begin = chunk * state->chunk_size;
+    (*state->body)(begin, std::min(begin + state->chunk_size, state->size));
+    ++chunks_done;
+  }
+  if (chunks_done > 0) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->chunks_done += chunks_done;
+    if (state->chunks_done == state->num_chunks) {
+      state->all_done.notify_all();
+    }
+  }
+}
+
+}  // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(int num_threads)
+    : pending_tasks_(0),
+      next_queue_(0),
+      stopping_(false) {
+  if (num_threads <= 0) {
+    num_threads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    queues_.push_back(new Queue());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(std::thread(&WorkStealingExecutor::RunWorker, this, i));
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  work_available_.notify_all();
+  for (vector<std::thread>::iterator it = threads_.begin();
+       it != threads_.end(); ++it) {
+    it->join();
+  }
+  gtl::STLDeleteElements(&queues_);
+}
+
+int WorkStealingExecutor::Concurrency() const {
+  return static_cast<int>(threads_.size());
+}
+
+void WorkStealingExecutor::Schedule(std::function<void()> task) {
+  int index;
+  if (current_executor == this) {
+    index = current_queue;
+  } else {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index = next_queue_;
+    next_queue_ = (next_queue_ + 1) % static_cast<int>(queues_.size());
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    // The task is counted once queued, so that a thread which reserved it
+    // finds it.
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_tasks_;
+  }
+  work_available_.notify_one();
+}
+
+void WorkStealingExecutor::RunWorker(int index) {
+  current_executor = this;
+  current_queue = index;
+  std::function<void()> task;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [this] {
+        return pending_tasks_ > 0 || stopping_;
+      });
+      if (pending_tasks_ == 0) {
+        return;
+      }
+      // Reserves one of the queued tasks.
+      --pending_tasks_;
+    }
+    while (!TakeTask(index, &task)) {
+      // The queues are scanned in a different order by each thread, so that
+      // the tasks left may be in queues this one already scanned.
+      std::this_thread::yield();
+    }
+    task();
+    task = nullptr;
+  }
+}
+
+bool WorkStealingExecutor::TakeTask(int index, std::function<void()>* task) {
+  // The thread's own queue is used as a stack, so that it runs the tasks it
+  // scheduled while their data is still in its caches...
+  {
+    Queue* const queue = queues_[index];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->tasks.empty()) {
+      *task = std::move(queue->tasks.back());
+      queue->tasks.pop_back();
+      return true;
+    }
+  }
+  // ...while the oldest tasks of the other queues are stolen.
+  const int num_queues = static_cast<int>(queues_.size());
+  for (int i = 1; i < num_queues; ++i) {
+    Queue* const queue = queues_[(index + i) % num_queues];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->tasks.empty()) {
+      *task = std::move(queue->tasks.front());
+      queue->tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParallelFor(Executor* executor,
+                 int64 size,
+                 int64 cost_per_item_ns,
+                 const std::function<void(int64 begin, int64 end)>& body) {
+  if (size <= 0) {
+    return;
+  }
+  const int64 concurrency = executor ? executor->Concurrency() : 1;
+  const int64 min_chunk_size =
+      std::max<int64>(1, kMinChunkCostNs / std::max<int64>(1, cost_per_item_ns));
+  const int64 chunk_size = std::max(
+      min_chunk_size,
+      (size + concurrency * kChunksPerTask - 1) /
+          (concurrency * kChunksPerTask));
+  const int64 num_chunks = (size + chunk_size - 1) / chunk_size;
+  if (num_chunks <= 1 || concurrency <= 1) {
+    body(0, size);
+    return;
+  }
+  std::shared_ptr<ParallelForState> state(
+      new ParallelForState(&body, size, chunk_size, num_chunks));
+  // The calling thread processes chunks too, so it needs one helper less.
+  const int64 num_helpers = std::min(concurrency, num_chunks - 1);
+  for (int64 i = 0; i < num_helpers; ++i) {
+    executor->Schedule([state] { RunChunks(state.get()); });
+  }
+  RunChunks(state.get());
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->all_done.wait(lock, [&state] {
+    return state->chunks_done == state->num_chunks;
+  });
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
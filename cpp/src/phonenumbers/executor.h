@@ -0,0 +1,125 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the batch operations of the library on several threads. The batch
+// entry points take an optional Executor, which is either the built-in
+// WorkStealingExecutor or an adapter to a thread pool of the host:
+//
+// WorkStealingExecutor executor(8);
+// phone_util.ParseBatch(numbers_to_parse, "CH", false, &arena, &executor,
+//                       &numbers, &errors);
+//
+// The results don't depend on the executor: each item is written to its own
+// position of the output, so they are in the same order as without one.
+
+#ifndef I18N_PHONENUMBERS_EXECUTOR_H_
+#define I18N_PHONENUMBERS_EXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::vector;
+
+// Runs tasks asynchronously. Implementations must be thread-safe.
+class Executor {
+ public:
+  virtual ~Executor() {}
+
+  // Returns the number of tasks which may run at the same time, which bounds
+  // the number of tasks ParallelFor() schedules.
+  virtual int Concurrency() const = 0;
+
+  // Runs task once, on any thread and at any time, possibly after the call
+  // which scheduled it returned.
+  virtual void Schedule(std::function<void()> task) = 0;
+};
+
+// A pool of threads each having a queue of tasks. The tasks scheduled from a
+// thread of the pool go to its own queue, and the other ones are spread over
+// the queues; idle threads take tasks from the other queues, so that a thread
+// running long tasks doesn't hold up the tasks queued behind them.
+class WorkStealingExecutor : public Executor {
+ public:
+  // Starts num_threads threads, or one per hardware thread if it is 0.
+  explicit WorkStealingExecutor(int num_threads);
+
+  // This type is neither copyable nor movable.
+  WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+  WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+  // Runs the tasks still queued, then stops the threads.
+  ~WorkStealingExecutor();
+
+  int Concurrency() const;
+  void Schedule(std::function<void()> task);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()> > tasks;
+  };
+
+  void RunWorker(int index);
+
+  // Takes a task from the back of queue index, or from the front of another
+  // queue. Returns false if every queue is empty.
+  bool TakeTask(int index, std::function<void()>* task);
+
+  vector<Queue*> queues_;
+  vector<std::thread> threads_;
+
+  // Protects the fields below, and wakes up the idle threads.
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  // The number of tasks queued and not taken yet.
+  int64 pending_tasks_;
+  // The queue of the next task scheduled from outside the pool.
+  int next_queue_;
+  bool stopping_;
+};
+
+// Calls body(begin, end) on consecutive chunks of [0, size) which together
+// cover it, on the threads of executor as well as the calling thread, and
+// returns once every chunk has been processed. The chunks are sized so that
+// each one costs at least about 50 microseconds given cost_per_item_ns, the
+// estimated cost of an item in nanoseconds, since smaller ones cost more to
+// schedule than they save; small batches are thus processed by the calling
+// thread alone. body is called by the calling thread alone if executor is
+// NULL.
+//
+// Calls of ParallelFor() may be nested, e.g. from within body: the calling
+// thread processes the chunks no other thread has started.
+//
+// The ScopedExecutionBudget of the calling thread, if any, only applies to the
+// chunks processed by the calling thread: an ExecutionBudget isn't thread-safe,
+// so it isn't shared with the threads of executor, whose chunks run without a
+// budget. Callers needing one on every chunk install their own in body.
+void ParallelFor(Executor* executor,
+                 int64 size,
+                 int64 cost_per_item_ns,
+                 const std::function<void(int64 begin, int64 end)>& body);
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_EXECUTOR_H_
@@ -0,0 +1,164 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/hot_metadata.h"
+
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/pattern_pool.h"
+#include "phonenumbers/phonemetadata.pb.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using google::protobuf::RepeatedField;
+
+namespace {
+
+// The number description of metadata used for type, as in phonenumberutil.cc.
+const PhoneNumberDesc& GetNumberDescByType(
+    const PhoneMetadata& metadata, PhoneNumberUtil::PhoneNumberType type) {
+  switch (type) {
+    case PhoneNumberUtil::PREMIUM_RATE:
+      return metadata.premium_rate();
+    case PhoneNumberUtil::TOLL_FREE:
+      return metadata.toll_free();
+    case PhoneNumberUtil::MOBILE:
+      return metadata.mobile();
+    case PhoneNumberUtil::FIXED_LINE:
+    case PhoneNumberUtil::FIXED_LINE_OR_MOBILE:
+      return metadata.fixed_line();
+    case PhoneNumberUtil::SHARED_COST:
+      return metadata.shared_cost();
+    case PhoneNumberUtil::VOIP:
+      return metadata.voip();
+    case PhoneNumberUtil::PERSONAL_NUMBER:
+      return metadata.personal_number();
+    case PhoneNumberUtil::PAGER:
+      return metadata.pager();
+    case PhoneNumberUtil::UAN:
+      return metadata.uan();
+    case PhoneNumberUtil::VOICEMAIL:
+      return metadata.voicemail();
+    default:
+      return metadata.general_desc();
+  }
+}
+
+// Returns the bit mask of lengths. The lengths of phone numbers are well below
+// 32 digits.
+uint32 ToLengthMask(const RepeatedField<int>& lengths) {
+  uint32 mask = 0;
+  for (RepeatedField<int>::const_iterator it = lengths.begin();
+       it != lengths.end(); ++it) {
+    if (*it >= 0) {
+      DCHECK(*it < 32);
+      mask |= uint32{1} << *it;
+    }
+  }
+  return mask;
+}
+
+bool HasLength(uint32 lengths, int length) {
+  return length >= 0 && length < 32 && (lengths >> length) & 1;
+}
+
+}  // namespace
+
+HotMetadata::HotMetadata(const PhoneMetadata& metadata,
+                         const RegExp* leading_digits,
+                         PatternPool* pattern_pool)
+    : metadata_(&metadata),
+      leading_digits_(leading_digits),
+      country_code_(metadata.country_code()),
+      types_without_numbers_(0),
+      same_mobile_and_fixed_line_pattern_(
+          metadata.same_mobile_and_fixed_line_pattern()) {
+  for (int i = 0; i < kNumTypes; ++i) {
+    const PhoneNumberUtil::PhoneNumberType type =
+        static_cast<PhoneNumberUtil::PhoneNumberType>(i);
+    const PhoneNumberDesc& desc = GetNumberDescByType(metadata, type);
+    possible_lengths_[type] = ToLengthMask(desc.possible_length());
+    const uint32 local_only_lengths =
+        ToLengthMask(desc.possible_length_local_only());
+    DCHECK(local_only_lengths <= kuint16max);
+    local_only_lengths_[type] = static_cast<uint16>(local_only_lengths);
+    const int pattern_id =
+        pattern_pool->Intern(desc.national_number_pattern());
+    DCHECK(pattern_id <= kint16max);
+    pattern_ids_[type] = static_cast<int16>(pattern_id);
+    // A single possible length of -1 means that no number of the type exists.
+    if (desc.possible_length_size() == 1 && desc.possible_length(0) == -1) {
+      types_without_numbers_ |= 1 << type;
+    }
+  }
+}
+
+bool HotMetadata::IsPossibleLengthForDesc(
+    int length, PhoneNumberUtil::PhoneNumberType type) const {
+  if (possible_lengths_[type] == 0 && HasPossibleNumberData(type)) {
+    // The description has no possible lengths of its own.
+    return true;
+  }
+  return HasLength(possible_lengths_[type], length);
+}
+
+uint32 HotMetadata::PossibleLengths(
+    PhoneNumberUtil::PhoneNumberType type) const {
+  if (!HasPossibleNumberData(type)) {
+    return 0;
+  }
+  return possible_lengths_[type] != 0
+      ? possible_lengths_[type]
+      : possible_lengths_[PhoneNumberUtil::UNKNOWN];
+}
+
+PhoneNumberUtil::ValidationResult HotMetadata::TestNumberLength(
+    int length, PhoneNumberUtil::PhoneNumberType type) const {
+  uint32 possible_lengths = PossibleLengths(type);
+  uint32 local_lengths = local_only_lengths_[type];
+  if (type == PhoneNumberUtil::FIXED_LINE_OR_MOBILE) {
+    if (!HasPossibleNumberData(PhoneNumberUtil::FIXED_LINE)) {
+      // The rare case has been encountered where no fixedLine data is available
+      // (true for some non-geographical entities), so we just check mobile.
+      return TestNumberLength(length, PhoneNumberUtil::MOBILE);
+    }
+    if (HasPossibleNumberData(PhoneNumberUtil::MOBILE)) {
+      possible_lengths |= PossibleLengths(PhoneNumberUtil::MOBILE);
+      local_lengths |= local_only_lengths_[PhoneNumberUtil::MOBILE];
+    }
+  }
+  if (possible_lengths == 0) {
+    return PhoneNumberUtil::INVALID_LENGTH;
+  }
+  // This is safe because there is never an overlap beween the possible lengths
+  // and the local-only lengths; this is checked at build time.
+  if (HasLength(local_lengths, length)) {
+    return PhoneNumberUtil::IS_POSSIBLE_LOCAL_ONLY;
+  }
+  if (HasLength(possible_lengths, length)) {
+    return PhoneNumberUtil::IS_POSSIBLE;
+  }
+  if (length < 32 && (possible_lengths & ((uint32{1} << length) - 1)) == 0) {
+    // Every possible length is longer.
+    return PhoneNumberUtil::TOO_SHORT;
+  }
+  if (length >= 32 || possible_lengths >> length == 0) {
+    // Every possible length is shorter.
+    return PhoneNumberUtil::TOO_LONG;
+  }
+  return PhoneNumberUtil::INVALID_LENGTH;
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,116 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef I18N_PHONENUMBERS_HOT_METADATA_H_
+#define I18N_PHONENUMBERS_HOT_METADATA_H_
+
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/phonenumberutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+class PatternPool;
+class PhoneMetadata;
+class RegExp;
+
+// The fields of the metadata of a region which parsing and validation read on
+// every call, packed into two cache lines. The PhoneMetadata message spreads
+// them over many strings and nested messages; it is still used for the
+// patterns and the rest of the metadata, such as the formats and the example
+// numbers.
+//
+// The possible lengths of each number type are kept as bit masks, bit n being
+// set if n is a possible length, which spares searching and copying the
+// repeated fields of the message. The national number pattern of each type is
+// referenced by its id in a PatternPool, which shares it with the other
+// regions.
+class alignas(64) HotMetadata {
+ public:
+  // leading_digits is the compiled leading digits pattern of metadata, or NULL
+  // if it has none. Both must outlive this object. The national number
+  // patterns of metadata are interned in pattern_pool.
+  HotMetadata(const PhoneMetadata& metadata, const RegExp* leading_digits,
+              PatternPool* pattern_pool);
+
+  // The complete metadata of the region.
+  const PhoneMetadata& metadata() const {
+    return *metadata_;
+  }
+
+  // The compiled leading digits pattern of the region, or NULL.
+  const RegExp* leading_digits() const {
+    return leading_digits_;
+  }
+
+  int country_code() const {
+    return country_code_;
+  }
+
+  bool same_mobile_and_fixed_line_pattern() const {
+    return same_mobile_and_fixed_line_pattern_;
+  }
+
+  // The id in the pattern pool of the national number pattern of type, or
+  // PatternPool::kNoPattern if it has none. FIXED_LINE_OR_MOBILE stands for
+  // FIXED_LINE, and UNKNOWN for the general description.
+  int pattern_id(PhoneNumberUtil::PhoneNumberType type) const {
+    return pattern_ids_[type];
+  }
+
+  // Returns false if the number description of type has possible lengths and
+  // length isn't one of them, which is the check done before matching its
+  // pattern. FIXED_LINE_OR_MOBILE stands for FIXED_LINE, and UNKNOWN for the
+  // general description.
+  bool IsPossibleLengthForDesc(int length,
+                               PhoneNumberUtil::PhoneNumberType type) const;
+
+  // Checks length against the possible lengths of type, which are those of the
+  // general description if the type has none of its own, and determines
+  // whether it matches, or is too short or too long. The possible lengths of
+  // FIXED_LINE_OR_MOBILE are those of both types.
+  PhoneNumberUtil::ValidationResult TestNumberLength(
+      int length, PhoneNumberUtil::PhoneNumberType type) const;
+
+ private:
+  static const int kNumTypes = PhoneNumberUtil::UNKNOWN + 1;
+
+  // Returns whether type has possible lengths other than the -1 marking types
+  // without numbers.
+  bool HasPossibleNumberData(PhoneNumberUtil::PhoneNumberType type) const {
+    return !(types_without_numbers_ & (1 << type));
+  }
+
+  // Returns the possible lengths of type, falling back to those of the general
+  // description. 0 if there is no number of this type.
+  uint32 PossibleLengths(PhoneNumberUtil::PhoneNumberType type) const;
+
+  const PhoneMetadata* metadata_;
+  const RegExp* leading_digits_;
+  // The possible lengths of the description of each type, indexed by type.
+  // 0 if the description has no possible lengths of its own. Local-only
+  // lengths are all shorter than 16 digits.
+  uint32 possible_lengths_[kNumTypes];
+  uint16 local_only_lengths_[kNumTypes];
+  int16 pattern_ids_[kNumTypes];
+  int32 country_code_;
+  // Bit type is set if there is no number of this type.
+  uint16 types_without_numbers_;
+  bool same_mobile_and_fixed_line_pattern_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_HOT_METADATA_H_
@@ -0,0 +1,252 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/international_prefix_matcher.h"
+
+#include <cstddef>
+#include <string>
+
+#include "phonenumbers/default_logger.h"
+#include "phonenumbers/regexp_adapter.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+const uint16 kAllDigits = (1 << 10) - 1;
+
+// Upper bound on the repetitions of a term, to keep the backtracking bounded.
+const int kMaxRepeat = 16;
+
+bool IsAsciiDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Parses a non-negative number of at most two digits.
+bool ParseRepeatCount(absl::string_view pattern, size_t* position,
+                      int* count) {
+  const size_t start = *position;
+  *count = 0;
+  while (*position < pattern.length() && IsAsciiDigit(pattern[*position]) &&
+         *position - start < 2) {
+    *count = *count * 10 + pattern[(*position)++] - '0';
+  }
+  return *position > start;
+}
+
+}  // namespace
+
+InternationalPrefixMatcher::InternationalPrefixMatcher(
+    const string& pattern,
+    const AbstractRegExpFactory& regexp_factory)
+    : InternationalPrefixMatcher(pattern, regexp_factory, true) {}
+
+InternationalPrefixMatcher::InternationalPrefixMatcher(
+    const string& pattern,
+    const AbstractRegExpFactory& regexp_factory,
+    bool allow_compilation) {
+  // The whole pattern is a group of its top-level alternatives.
+  root_.push_back(Term());
+  size_t position = 0;
+  if (!allow_compilation ||
+      !ParseAlternatives(pattern, &position, &root_.back().alternatives) ||
+      position != pattern.length()) {
+    VLOG(2) << "Matching international prefix " << pattern
+            << " with a regular expression.";
+    root_.clear();
+    fallback_regexp_.reset(regexp_factory.CreateRegExp(pattern));
+  }
+}
+
+InternationalPrefixMatcher::~InternationalPrefixMatcher() {}
+
+bool InternationalPrefixMatcher::Consume(absl::string_view number,
+                                         size_t* end) const {
+  if (fallback_regexp_) {
+    return fallback_regexp_->Consume(number, end);
+  }
+  const size_t match_end = MatchSequence(root_, 0, NULL, number, 0);
+  if (match_end == string::npos) {
+    return false;
+  }
+  if (end) {
+    *end = match_end;
+  }
+  return true;
+}
+
+bool InternationalPrefixMatcher::ParseAlternatives(
+    absl::string_view pattern, size_t* position,
+    std::vector<Sequence>* alternatives) {
+  while (true) {
+    alternatives->push_back(Sequence());
+    if (!ParseSequence(pattern, position, &alternatives->back())) {
+      return false;
+    }
+    if (*position == pattern.length() || pattern[*position] != '|') {
+      return true;
+    }
+    ++*position;
+  }
+}
+
+bool InternationalPrefixMatcher::ParseSequence(absl::string_view pattern,
+                                               size_t* position,
+                                               Sequence* sequence) {
+  while (*position < pattern.length() && pattern[*position] != '|' &&
+         pattern[*position] != ')') {
+    Term term;
+    const char c = pattern[(*position)++];
+    if (IsAsciiDigit(c)) {
+      term.digits = 1 << (c - '0');
+    } else if (c == '\\') {
+      if (*position == pattern.length() || pattern[(*position)++] != 'd') {
+        return false;
+      }
+      term.digits = kAllDigits;
+    } else if (c == '[') {
+      while (*position < pattern.length() && pattern[*position] != ']') {
+        const char first = pattern[(*position)++];
+        char last = first;
+        if (*position + 1 < pattern.length() && pattern[*position] == '-' &&
+            pattern[*position + 1] != ']') {
+          last = pattern[*position + 1];
+          *position += 2;
+        }
+        if (first == '\\' && *position < pattern.length() &&
+            pattern[*position] == 'd') {
+          ++*position;
+          term.digits |= kAllDigits;
+          continue;
+        }
+        if (!IsAsciiDigit(first) || !IsAsciiDigit(last) || first > last) {
+          return false;
+        }
+        for (char digit = first; digit <= last; ++digit) {
+          term.digits |= 1 << (digit - '0');
+        }
+      }
+      if (*position == pattern.length() || term.digits == 0) {
+        return false;
+      }
+      ++*position;  // Skips the closing bracket.
+    } else if (c == '(') {
+      if (pattern.substr(*position, 2) != "?:") {
+        return false;
+      }
+      *position += 2;
+      if (!ParseAlternatives(pattern, position, &term.alternatives) ||
+          *position == pattern.length()) {
+        return false;
+      }
+      ++*position;  // Skips the closing parenthesis.
+    } else {
+      return false;
+    }
+    if (!ParseQuantifier(pattern, position, &term)) {
+      return false;
+    }
+    sequence->push_back(term);
+  }
+  return true;
+}
+
+bool InternationalPrefixMatcher::ParseQuantifier(absl::string_view pattern,
+                                                 size_t* position,
+                                                 Term* term) {
+  if (*position == pattern.length()) {
+    return true;
+  }
+  const char c = pattern[*position];
+  if (c == '?') {
+    ++*position;
+    if (term->digits == 0) {
+      // An optional group is a group with an additional empty alternative,
+      // tried last since the quantifier is greedy.
+      term->alternatives.push_back(Sequence());
+    } else {
+      term->min_repeat = 0;
+    }
+  } else if (c == '{') {
+    // Only digit classes can be repeated.
+    if (term->digits == 0) {
+      return false;
+    }
+    ++*position;
+    if (!ParseRepeatCount(pattern, position, &term->min_repeat)) {
+      return false;
+    }
+    term->max_repeat = term->min_repeat;
+    if (*position < pattern.length() && pattern[*position] == ',') {
+      ++*position;
+      if (!ParseRepeatCount(pattern, position, &term->max_repeat)) {
+        return false;
+      }
+    }
+    if (*position == pattern.length() || pattern[*position] != '}' ||
+        term->min_repeat > term->max_repeat || term->max_repeat > kMaxRepeat) {
+      return false;
+    }
+    ++*position;
+  } else {
+    return true;
+  }
+  // Lazy and possessive quantifiers are not supported.
+  return *position == pattern.length() ||
+      (pattern[*position] != '?' && pattern[*position] != '+' &&
+       pattern[*position] != '*' && pattern[*position] != '{');
+}
+
+size_t InternationalPrefixMatcher::MatchSequence(const Sequence& sequence,
+                                                 size_t index,
+                                                 const Continuation* next,
+                                                 absl::string_view number,
+                                                 size_t position) {
+  if (index == sequence.size()) {
+    return next ? MatchSequence(*next->sequence, next->index, next->next,
+                                number, position)
+                : position;
+  }
+  const Term& term = sequence[index];
+  if (term.digits == 0) {
+    const Continuation rest = { &sequence, index + 1, next };
+    for (std::vector<Sequence>::const_iterator it = term.alternatives.begin();
+         it != term.alternatives.end(); ++it) {
+      const size_t end = MatchSequence(*it, 0, &rest, number, position);
+      if (end != string::npos) {
+        return end;
+      }
+    }
+    return string::npos;
+  }
+  // Digit classes are greedy, so the longest repetition is tried first.
+  int repeat = 0;
+  while (repeat < term.max_repeat && position + repeat < number.length() &&
+         IsAsciiDigit(number[position + repeat]) &&
+         (term.digits & (1 << (number[position + repeat] - '0')))) {
+    ++repeat;
+  }
+  for (; repeat >= term.min_repeat; --repeat) {
+    const size_t end =
+        MatchSequence(sequence, index + 1, next, number, position + repeat);
+    if (end != string::npos) {
+      return end;
+    }
+  }
+  return string::npos;
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
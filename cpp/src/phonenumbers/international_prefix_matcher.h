@@ -0,0 +1,118 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// InternationalPrefixMatcher matches the international dialling (IDD) prefix
+// pattern of a region, such as "00" or "0(?:0|1[12])", at the start of a
+// normalized number without using the regular expression engine.
+//
+// International prefix patterns only use a small subset of the regular
+// expression syntax: digits, \d, digit classes such as [2-9], non-capturing
+// groups with alternatives and the ?, {n} and {n,m} quantifiers. Such patterns
+// are compiled once into a tree matched by backtracking in the same order as a
+// regular expression engine would, so that the same prefix is matched. Other
+// patterns are matched with a RegExp instead.
+//
+// InternationalPrefixMatcher matcher("00|1(?:0(?:01|[12]0)|100)", factory);
+// size_t end;
+// matcher.Consume("0041446681800", &end);  // Returns true, end is 2.
+
+#ifndef I18N_PHONENUMBERS_INTERNATIONAL_PREFIX_MATCHER_H_
+#define I18N_PHONENUMBERS_INTERNATIONAL_PREFIX_MATCHER_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/base/memory/scoped_ptr.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+class AbstractRegExpFactory;
+class RegExp;
+
+class InternationalPrefixMatcher {
+ public:
+  InternationalPrefixMatcher(const string& pattern,
+                             const AbstractRegExpFactory& regexp_factory);
+
+  // Same as above, but always matches the pattern with a RegExp unless
+  // allow_compilation is true. This serves as a reference in tests.
+  InternationalPrefixMatcher(const string& pattern,
+                             const AbstractRegExpFactory& regexp_factory,
+                             bool allow_compilation);
+
+  // This type is neither copyable nor movable.
+  InternationalPrefixMatcher(const InternationalPrefixMatcher&) = delete;
+  InternationalPrefixMatcher& operator=(const InternationalPrefixMatcher&) =
+      delete;
+
+  ~InternationalPrefixMatcher();
+
+  // Returns true if the pattern matches at the start of number, in which case
+  // end is set to the length of the match. end can be NULL.
+  bool Consume(absl::string_view number, size_t* end) const;
+
+  // Returns true if the pattern is matched without a RegExp.
+  bool IsCompiled() const { return fallback_regexp_ == NULL; }
+
+ private:
+  struct Term;
+  typedef std::vector<Term> Sequence;
+
+  // A digit class repeated between min_repeat and max_repeat times, or a
+  // group of alternatives (matched exactly once) if digits is 0.
+  struct Term {
+    Term() : digits(0), min_repeat(1), max_repeat(1) {}
+
+    uint16 digits;  // Bit i is set if the ASCII digit i is in the class.
+    int min_repeat;
+    int max_repeat;
+    std::vector<Sequence> alternatives;
+  };
+
+  // The part of the pattern left to match once a sequence has been matched up
+  // to a given term, as a linked list living on the stack.
+  struct Continuation {
+    const Sequence* sequence;
+    size_t index;
+    const Continuation* next;
+  };
+
+  static bool ParseAlternatives(absl::string_view pattern, size_t* position,
+                                std::vector<Sequence>* alternatives);
+  static bool ParseSequence(absl::string_view pattern, size_t* position,
+                            Sequence* sequence);
+  static bool ParseQuantifier(absl::string_view pattern, size_t* position,
+                              Term* term);
+
+  // Returns the end of the first match, in the order a regular expression
+  // engine would try them, of sequence from index followed by next, starting
+  // at position. Returns string::npos if there is no such match.
+  static size_t MatchSequence(const Sequence& sequence, size_t index,
+                              const Continuation* next,
+                              absl::string_view number, size_t position);
+
+  Sequence root_;
+  scoped_ptr<const RegExp> fallback_regexp_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_INTERNATIONAL_PREFIX_MATCHER_H_
@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <string>
 
 #include "phonenumbers/utf/unicodetext.h"
+#include "phonenumbers/utf/unilib.h"
 
 namespace i18n {
 namespace phonenumbers {
@@ -24,9 +26,31 @@ struct NormalizeUTF8 {
   // their ASCII counterparts; all other characters are copied from input to
   // output.
   static string NormalizeDecimalDigits(const string& number) {
+    return NormalizeDecimalDigits(number, false);
+  }
+
+  // Same as above. If utf8_validated is true, the number is already known to
+  // be interchange-valid UTF-8, and isn't validated again.
+  static string NormalizeDecimalDigits(const string& number,
+                                       bool utf8_validated) {
+    // Interchange-valid ASCII needs neither decoding nor normalization.
+    if (utf8_validated
+            ? std::find_if(number.begin(), number.end(), [](char c) {
+                return (c & 0x80) != 0;
+              }) == number.end()
+            : UniLib::SpanInterchangeValidAscii(number) ==
+                  static_cast<int>(number.size())) {
+      return number;
+    }
     string normalized;
     UnicodeText number_as_unicode;
-    number_as_unicode.PointToUTF8(number.data(), static_cast<int>(number.size()));
+    if (utf8_validated) {
+      number_as_unicode.PointToValidUTF8(number.data(),
+                                         static_cast<int>(number.size()));
+    } else {
+      number_as_unicode.PointToUTF8(number.data(),
+                                    static_cast<int>(number.size()));
+    }
     if (!number_as_unicode.UTF8WasValid())
       return normalized; // Return an empty result to indicate an error
     for (UnicodeText::const_iterator it = number_as_unicode.begin();
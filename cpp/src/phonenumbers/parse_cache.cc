@@ -0,0 +1,278 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/parse_cache.h"
+
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/stl_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+// The maximum number of shards. Caches of fewer entries have one shard per
+// entry.
+const size_t kMaxShards = 16;
+
+// Longer inputs aren't cached, which bounds the memory used by each entry.
+// Phone numbers are much shorter, even with an extension and formatting.
+const size_t kMaxCachedInputLength = 128;
+
+// Identifies an entry. The strings are those of the entry in the index, and
+// those passed by the caller when looking an entry up.
+struct CacheKey {
+  CacheKey(absl::string_view text, absl::string_view region,
+           bool keep_raw_input)
+      : text(text), region(region), keep_raw_input(keep_raw_input) {}
+
+  bool operator==(const CacheKey& other) const {
+    return text == other.text && region == other.region &&
+           keep_raw_input == other.keep_raw_input;
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const CacheKey& key) {
+    return H::combine(std::move(h), key.text, key.region, key.keep_raw_input);
+  }
+
+  absl::string_view text;
+  absl::string_view region;
+  bool keep_raw_input;
+};
+
+// The result of parsing text with region. The fields of the number are only
+// meaningful if error is NO_PARSING_ERROR, and raw_input is text.
+struct CacheEntry {
+  CacheEntry(const string& text, const string& region, bool keep_raw_input)
+      : text(text),
+        region(region),
+        keep_raw_input(keep_raw_input),
+        error(PhoneNumberUtil::NO_PARSING_ERROR),
+        country_code_source(PhoneNumber::UNSPECIFIED),
+        leading_zeros(0),
+        country_code(0),
+        national_number(0) {}
+
+  CacheKey Key() const {
+    return CacheKey(text, region, keep_raw_input);
+  }
+
+  const string text;
+  const string region;
+  const bool keep_raw_input;
+  int8 error;
+  // Only meaningful if keep_raw_input is true.
+  int8 country_code_source;
+  // 0 if the number has no Italian leading zero.
+  int32 leading_zeros;
+  int32 country_code;
+  uint64 national_number;
+  string extension;
+  string preferred_domestic_carrier_code;
+};
+
+// Stores the parsing result in entry.
+void ToCacheEntry(PhoneNumberUtil::ErrorType error, const PhoneNumber& number,
+                  CacheEntry* entry) {
+  entry->error = static_cast<int8>(error);
+  if (error != PhoneNumberUtil::NO_PARSING_ERROR) {
+    return;
+  }
+  entry->country_code_source = static_cast<int8>(number.country_code_source());
+  if (number.italian_leading_zero()) {
+    entry->leading_zeros = number.number_of_leading_zeros();
+  }
+  entry->country_code = number.country_code();
+  entry->national_number = number.national_number();
+  entry->extension = number.extension();
+  entry->preferred_domestic_carrier_code =
+      number.preferred_domestic_carrier_code();
+}
+
+// Builds the number parsed from entry, setting the same fields as
+// PhoneNumberUtil::Parse() does, and returns the parsing result. number is
+// left unchanged if parsing failed.
+PhoneNumberUtil::ErrorType FromCacheEntry(const CacheEntry& entry,
+                                          PhoneNumber* number) {
+  const PhoneNumberUtil::ErrorType error =
+      static_cast<PhoneNumberUtil::ErrorType>(entry.error);
+  if (error != PhoneNumberUtil::NO_PARSING_ERROR) {
+    return error;
+  }
+  number->Clear();
+  number->set_country_code(entry.country_code);
+  number->set_national_number(entry.national_number);
+  if (!entry.extension.empty()) {
+    number->set_extension(entry.extension);
+  }
+  if (entry.leading_zeros > 0) {
+    number->set_italian_leading_zero(true);
+    if (entry.leading_zeros != 1) {
+      number->set_number_of_leading_zeros(entry.leading_zeros);
+    }
+  }
+  if (entry.keep_raw_input) {
+    number->set_raw_input(entry.text);
+    number->set_country_code_source(
+        static_cast<PhoneNumber::CountryCodeSource>(entry.country_code_source));
+    if (!entry.preferred_domestic_carrier_code.empty()) {
+      number->set_preferred_domestic_carrier_code(
+          entry.preferred_domestic_carrier_code);
+    }
+  }
+  return error;
+}
+
+}  // namespace
+
+// The entries of a shard are kept from the most to the least recently used.
+// They are shared and immutable, so that a lookup only copies a pointer while
+// holding the lock.
+struct ParseCache::Shard {
+  typedef std::list<std::shared_ptr<const CacheEntry> > EntryList;
+
+  explicit Shard(size_t capacity) : capacity(capacity) {}
+
+  const size_t capacity;
+  absl::Mutex mutex;
+  EntryList entries ABSL_GUARDED_BY(mutex);
+  absl::flat_hash_map<CacheKey, EntryList::iterator> index
+      ABSL_GUARDED_BY(mutex);
+};
+
+ParseCache::ParseCache(const PhoneNumberUtil& util, size_t capacity)
+    : phone_util_(util),
+      hits_(0),
+      misses_(0) {
+  const size_t num_shards = std::max<size_t>(1, std::min(capacity, kMaxShards));
+  for (size_t i = 0; i < num_shards; ++i) {
+    // The first shards get the remainder of the division.
+    shards_.push_back(
+        new Shard(capacity / num_shards + (i < capacity % num_shards ? 1 : 0)));
+  }
+}
+
+ParseCache::~ParseCache() {
+  gtl::STLDeleteElements(&shards_);
+}
+
+PhoneNumberUtil::ErrorType ParseCache::Parse(const string& number_to_parse,
+                                             const string& default_region,
+                                             PhoneNumber* number) const {
+  DCHECK(number);
+  return ParseHelper(number_to_parse, default_region, false, number);
+}
+
+PhoneNumberUtil::ErrorType ParseCache::ParseAndKeepRawInput(
+    const string& number_to_parse,
+    const string& default_region,
+    PhoneNumber* number) const {
+  DCHECK(number);
+  return ParseHelper(number_to_parse, default_region, true, number);
+}
+
+void ParseCache::Clear() {
+  for (vector<Shard*>::const_iterator it = shards_.begin();
+       it != shards_.end(); ++it) {
+    absl::MutexLock lock(&(*it)->mutex);
+    (*it)->index.clear();
+    (*it)->entries.clear();
+  }
+}
+
+size_t ParseCache::size() const {
+  size_t size = 0;
+  for (vector<Shard*>::const_iterator it = shards_.begin();
+       it != shards_.end(); ++it) {
+    absl::MutexLock lock(&(*it)->mutex);
+    size += (*it)->entries.size();
+  }
+  return size;
+}
+
+PhoneNumberUtil::ErrorType ParseCache::ParseHelper(
+    const string& number_to_parse,
+    const string& default_region,
+    bool keep_raw_input,
+    PhoneNumber* number) const {
+  if (number_to_parse.length() > kMaxCachedInputLength ||
+      shards_[0]->capacity == 0) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return keep_raw_input
+        ? phone_util_.ParseAndKeepRawInput(number_to_parse, default_region,
+                                           number)
+        : phone_util_.Parse(number_to_parse, default_region, number);
+  }
+  const CacheKey key(number_to_parse, default_region, keep_raw_input);
+  Shard* const shard =
+      shards_[absl::Hash<CacheKey>()(key) % shards_.size()];
+  // The number is built from the entry found after releasing the lock, which
+  // the entry outlives even if it is evicted meanwhile.
+  std::shared_ptr<const CacheEntry> cached_entry;
+  {
+    absl::MutexLock lock(&shard->mutex);
+    const absl::flat_hash_map<CacheKey, Shard::EntryList::iterator>::iterator
+        it = shard->index.find(key);
+    if (it != shard->index.end()) {
+      shard->entries.splice(shard->entries.begin(), shard->entries,
+                            it->second);
+      cached_entry = *it->second;
+    }
+  }
+  if (cached_entry) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return FromCacheEntry(*cached_entry, number);
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  // The number is parsed without holding the lock, so that other calls may
+  // use the shard meanwhile.
+  const std::shared_ptr<CacheEntry> new_entry = std::make_shared<CacheEntry>(
+      number_to_parse, default_region, keep_raw_input);
+  const PhoneNumberUtil::ErrorType error =
+      keep_raw_input
+          ? phone_util_.ParseAndKeepRawInput(number_to_parse, default_region,
+                                             number)
+          : phone_util_.Parse(number_to_parse, default_region, number);
+  ToCacheEntry(error, *number, new_entry.get());
+  // The list node is allocated here too, and spliced in under the lock.
+  Shard::EntryList new_entries(1, new_entry);
+
+  absl::MutexLock lock(&shard->mutex);
+  // Another call may have added the same entry meanwhile.
+  if (shard->index.find(key) != shard->index.end()) {
+    return error;
+  }
+  shard->entries.splice(shard->entries.begin(), new_entries);
+  shard->index.insert(
+      std::make_pair(shard->entries.front()->Key(), shard->entries.begin()));
+  if (shard->entries.size() > shard->capacity) {
+    shard->index.erase(shard->entries.back()->Key());
+    shard->entries.pop_back();
+  }
+  return error;
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
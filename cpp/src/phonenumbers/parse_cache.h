@@ -0,0 +1,104 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// A bounded cache of the results of PhoneNumberUtil::Parse() and
+// ParseAndKeepRawInput(), for services parsing the same strings over and over,
+// such as saved contacts and sender ids:
+//
+// ParseCache cache(*PhoneNumberUtil::GetInstance(), 100000);
+// PhoneNumber number;
+// PhoneNumberUtil::ErrorType error = cache.Parse(text, "CH", &number);
+//
+// The results are the same as those of PhoneNumberUtil, errors included.
+
+#ifndef I18N_PHONENUMBERS_PARSE_CACHE_H_
+#define I18N_PHONENUMBERS_PARSE_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/phonenumberutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+// Caches the results of parsing, keyed by the string parsed, the default region
+// and whether the raw input is kept. Each entry holds the fields of the parsed
+// number rather than a PhoneNumber message, plus the error returned.
+//
+// The entries are spread over shards, each with its own lock and evicting its
+// least recently used entries, so that concurrent calls seldom wait for each
+// other. This class is thread-safe.
+class ParseCache {
+ public:
+  // Creates a cache of up to about capacity entries in total.
+  ParseCache(const PhoneNumberUtil& util, size_t capacity);
+
+  // This type is neither copyable nor movable.
+  ParseCache(const ParseCache&) = delete;
+  ParseCache& operator=(const ParseCache&) = delete;
+
+  ~ParseCache();
+
+  // Same as PhoneNumberUtil::Parse().
+  PhoneNumberUtil::ErrorType Parse(const string& number_to_parse,
+                                   const string& default_region,
+                                   PhoneNumber* number) const;
+
+  // Same as PhoneNumberUtil::ParseAndKeepRawInput().
+  PhoneNumberUtil::ErrorType ParseAndKeepRawInput(const string& number_to_parse,
+                                                  const string& default_region,
+                                                  PhoneNumber* number) const;
+
+  // Removes every entry. The counters are kept.
+  void Clear();
+
+  // Returns the number of entries.
+  size_t size() const;
+
+  // The number of calls whose result was found in the cache, and of those
+  // which had to parse their input. Inputs too long to be cached count as
+  // misses.
+  int64 hits() const {
+    return hits_.load(std::memory_order_relaxed);
+  }
+
+  int64 misses() const {
+    return misses_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Shard;
+
+  PhoneNumberUtil::ErrorType ParseHelper(const string& number_to_parse,
+                                         const string& default_region,
+                                         bool keep_raw_input,
+                                         PhoneNumber* number) const;
+
+  const PhoneNumberUtil& phone_util_;
+  vector<Shard*> shards_;
+  mutable std::atomic<int64> hits_;
+  mutable std::atomic<int64> misses_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_PARSE_CACHE_H_
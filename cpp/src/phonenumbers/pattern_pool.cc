@@ -0,0 +1,89 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/pattern_pool.h"
+
+#include <utility>
+
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/regexp_adapter.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+const int PatternPool::kNoPattern;
+
+PatternPool::PatternPool(const AbstractRegExpFactory& regexp_factory)
+    : regexp_factory_(regexp_factory),
+      num_references_(0),
+      referenced_bytes_(0),
+      pattern_bytes_(0),
+      num_compiled_(0) {}
+
+PatternPool::~PatternPool() {
+  for (std::deque<Entry>::const_iterator it = entries_.begin();
+       it != entries_.end(); ++it) {
+    delete it->regexp.load(std::memory_order_relaxed);
+  }
+}
+
+int PatternPool::Intern(const string& pattern) {
+  if (pattern.empty()) {
+    return kNoPattern;
+  }
+  ++num_references_;
+  referenced_bytes_ += static_cast<int>(pattern.length());
+  absl::flat_hash_map<absl::string_view, int>::const_iterator it =
+      ids_.find(pattern);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  const int id = size();
+  entries_.emplace_back(pattern);
+  ids_.insert(std::make_pair(absl::string_view(entries_.back().pattern), id));
+  pattern_bytes_ += static_cast<int>(pattern.length());
+  return id;
+}
+
+const string& PatternPool::pattern(int id) const {
+  DCHECK(id >= 0 && id < size());
+  return entries_[id].pattern;
+}
+
+const RegExp& PatternPool::GetRegExp(int id) const {
+  DCHECK(id >= 0 && id < size());
+  const Entry& entry = entries_[id];
+  const RegExp* regexp = entry.regexp.load(std::memory_order_acquire);
+  if (regexp) {
+    return *regexp;
+  }
+  // Threads matching the same pattern for the first time may compile it
+  // concurrently; the first one to finish publishes its regular expression,
+  // and the others use it instead of their own.
+  const RegExp* const compiled = regexp_factory_.CreateRegExp(entry.pattern);
+  if (entry.regexp.compare_exchange_strong(regexp, compiled,
+                                           std::memory_order_acq_rel)) {
+    num_compiled_.fetch_add(1, std::memory_order_relaxed);
+    return *compiled;
+  }
+  delete compiled;
+  return *regexp;
+}
+
+bool PatternPool::FullMatch(int id, const string& number) const {
+  return id != kNoPattern && GetRegExp(id).FullMatch(number);
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
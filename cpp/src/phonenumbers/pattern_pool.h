@@ -0,0 +1,126 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// PatternPool stores each distinct pattern of the number descriptions once and
+// identifies it by a small integer id. Many regions share patterns, such as
+// those of the NANPA regions or the "\d{7,10}"-like general descriptions, so
+// the pool holds far fewer patterns than the metadata references.
+//
+// Each pattern is compiled the first time it is matched, and only once: the
+// compiled regular expression is shared by all the descriptions referencing
+// the pattern, and is read without locking afterwards, unlike with RegExpCache
+// which looks the pattern string up under a lock on every call.
+//
+// PatternPool pool(regexp_factory);
+// const int id = pool.Intern("[2-9]\\d{9}");
+// ...
+// const bool matches = pool.GetRegExp(id).FullMatch(number);
+
+#ifndef I18N_PHONENUMBERS_PATTERN_POOL_H_
+#define I18N_PHONENUMBERS_PATTERN_POOL_H_
+
+#include <atomic>
+#include <deque>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+class AbstractRegExpFactory;
+class RegExp;
+
+class PatternPool {
+ public:
+  // The id of the empty pattern, which matches no number.
+  static const int kNoPattern = -1;
+
+  // regexp_factory must outlive this object.
+  explicit PatternPool(const AbstractRegExpFactory& regexp_factory);
+
+  // This type is neither copyable nor movable.
+  PatternPool(const PatternPool&) = delete;
+  PatternPool& operator=(const PatternPool&) = delete;
+
+  ~PatternPool();
+
+  // Returns the id of pattern, adding it to the pool if it isn't there yet, or
+  // kNoPattern if pattern is empty. Patterns are interned while loading the
+  // metadata: this must not be called concurrently with any other method.
+  int Intern(const string& pattern);
+
+  const string& pattern(int id) const;
+
+  // Returns the compiled pattern of id, compiling it on the first call. This
+  // method is thread-safe.
+  const RegExp& GetRegExp(int id) const;
+
+  // Returns whether number matches the whole pattern of id. Always false for
+  // kNoPattern.
+  bool FullMatch(int id, const string& number) const;
+
+  // The number of distinct patterns in the pool.
+  int size() const {
+    return static_cast<int>(entries_.size());
+  }
+
+  // The number of calls to Intern() with a non-empty pattern, i.e. the number
+  // of patterns the pool would hold without sharing them, and the total length
+  // of these patterns.
+  int num_references() const {
+    return num_references_;
+  }
+  int referenced_bytes() const {
+    return referenced_bytes_;
+  }
+
+  // The total length of the distinct patterns.
+  int pattern_bytes() const {
+    return pattern_bytes_;
+  }
+
+  // The number of patterns compiled so far, each of them once.
+  int num_compiled() const {
+    return num_compiled_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Entry {
+    explicit Entry(const string& pattern) : pattern(pattern), regexp(NULL) {}
+
+    const string pattern;
+    // NULL until the pattern is first matched.
+    mutable std::atomic<const RegExp*> regexp;
+  };
+
+  const AbstractRegExpFactory& regexp_factory_;
+  // A deque keeps the entries in place as it grows, so that the keys of ids_
+  // can refer to their patterns.
+  std::deque<Entry> entries_;
+  absl::flat_hash_map<absl::string_view, int> ids_;
+  int num_references_;
+  int referenced_bytes_;
+  int pattern_bytes_;
+  mutable std::atomic<int> num_compiled_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_PATTERN_POOL_H_
@@ -42,11 +42,13 @@
 #include "phonenumbers/callback.h"
 #include "phonenumbers/default_logger.h"
 #include "phonenumbers/encoding_utils.h"
+#include "phonenumbers/execution_budget.h"
 #include "phonenumbers/normalize_utf8.h"
 #include "phonenumbers/phonemetadata.pb.h"
 #include "phonenumbers/phonenumber.pb.h"
 #include "phonenumbers/phonenumbermatch.h"
 #include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/region_code.h"
 #include "phonenumbers/regexp_adapter.h"
 #include "phonenumbers/regexp_adapter_icu.h"
 #include "phonenumbers/regexp_cache.h"
@@ -260,7 +262,6 @@ class PhoneNumberMatcherRegExps : public Singleton<PhoneNumberMatcherRegExps> {
   // Note that if there is a match, we will always check any text found up to
   // the first match as well.
   scoped_ptr<std::vector<const RegExp*> > inner_matches_;
-  scoped_ptr<const RegExp> capture_up_to_second_number_start_pattern_;
   scoped_ptr<const RegExp> capturing_ascii_digits_pattern_;
   // Compiled reg-ex representing lead_class_;
   scoped_ptr<const RegExp> lead_class_pattern_;
@@ -312,9 +313,6 @@ class PhoneNumberMatcherRegExps : public Singleton<PhoneNumberMatcherRegExps> {
             StrCat(leading_maybe_matched_bracket_, non_parens_, "+",
                    bracket_pairs_, non_parens_, "*"))),
         inner_matches_(new std::vector<const RegExp*>()),
-        capture_up_to_second_number_start_pattern_(
-            regexp_factory_->CreateRegExp(
-                PhoneNumberUtil::kCaptureUpToSecondNumberStart)),
         capturing_ascii_digits_pattern_(
             regexp_factory_->CreateRegExp("(\\d+)")),
         lead_class_pattern_(regexp_factory_->CreateRegExp(lead_class_)),
@@ -398,34 +396,56 @@ PhoneNumberMatcher::PhoneNumberMatcher(const PhoneNumberUtil& util,
                                        const string& region_code,
                                        PhoneNumberMatcher::Leniency leniency,
                                        int max_tries)
-    : reg_exps_(PhoneNumberMatcherRegExps::GetInstance()),
-      alternate_formats_(AlternateFormats::GetInstance()),
-      phone_util_(util),
-      text_(text),
-      preferred_region_(region_code),
-      leniency_(leniency),
-      max_tries_(max_tries),
-      state_(NOT_READY),
-      last_match_(NULL),
-      search_index_(0),
-      is_input_valid_utf8_(true) {
-  is_input_valid_utf8_ = IsInputUtf8(); 
+    : PhoneNumberMatcher(util, text, true, vector<string>(1, region_code),
+                         leniency, max_tries, NULL) {}
+
+PhoneNumberMatcher::PhoneNumberMatcher(const PhoneNumberUtil& util,
+                                       const string& text,
+                                       const string& region_code,
+                                       PhoneNumberMatcher::Leniency leniency,
+                                       int max_tries,
+                                       ExecutionBudget* budget)
+    : PhoneNumberMatcher(util, text, true, vector<string>(1, region_code),
+                         leniency, max_tries, budget) {
+  DCHECK(budget);
 }
 
+PhoneNumberMatcher::PhoneNumberMatcher(const PhoneNumberUtil& util,
+                                       const string& text,
+                                       const vector<string>& region_codes,
+                                       PhoneNumberMatcher::Leniency leniency,
+                                       int max_tries)
+    : PhoneNumberMatcher(util, text, true, region_codes, leniency, max_tries,
+                         NULL) {}
+
 PhoneNumberMatcher::PhoneNumberMatcher(const string& text,
                                        const string& region_code)
+    : PhoneNumberMatcher(*PhoneNumberUtil::GetInstance(), text, region_code,
+                         VALID, numeric_limits<int>::max()) {}
+
+PhoneNumberMatcher::PhoneNumberMatcher(const PhoneNumberUtil& util,
+                                       absl::string_view text,
+                                       bool copy_text,
+                                       const vector<string>& region_codes,
+                                       PhoneNumberMatcher::Leniency leniency,
+                                       int max_tries,
+                                       ExecutionBudget* budget)
     : reg_exps_(PhoneNumberMatcherRegExps::GetInstance()),
-      alternate_formats_(NULL),  // Not used.
-      phone_util_(*PhoneNumberUtil::GetInstance()),
-      text_(text),
-      preferred_region_(region_code),
-      leniency_(VALID),
-      max_tries_(numeric_limits<int>::max()),
+      alternate_formats_(AlternateFormats::GetInstance()),
+      phone_util_(util),
+      text_copy_(copy_text ? string(text) : string()),
+      text_(copy_text ? absl::string_view(text_copy_) : text),
+      preferred_regions_(region_codes),
+      leniency_(leniency),
+      max_tries_(max_tries),
+      budget_(budget),
       state_(NOT_READY),
       last_match_(NULL),
+      last_match_region_index_(0),
       search_index_(0),
       is_input_valid_utf8_(true) {
-  is_input_valid_utf8_ =  IsInputUtf8();
+  DCHECK(!region_codes.empty());
+  is_input_valid_utf8_ = IsInputUtf8();
 }
 
 PhoneNumberMatcher::~PhoneNumberMatcher() {
@@ -433,7 +453,7 @@ PhoneNumberMatcher::~PhoneNumberMatcher() {
 
 bool PhoneNumberMatcher::IsInputUtf8() {
   UnicodeText number_as_unicode;
-  number_as_unicode.PointToUTF8(text_.c_str(), text_.size());
+  number_as_unicode.PointToUTF8(text_.data(), text_.size());
   return number_as_unicode.UTF8WasValid();
 }
 
@@ -453,8 +473,8 @@ bool PhoneNumberMatcher::IsLatinLetter(char32 letter) {
 }
 
 bool PhoneNumberMatcher::ParseAndVerify(const string& candidate, int offset,
-                                        PhoneNumberMatch* match) {
-  DCHECK(match);
+                                        MatchSpan* span, PhoneNumber* number) {
+  DCHECK(span);
   // Check the candidate doesn't contain any formatting which would indicate
   // that it really isn't a phone number.
   if (!reg_exps_->matching_brackets_->FullMatch(candidate) ||
@@ -468,14 +488,12 @@ bool PhoneNumberMatcher::ParseAndVerify(const string& candidate, int offset,
   if (leniency_ >= VALID) {
     // If the candidate is not at the start of the text, and does not start with
     // phone-number punctuation, check the previous character.
-    scoped_ptr<RegExpInput> candidate_input(
-        reg_exps_->regexp_factory_->CreateInput(candidate));
     if (offset > 0 &&
-        !reg_exps_->lead_class_pattern_->Consume(candidate_input.get())) {
+        !reg_exps_->lead_class_pattern_->Consume(candidate, NULL)) {
       char32 previous_char;
       const char* previous_char_ptr =
-          EncodingUtils::BackUpOneUTF8Character(text_.c_str(),
-                                                text_.c_str() + offset);
+          EncodingUtils::BackUpOneUTF8Character(text_.data(),
+                                                text_.data() + offset);
       EncodingUtils::DecodeUTF8Char(previous_char_ptr, &previous_char);
       // We return false if it is a latin letter or an invalid punctuation
       // symbol.
@@ -489,7 +507,7 @@ bool PhoneNumberMatcher::ParseAndVerify(const string& candidate, int offset,
       char32 next_char;
       const char* next_char_ptr =
           EncodingUtils::AdvanceOneUTF8Character(
-              text_.c_str() + lastCharIndex - 1);
+              text_.data() + lastCharIndex - 1);
       EncodingUtils::DecodeUTF8Char(next_char_ptr, &next_char);
       if (IsInvalidPunctuationSymbol(next_char) || IsLatinLetter(next_char)) {
         return false;
@@ -497,24 +515,36 @@ bool PhoneNumberMatcher::ParseAndVerify(const string& candidate, int offset,
     }
   }
 
-  PhoneNumber number;
-  if (phone_util_.ParseAndKeepRawInput(candidate, preferred_region_, &number) !=
-      PhoneNumberUtil::NO_PARSING_ERROR) {
-    return false;
-  }
-
-  if (VerifyAccordingToLeniency(leniency_, number, candidate)) {
-    match->set_start(offset);
-    match->set_raw_string(candidate);
-    // We used ParseAndKeepRawInput to create this number, but for now we don't
-    // return the extra values parsed. TODO: stop clearing all values here and
-    // switch all users over to using raw_input() rather than the raw_string()
-    // of PhoneNumberMatch.
-    number.clear_country_code_source();
-    number.clear_preferred_domestic_carrier_code();
-    number.clear_raw_input();
-    match->set_number(number);
-    return true;
+  PhoneNumber parsed_number;
+  for (size_t i = 0; i < preferred_regions_.size(); ++i) {
+    const PhoneNumberUtil::ErrorType error = phone_util_.ParseAndKeepRawInput(
+        candidate, preferred_regions_[i], &parsed_number);
+    if (error == PhoneNumberUtil::NO_PARSING_ERROR &&
+        VerifyAccordingToLeniency(leniency_, parsed_number, candidate)) {
+      span->start = offset;
+      span->length = static_cast<int>(candidate.length());
+      span->country_code = parsed_number.country_code();
+      span->region_index = static_cast<int>(i);
+      if (number) {
+        // We used ParseAndKeepRawInput to create this number, but for now we
+        // don't return the extra values parsed. TODO: stop clearing all values
+        // here and switch all users over to using raw_input() rather than the
+        // raw_string() of PhoneNumberMatch.
+        parsed_number.clear_country_code_source();
+        parsed_number.clear_preferred_domestic_carrier_code();
+        parsed_number.clear_raw_input();
+        number->Swap(&parsed_number);
+      }
+      return true;
+    }
+    // The other regions can't do better when the candidate isn't a number at
+    // all, or when it was parsed and verified without using the region.
+    if (error == PhoneNumberUtil::NOT_A_NUMBER ||
+        (error == PhoneNumberUtil::NO_PARSING_ERROR &&
+         parsed_number.country_code_source() ==
+             PhoneNumber::FROM_NUMBER_WITH_PLUS_SIGN)) {
+      break;
+    }
   }
   return false;
 }
@@ -572,8 +602,9 @@ bool PhoneNumberMatcher::VerifyAccordingToLeniency(
 }
 
 bool PhoneNumberMatcher::ExtractInnerMatch(const string& candidate, int offset,
-                                           PhoneNumberMatch* match) {
-  DCHECK(match);
+                                           MatchSpan* span,
+                                           PhoneNumber* number) {
+  DCHECK(span);
   for (std::vector<const RegExp*>::const_iterator regex =
            reg_exps_->inner_matches_->begin();
            regex != reg_exps_->inner_matches_->end(); regex++) {
@@ -589,7 +620,7 @@ bool PhoneNumberMatcher::ExtractInnerMatch(const string& candidate, int offset,
         // We should handle any group before this one too.
         string first_group_only = candidate.substr(0, group_start_index);
         phone_util_.TrimUnwantedEndChars(&first_group_only);
-        bool success = ParseAndVerify(first_group_only, offset, match);
+        bool success = ParseAndVerify(first_group_only, offset, span, number);
         if (success) {
           return true;
         }
@@ -597,7 +628,8 @@ bool PhoneNumberMatcher::ExtractInnerMatch(const string& candidate, int offset,
         is_first_match = false;
       }
       phone_util_.TrimUnwantedEndChars(&group);
-      bool success = ParseAndVerify(group, offset + group_start_index, match);
+      bool success = ParseAndVerify(group, offset + group_start_index, span,
+                                    number);
       if (success) {
         return true;
       }
@@ -608,8 +640,8 @@ bool PhoneNumberMatcher::ExtractInnerMatch(const string& candidate, int offset,
 }
 
 bool PhoneNumberMatcher::ExtractMatch(const string& candidate, int offset,
-                                      PhoneNumberMatch* match) {
-  DCHECK(match);
+                                      MatchSpan* span, PhoneNumber* number) {
+  DCHECK(span);
   // Skip a match that is more likely to be a date.
   if (reg_exps_->slash_separated_dates_->PartialMatch(candidate)) {
     return false;
@@ -617,22 +649,21 @@ bool PhoneNumberMatcher::ExtractMatch(const string& candidate, int offset,
 
   // Skip potential time-stamps.
   if (reg_exps_->time_stamps_->PartialMatch(candidate)) {
-    scoped_ptr<RegExpInput> following_text(
-        reg_exps_->regexp_factory_->CreateInput(
-            text_.substr(offset + candidate.size())));
-    if (reg_exps_->time_stamps_suffix_->Consume(following_text.get())) {
+    // Match the suffix in place rather than copying the rest of the text.
+    if (reg_exps_->time_stamps_suffix_->Consume(
+            text_, offset + candidate.size(), true, NULL)) {
       return false;
     }
   }
 
   // Try to come up with a valid match given the entire candidate.
-  if (ParseAndVerify(candidate, offset, match)) {
+  if (ParseAndVerify(candidate, offset, span, number)) {
     return true;
   }
 
   // If that failed, try to find an "inner match" - there might be a phone
   // number within this candidate.
-  return ExtractInnerMatch(candidate, offset, match);
+  return ExtractInnerMatch(candidate, offset, span, number);
 }
 
 bool PhoneNumberMatcher::HasNext() {
@@ -642,13 +673,14 @@ bool PhoneNumberMatcher::HasNext() {
     return false;
   }
   if (state_ == NOT_READY) {
-    PhoneNumberMatch temp_match;
-    if (!Find(search_index_, &temp_match)) {
+    MatchSpan span;
+    PhoneNumber number;
+    if (!Find(search_index_, &span, &number)) {
       state_ = DONE;
     } else {
-      last_match_.reset(new PhoneNumberMatch(temp_match.start(),
-                                             temp_match.raw_string(),
-                                             temp_match.number()));
+      last_match_.reset(new PhoneNumberMatch(
+          span.start, string(text_.substr(span.start, span.length)), number));
+      last_match_region_index_ = span.region_index;
       search_index_ = last_match_->end();
       state_ = READY;
     }
@@ -668,20 +700,70 @@ bool PhoneNumberMatcher::Next(PhoneNumberMatch* match) {
   return true;
 }
 
-bool PhoneNumberMatcher::Find(int index, PhoneNumberMatch* match) {
-  DCHECK(match);
+int PhoneNumberMatcher::AppendRemainingSpans(vector<MatchSpan>* spans) {
+  DCHECK(spans);
+  const size_t initial_size = spans->size();
+  if (!is_input_valid_utf8_) {
+    state_ = DONE;
+    return 0;
+  }
+  if (state_ == READY) {
+    // HasNext() already found the next match.
+    MatchSpan span;
+    span.start = last_match_->start();
+    span.length = last_match_->length();
+    span.country_code = last_match_->number().country_code();
+    span.region_index = last_match_region_index_;
+    spans->push_back(span);
+    last_match_.reset(NULL);
+  }
+  if (state_ != DONE) {
+    MatchSpan span;
+    while (Find(search_index_, &span, NULL)) {
+      spans->push_back(span);
+      search_index_ = span.start + span.length;
+    }
+    state_ = DONE;
+  }
+  return static_cast<int>(spans->size() - initial_size);
+}
+
+bool PhoneNumberMatcher::Next(PhoneNumberMatch* match, string* region_code) {
+  DCHECK(region_code);
+  if (!HasNext()) {
+    return false;
+  }
+  // Numbers written in international format belong to a region of their own
+  // country calling code, which need not be among those tried.
+  phone_util_.GetRegionCodeForNumber(last_match_->number(), region_code);
+  if (*region_code == RegionCode::GetUnknown()) {
+    region_code->assign(preferred_regions_[last_match_region_index_]);
+  }
+  return Next(match);
+}
 
+bool PhoneNumberMatcher::IsBudgetExhausted() const {
+  return budget_ && budget_->IsExhausted();
+}
+
+bool PhoneNumberMatcher::Find(int index, MatchSpan* span,
+                              PhoneNumber* number) {
+  DCHECK(span);
+
+  // The regular expressions evaluated by the search, including those of
+  // PhoneNumberUtil, consume steps of the budget and fail once it is exhausted.
+  const ScopedExecutionBudget scoped_budget(budget_);
   scoped_ptr<RegExpInput> text(
-      reg_exps_->regexp_factory_for_pattern_->CreateInput(text_.substr(index)));
+      reg_exps_->regexp_factory_for_pattern_->CreateInput(string(text_.substr(index))));
   string candidate;
-  while ((max_tries_ > 0) &&
+  while ((max_tries_ > 0) && (!budget_ || budget_->Consume()) &&
          reg_exps_->pattern_->FindAndConsume(text.get(), &candidate)) {
     int start = static_cast<int>(text_.length() - text->ToString().length() - candidate.length());
     // Check for extra numbers at the end.
-    reg_exps_->capture_up_to_second_number_start_pattern_->
-        PartialMatch(candidate, &candidate);
-    if (ExtractMatch(candidate, start, match)) {
-      return true;
+    PhoneNumberUtil::MaybeStripSecondNumber(&candidate);
+    if (ExtractMatch(candidate, start, span, number)) {
+      // A match verified with a failing regular expression can't be trusted.
+      return !IsBudgetExhausted();
     }
 
     index = static_cast<int>(start + candidate.length());
@@ -717,12 +799,10 @@ bool PhoneNumberMatcher::CheckNumberGroupingIsValid(
              alternate_formats->number_format().begin();
          it != alternate_formats->number_format().end(); ++it) {
       if (it->leading_digits_pattern_size() > 0) {
-        std::unique_ptr<RegExpInput> nsn_input(
-            reg_exps_->regexp_factory_->CreateInput(
-                national_significant_number));
         // There is only one leading digits pattern for alternate formats.
         if (!reg_exps_->regexp_cache_.GetRegExp(
-                it->leading_digits_pattern(0)).Consume(nsn_input.get())) {
+                it->leading_digits_pattern(0)).Consume(
+                    national_significant_number, NULL)) {
           // Leading digits don't match; try another one.
           continue;
         }
@@ -25,6 +25,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "phonenumbers/base/basictypes.h"
 #include "phonenumbers/base/memory/scoped_ptr.h"
 #include "phonenumbers/callback.h"
@@ -40,6 +41,7 @@ using std::string;
 using std::vector;
 
 class AlternateFormats;
+class ExecutionBudget;
 class NumberFormat;
 class PhoneNumber;
 class PhoneNumberMatch;
@@ -48,6 +50,7 @@ class PhoneNumberUtil;
 
 class PhoneNumberMatcher {
   friend class PhoneNumberMatcherTest;
+  friend class PhoneNumberRedactor;
  public:
   // Leniency when finding potential phone numbers in text segments. The levels
   // here are ordered in increasing strictness.
@@ -73,6 +76,20 @@ class PhoneNumberMatcher {
     EXACT_GROUPING,
   };
 
+  // Location of a match in the text, with the country calling code of the
+  // number found there.
+  struct MatchSpan {
+    MatchSpan() : start(0), length(0), country_code(0), region_index(0) {}
+
+    // The offsets are in bytes, like those of PhoneNumberMatch.
+    int start;
+    int length;
+    int country_code;
+    // The index of the region the number was parsed with, among those given to
+    // the matcher.
+    int region_index;
+  };
+
   // Constructs a phone number matcher.
   PhoneNumberMatcher(const PhoneNumberUtil& util,
                      const string& text,
@@ -80,6 +97,28 @@ class PhoneNumberMatcher {
                      Leniency leniency,
                      int max_tries);
 
+  // Constructs a phone number matcher which stops searching once budget, which
+  // must outlive it, is exhausted. Every candidate considered and every regular
+  // expression evaluated consumes a step of budget.
+  PhoneNumberMatcher(const PhoneNumberUtil& util,
+                     const string& text,
+                     const string& region_code,
+                     Leniency leniency,
+                     int max_tries,
+                     ExecutionBudget* budget);
+
+  // Constructs a phone number matcher which tries the regions of region_codes
+  // in turn for each candidate, and keeps the first one under which it is
+  // verified according to leniency. This scans the text once, instead of once
+  // per region with a matcher for each of them. Candidates written in
+  // international format are only parsed once, since they don't depend on the
+  // region. region_codes must not be empty.
+  PhoneNumberMatcher(const PhoneNumberUtil& util,
+                     const string& text,
+                     const vector<string>& region_codes,
+                     Leniency leniency,
+                     int max_tries);
+
   // Wrapper to construct a phone number matcher, with no limitation on the
   // number of retries and VALID Leniency.
   PhoneNumberMatcher(const string& text,
@@ -94,6 +133,24 @@ class PhoneNumberMatcher {
   // Gets next match from text sequence.
   bool Next(PhoneNumberMatch* match);
 
+  // Like Next(), and also gets the region the number belongs to. This is the
+  // region it was parsed with, unless it was written in international format,
+  // or belongs to another region sharing its country calling code. The region
+  // it was parsed with is kept if the number belongs to no region, e.g. if it
+  // is only possible.
+  bool Next(PhoneNumberMatch* match, string* region_code);
+
+  // Appends the spans of all the remaining matches to spans, and returns how
+  // many were found. The matches are verified according to the leniency like
+  // those returned by Next(), but neither their raw string nor their number is
+  // kept, which is cheaper when only their location is needed, such as for
+  // redaction or indexing. HasNext() returns false afterwards.
+  int AppendRemainingSpans(vector<MatchSpan>* spans);
+
+  // Returns true if the search stopped because the budget was exhausted, in
+  // which case the rest of the text might contain more matches.
+  bool IsBudgetExhausted() const;
+
  private:
   // The potential states of a PhoneNumberMatcher.
   enum State {
@@ -102,13 +159,27 @@ class PhoneNumberMatcher {
     DONE,
   };
 
+  // Constructs a phone number matcher searching text for numbers of the
+  // regions of region_codes, within budget unless it is NULL. text is searched
+  // in place, and must outlive the matcher, unless copy_text is true. This is
+  // used by PhoneNumberRedactor to search lines without copying them.
+  PhoneNumberMatcher(const PhoneNumberUtil& util,
+                     absl::string_view text,
+                     bool copy_text,
+                     const vector<string>& region_codes,
+                     Leniency leniency,
+                     int max_tries,
+                     ExecutionBudget* budget);
+
   // Checks if the to check if the provided text_ is in UTF-8 or not.
   bool IsInputUtf8();
 
   // Attempts to extract a match from a candidate string. Returns true if a
   // match is found, otherwise returns false. The value "offset" refers to the
-  // start index of the candidate string within the overall text.
-  bool Find(int index, PhoneNumberMatch* match);
+  // start index of the candidate string within the overall text. The number
+  // matched is only stored if number isn't NULL, and this is also the case for
+  // the methods below.
+  bool Find(int index, MatchSpan* span, PhoneNumber* number);
 
   // Checks a number was formatted with a national prefix, if the number was
   // found in national format, and a national prefix is required for that
@@ -118,20 +189,20 @@ class PhoneNumberMatcher {
 
   // Attempts to extract a match from candidate. Returns true if the match was
   // found, otherwise returns false.
-  bool ExtractMatch(const string& candidate, int offset,
-                    PhoneNumberMatch* match);
+  bool ExtractMatch(const string& candidate, int offset, MatchSpan* span,
+                    PhoneNumber* number);
 
   // Attempts to extract a match from a candidate string if the whole candidate
   // does not qualify as a match. Returns true if a match is found, otherwise
   // returns false.
-  bool ExtractInnerMatch(const string& candidate, int offset,
-                         PhoneNumberMatch* match);
+  bool ExtractInnerMatch(const string& candidate, int offset, MatchSpan* span,
+                         PhoneNumber* number);
 
   // Parses a phone number from the candidate using PhoneNumberUtil::Parse() and
   // verifies it matches the requested leniency. If parsing and verification
   // succeed, returns true, otherwise this method returns false;
-  bool ParseAndVerify(const string& candidate, int offset,
-                      PhoneNumberMatch* match);
+  bool ParseAndVerify(const string& candidate, int offset, MatchSpan* span,
+                      PhoneNumber* number);
 
   bool CheckNumberGroupingIsValid(
     const PhoneNumber& phone_number,
@@ -184,12 +255,15 @@ class PhoneNumberMatcher {
   // The phone number utility;
   const PhoneNumberUtil& phone_util_;
 
+  // The copy of the text owned by the matcher, if any.
+  const string text_copy_;
+
   // The text searched for phone numbers;
-  const string text_;
+  const absl::string_view text_;
 
-  // The region(country) to assume for phone numbers without an international
-  // prefix.
-  const string preferred_region_;
+  // The regions(countries) to assume for phone numbers without an
+  // international prefix, in order of preference.
+  const vector<string> preferred_regions_;
 
   // The degree of validation requested.
   Leniency leniency_;
@@ -197,12 +271,18 @@ class PhoneNumberMatcher {
   // The maximum number of retries after matching an invalid number.
   int max_tries_;
 
+  // The budget bounding the search, or NULL if it is unbounded.
+  ExecutionBudget* const budget_;
+
   // The iteration tristate.
   State state_;
 
   // The last successful match, NULL unless in State.READY.
   scoped_ptr<PhoneNumberMatch> last_match_;
 
+  // The index in preferred_regions_ of the region of last_match_.
+  int last_match_region_index_;
+
   // The next index to start searching at. Undefined in State.DONE.
   int search_index_;
 
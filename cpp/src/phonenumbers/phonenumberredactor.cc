@@ -0,0 +1,259 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/phonenumberredactor.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include <unicode/uchar.h>
+
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/encoding_utils.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumbermatch.h"
+#include "phonenumbers/phonenumberutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Lines longer than this are searched in pieces, so that text without line
+// breaks isn't buffered whole.
+const size_t kMaxLineLength = 1 << 16;
+
+// The farthest a piece of a long line is cut before its end, to keep the
+// number it may end with in one piece.
+const size_t kMaxCutBackUp = 256;
+
+// Returns true if the ASCII character c may be part of a phone number found by
+// PhoneNumberMatcher, not counting the letters of extension prefixes.
+bool MayBePartOfNumber(char c) {
+  return (c >= '0' && c <= '9') ||
+         (c != '\0' && strchr(" \t-./()[]~+*#xX", c) != NULL);
+}
+
+// Returns the length of the piece a long line is cut to: up to the last ASCII
+// character which can't be part of a phone number, or before the last UTF-8
+// character otherwise, since it may be incomplete.
+size_t FindCut(absl::string_view line) {
+  const size_t min_cut =
+      line.size() > kMaxCutBackUp ? line.size() - kMaxCutBackUp : 0;
+  for (size_t cut = line.size(); cut > min_cut; --cut) {
+    const char c = line[cut - 1];
+    if (!(c & 0x80) && !MayBePartOfNumber(c)) {
+      return cut;
+    }
+  }
+  size_t cut = line.size() - 1;
+  while (cut > 0 && (line[cut] & 0xC0) == 0x80) {
+    --cut;
+  }
+  return cut > 0 ? cut : line.size();
+}
+
+// Returns the 64-bit FNV-1a hash of the concatenation of s1 and s2.
+uint64 Fnv1aHash(const string& s1, const string& s2) {
+  uint64 hash = 14695981039346656037ULL;
+  for (const string* s : {&s1, &s2}) {
+    for (string::const_iterator it = s->begin(); it != s->end(); ++it) {
+      hash ^= static_cast<unsigned char>(*it);
+      hash *= 1099511628211ULL;
+    }
+  }
+  return hash;
+}
+
+// Adds the time elapsed during its lifetime to busy_time.
+class BusyTimer {
+ public:
+  explicit BusyTimer(Clock::duration* busy_time)
+      : busy_time_(busy_time),
+        start_(Clock::now()) {}
+
+  ~BusyTimer() {
+    *busy_time_ += Clock::now() - start_;
+  }
+
+ private:
+  Clock::duration* const busy_time_;
+  const Clock::time_point start_;
+};
+
+}  // namespace
+
+StringRedactionSink::StringRedactionSink(string* output) : output_(output) {
+  DCHECK(output);
+}
+
+void StringRedactionSink::Append(absl::string_view data) {
+  output_->append(data.data(), data.size());
+}
+
+// static
+MaskPolicy MaskPolicy::MaskAllDigits() {
+  return MaskPolicy();
+}
+
+// static
+MaskPolicy MaskPolicy::KeepLastDigits(int digits_kept) {
+  MaskPolicy policy;
+  policy.type = KEEP_LAST_DIGITS;
+  policy.digits_kept = digits_kept;
+  return policy;
+}
+
+// static
+MaskPolicy MaskPolicy::HashE164(const string& hash_salt) {
+  MaskPolicy policy;
+  policy.type = HASH_E164;
+  policy.hash_salt = hash_salt;
+  return policy;
+}
+
+double RedactionStats::BytesPerSecond() const {
+  const double seconds =
+      std::chrono::duration_cast<std::chrono::duration<double> >(busy_time)
+          .count();
+  return seconds > 0 ? bytes_read / seconds : 0;
+}
+
+PhoneNumberRedactor::PhoneNumberRedactor(const PhoneNumberUtil& util,
+                                         const string& region_code,
+                                         PhoneNumberMatcher::Leniency leniency,
+                                         const MaskPolicy& mask_policy,
+                                         RedactionSink* sink)
+    : phone_util_(util),
+      region_codes_(1, region_code),
+      leniency_(leniency),
+      mask_policy_(mask_policy),
+      sink_(sink) {
+  DCHECK(sink);
+}
+
+void PhoneNumberRedactor::Write(absl::string_view chunk) {
+  const BusyTimer timer(&stats_.busy_time);
+  stats_.bytes_read += chunk.size();
+  // The lines of chunk are searched in place, except for the one started by
+  // earlier chunks, which is completed in pending_line_.
+  size_t line_break;
+  while ((line_break = chunk.find('\n')) != absl::string_view::npos) {
+    const absl::string_view line = chunk.substr(0, line_break + 1);
+    chunk.remove_prefix(line_break + 1);
+    if (pending_line_.empty()) {
+      RedactLine(line);
+    } else {
+      pending_line_.append(line.data(), line.size());
+      RedactLine(pending_line_);
+      pending_line_.clear();
+    }
+  }
+  pending_line_.append(chunk.data(), chunk.size());
+  if (pending_line_.size() >= kMaxLineLength) {
+    const size_t cut = FindCut(pending_line_);
+    RedactLine(absl::string_view(pending_line_).substr(0, cut));
+    pending_line_.erase(0, cut);
+  }
+}
+
+void PhoneNumberRedactor::Finish() {
+  const BusyTimer timer(&stats_.busy_time);
+  if (!pending_line_.empty()) {
+    RedactLine(pending_line_);
+    pending_line_.clear();
+  }
+}
+
+void PhoneNumberRedactor::RedactLine(absl::string_view line) {
+  PhoneNumberMatcher matcher(phone_util_, line, false, region_codes_,
+                             leniency_, std::numeric_limits<int>::max(), NULL);
+  PhoneNumberMatch match;
+  size_t position = 0;
+  while (matcher.Next(&match)) {
+    WriteToSink(line.substr(position, match.start() - position));
+    WriteMask(match);
+    ++stats_.numbers_redacted;
+    position = match.end();
+  }
+  WriteToSink(line.substr(position));
+}
+
+void PhoneNumberRedactor::WriteMask(const PhoneNumberMatch& match) {
+  mask_.clear();
+  if (mask_policy_.type == MaskPolicy::HASH_E164) {
+    string e164;
+    phone_util_.Format(match.number(), PhoneNumberUtil::E164, &e164);
+    uint64 hash = Fnv1aHash(mask_policy_.hash_salt, e164);
+    mask_.assign(17, '#');
+    for (int i = 16; i > 0; --i) {
+      mask_[i] = "0123456789abcdef"[hash & 0xF];
+      hash >>= 4;
+    }
+    WriteToSink(mask_);
+    return;
+  }
+
+  const string& raw_string = match.raw_string();
+  int digits_to_mask = 0;
+  const char* const end = raw_string.data() + raw_string.size();
+  for (const char* it = raw_string.data(); it < end;
+       it = EncodingUtils::AdvanceOneUTF8Character(it)) {
+    char32 c;
+    EncodingUtils::DecodeUTF8Char(it, &c);
+    if (u_isdigit(c)) {
+      ++digits_to_mask;
+    }
+  }
+  if (mask_policy_.type == MaskPolicy::KEEP_LAST_DIGITS) {
+    digits_to_mask -= mask_policy_.digits_kept;
+  }
+  for (const char* it = raw_string.data(); it < end;) {
+    const char* const next = EncodingUtils::AdvanceOneUTF8Character(it);
+    char32 c;
+    EncodingUtils::DecodeUTF8Char(it, &c);
+    if (digits_to_mask > 0 && u_isdigit(c)) {
+      mask_.push_back(mask_policy_.mask_char);
+      --digits_to_mask;
+    } else {
+      mask_.append(it, next - it);
+    }
+    it = next;
+  }
+  WriteToSink(mask_);
+}
+
+void PhoneNumberRedactor::WriteToSink(absl::string_view data) {
+  if (!data.empty()) {
+    stats_.bytes_written += data.size();
+    sink_->Append(data);
+  }
+}
+
+void RedactPhoneNumbers(const string& text,
+                        const string& region_code,
+                        PhoneNumberMatcher::Leniency leniency,
+                        const MaskPolicy& mask_policy,
+                        RedactionSink* sink) {
+  PhoneNumberRedactor redactor(*PhoneNumberUtil::GetInstance(), region_code,
+                               leniency, mask_policy, sink);
+  redactor.Write(text);
+  redactor.Finish();
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
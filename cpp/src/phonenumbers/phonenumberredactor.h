@@ -0,0 +1,186 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replaces the phone numbers found in text by PhoneNumberMatcher with masks,
+// writing the result to a sink as the text is searched rather than collecting
+// the matches first.
+//
+// string redacted;
+// StringRedactionSink sink(&redacted);
+// RedactPhoneNumbers("Call 650-253-0000.", "US", PhoneNumberMatcher::VALID,
+//                    MaskPolicy::KeepLastDigits(4), &sink);
+// // redacted is "Call ***-***-0000."
+//
+// Text arriving in chunks is redacted with a PhoneNumberRedactor instead, which
+// searches each complete line as soon as it has been written.
+
+#ifndef I18N_PHONENUMBERS_PHONENUMBERREDACTOR_H_
+#define I18N_PHONENUMBERS_PHONENUMBERREDACTOR_H_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/phonenumbermatcher.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+class PhoneNumberMatch;
+class PhoneNumberUtil;
+
+// Receives the redacted text.
+class RedactionSink {
+ public:
+  virtual ~RedactionSink() {}
+
+  virtual void Append(absl::string_view data) = 0;
+};
+
+// Appends the redacted text to a string.
+class StringRedactionSink : public RedactionSink {
+ public:
+  // output must outlive this sink.
+  explicit StringRedactionSink(string* output);
+
+  void Append(absl::string_view data);
+
+ private:
+  string* const output_;
+};
+
+// What a phone number found in the text is replaced with.
+struct MaskPolicy {
+  enum Type {
+    // Every digit of the number is replaced by the mask character, and its
+    // punctuation is kept.
+    MASK_ALL_DIGITS,
+    // Like MASK_ALL_DIGITS, except for the last digits_kept digits.
+    KEEP_LAST_DIGITS,
+    // The number is replaced by '#' and 16 hexadecimal digits of a 64-bit
+    // FNV-1a hash of hash_salt followed by the number in E164 format, so that
+    // the occurrences of a number can still be related to each other. Note
+    // that numbers are easily recovered from such hashes by enumeration unless
+    // the salt is kept secret.
+    HASH_E164,
+  };
+
+  MaskPolicy() : type(MASK_ALL_DIGITS), digits_kept(0), mask_char('*') {}
+
+  static MaskPolicy MaskAllDigits();
+  static MaskPolicy KeepLastDigits(int digits_kept);
+  static MaskPolicy HashE164(const string& hash_salt);
+
+  Type type;
+  int digits_kept;
+  char mask_char;
+  string hash_salt;
+};
+
+// Counters of the work done by a PhoneNumberRedactor.
+struct RedactionStats {
+  RedactionStats()
+      : bytes_read(0),
+        bytes_written(0),
+        numbers_redacted(0),
+        busy_time(std::chrono::steady_clock::duration::zero()) {}
+
+  // Returns the number of bytes read per second spent redacting, or 0 if no
+  // time was spent yet.
+  double BytesPerSecond() const;
+
+  int64 bytes_read;
+  int64 bytes_written;
+  int64 numbers_redacted;
+  // The time spent in Write() and Finish().
+  std::chrono::steady_clock::duration busy_time;
+};
+
+// Redacts the phone numbers of text arriving in chunks. Each line is searched
+// on its own, in place in the chunk where possible, which finds the same
+// numbers as searching the whole text since phone numbers don't span lines, so
+// that only the line being written is buffered. A line which isn't valid UTF-8
+// is copied unchanged, like PhoneNumberMatcher finds nothing in such text, but
+// doesn't affect the other lines. Lines longer than 64 KiB are searched in
+// pieces, cut before the digits and punctuation they end with, so that a number
+// is only split if more than 256 bytes of them precede the cut. An extension
+// may be cut off its number though.
+//
+// This class isn't thread-safe.
+class PhoneNumberRedactor {
+ public:
+  // sink must outlive the redactor. The numbers are searched with no limit on
+  // the number of tries.
+  PhoneNumberRedactor(const PhoneNumberUtil& util,
+                      const string& region_code,
+                      PhoneNumberMatcher::Leniency leniency,
+                      const MaskPolicy& mask_policy,
+                      RedactionSink* sink);
+
+  // This type is neither copyable nor movable.
+  PhoneNumberRedactor(const PhoneNumberRedactor&) = delete;
+  PhoneNumberRedactor& operator=(const PhoneNumberRedactor&) = delete;
+
+  // Redacts the lines completed by chunk, and buffers the rest of it.
+  void Write(absl::string_view chunk);
+
+  // Redacts the text buffered since the last line break. The redactor can be
+  // reused for another text afterwards.
+  void Finish();
+
+  const RedactionStats& stats() const {
+    return stats_;
+  }
+
+ private:
+  // Searches line, or a piece of a long one, and writes it redacted to the
+  // sink.
+  void RedactLine(absl::string_view line);
+
+  // Writes the mask of match to the sink.
+  void WriteMask(const PhoneNumberMatch& match);
+
+  void WriteToSink(absl::string_view data);
+
+  const PhoneNumberUtil& phone_util_;
+  // The region of the numbers, as the matchers take it.
+  const vector<string> region_codes_;
+  const PhoneNumberMatcher::Leniency leniency_;
+  const MaskPolicy mask_policy_;
+  RedactionSink* const sink_;
+
+  // The text written since the last line break, or since the last cut of a
+  // long line.
+  string pending_line_;
+  // Scratch space for the masks, reused across matches.
+  string mask_;
+  RedactionStats stats_;
+};
+
+// Redacts the phone numbers of text with the shared PhoneNumberUtil instance.
+void RedactPhoneNumbers(const string& text,
+                        const string& region_code,
+                        PhoneNumberMatcher::Leniency leniency,
+                        const MaskPolicy& mask_policy,
+                        RedactionSink* sink);
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_PHONENUMBERREDACTOR_H_
@@ -0,0 +1,270 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/phonenumbers_c.h"
+
+#include <string.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/executor.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+#include "phonenumbers/phonenumbermatch.h"
+#include "phonenumbers/phonenumbermatcher.h"
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+
+using i18n::phonenumbers::int64;
+using i18n::phonenumbers::ParallelFor;
+using i18n::phonenumbers::PhoneNumber;
+using i18n::phonenumbers::PhoneNumberUtil;
+using i18n::phonenumbers::WorkStealingExecutor;
+using std::string;
+using std::vector;
+
+struct pn_util {
+  explicit pn_util(const PhoneNumberUtil& util) : phone_util(util) {}
+
+  const PhoneNumberUtil& phone_util;
+  // NULL unless the batch functions use several threads.
+  scoped_ptr<WorkStealingExecutor> executor;
+};
+
+namespace {
+
+// About the cost of each operation on a number, in nanoseconds.
+const int64 kParseCostNs = 2000;
+const int64 kFormatCostNs = 500;
+const int64 kValidateCostNs = 1000;
+
+// The enums of the C interface have the values of their C++ counterparts.
+static_assert(static_cast<int>(PN_DEADLINE_EXCEEDED) ==
+                  PhoneNumberUtil::DEADLINE_EXCEEDED,
+              "pn_parse_error doesn't match PhoneNumberUtil::ErrorType");
+static_assert(static_cast<int>(PN_FORMAT_RFC3966) == PhoneNumberUtil::RFC3966,
+              "pn_format doesn't match PhoneNumberUtil::PhoneNumberFormat");
+static_assert(static_cast<int>(PN_TYPE_UNKNOWN) == PhoneNumberUtil::UNKNOWN,
+              "pn_number_type doesn't match PhoneNumberUtil::PhoneNumberType");
+
+void ToCNumber(const PhoneNumber& number, pn_number* c_number) {
+  memset(c_number, 0, sizeof(*c_number));
+  c_number->country_code = number.country_code();
+  c_number->national_number = number.national_number();
+  if (number.italian_leading_zero()) {
+    c_number->leading_zeros = number.number_of_leading_zeros();
+  }
+  // The parser doesn't accept longer extensions, but the C++ API lets them be
+  // set.
+  strncpy(c_number->extension, number.extension().c_str(),
+          PN_MAX_EXTENSION_LENGTH);
+}
+
+void FromCNumber(const pn_number& c_number, PhoneNumber* number) {
+  number->Clear();
+  number->set_country_code(c_number.country_code);
+  number->set_national_number(c_number.national_number);
+  if (c_number.leading_zeros > 0) {
+    number->set_italian_leading_zero(true);
+    // Like the parser, the default of 1 isn't set explicitly.
+    if (c_number.leading_zeros > 1) {
+      number->set_number_of_leading_zeros(c_number.leading_zeros);
+    }
+  }
+  const size_t extension_length =
+      strnlen(c_number.extension, sizeof(c_number.extension));
+  if (extension_length > 0) {
+    number->set_extension(c_number.extension, extension_length);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+pn_util* pn_util_create(void) {
+  return new pn_util(*PhoneNumberUtil::GetInstance());
+}
+
+void pn_util_destroy(pn_util* util) {
+  delete util;
+}
+
+pn_status pn_util_set_num_threads(pn_util* util, int num_threads) {
+  if (!util || num_threads < 0) {
+    return PN_INVALID_ARGUMENT;
+  }
+  util->executor.reset(
+      num_threads == 1 ? NULL : new WorkStealingExecutor(num_threads));
+  return PN_OK;
+}
+
+pn_status pn_parse_batch(const pn_util* util,
+                         const char* data,
+                         const int32_t* offsets,
+                         size_t count,
+                         const char* default_region,
+                         pn_number* numbers,
+                         int32_t* errors) {
+  if (count == 0) {
+    return PN_OK;
+  }
+  if (!util || !data || !offsets || !default_region || !numbers || !errors) {
+    return PN_INVALID_ARGUMENT;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (offsets[i + 1] < offsets[i]) {
+      return PN_INVALID_ARGUMENT;
+    }
+  }
+  const string region(default_region);
+  ParallelFor(util->executor.get(), count, kParseCostNs,
+              [&](int64 begin, int64 end) {
+    // Reused across numbers, since Parse() takes strings.
+    string number_text;
+    PhoneNumber number;
+    for (int64 i = begin; i < end; ++i) {
+      number_text.assign(data + offsets[i], offsets[i + 1] - offsets[i]);
+      errors[i] = util->phone_util.Parse(number_text, region, &number);
+      if (errors[i] == PN_NO_PARSING_ERROR) {
+        ToCNumber(number, &numbers[i]);
+      } else {
+        memset(&numbers[i], 0, sizeof(numbers[i]));
+      }
+    }
+  });
+  return PN_OK;
+}
+
+pn_status pn_format_batch(const pn_util* util,
+                          const pn_number* numbers,
+                          size_t count,
+                          pn_format format,
+                          char* out_data,
+                          size_t out_capacity,
+                          int32_t* out_offsets,
+                          size_t* out_size) {
+  if (!util || (count > 0 && !numbers) || (out_capacity > 0 && !out_data) ||
+      !out_offsets || !out_size || format < PN_FORMAT_E164 ||
+      format > PN_FORMAT_RFC3966) {
+    return PN_INVALID_ARGUMENT;
+  }
+  // The numbers are formatted in parallel, each into its own string, and
+  // then copied to out_data in order.
+  vector<string> formatted(count);
+  ParallelFor(util->executor.get(), count, kFormatCostNs,
+              [&](int64 begin, int64 end) {
+    PhoneNumber number;
+    for (int64 i = begin; i < end; ++i) {
+      FromCNumber(numbers[i], &number);
+      util->phone_util.Format(
+          number, static_cast<PhoneNumberUtil::PhoneNumberFormat>(format),
+          &formatted[i]);
+    }
+  });
+  size_t size = 0;
+  out_offsets[0] = 0;
+  for (size_t i = 0; i < count; ++i) {
+    // Once the buffer is too small, the rest of the numbers are only measured.
+    if (size + formatted[i].size() <= out_capacity) {
+      memcpy(out_data + size, formatted[i].data(), formatted[i].size());
+    }
+    size += formatted[i].size();
+    if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      return PN_INVALID_ARGUMENT;
+    }
+    out_offsets[i + 1] = static_cast<int32_t>(size);
+  }
+  *out_size = size;
+  return size <= out_capacity ? PN_OK : PN_BUFFER_TOO_SMALL;
+}
+
+pn_status pn_validate_batch(const pn_util* util,
+                            const pn_number* numbers,
+                            size_t count,
+                            uint8_t* valid,
+                            int8_t* types) {
+  if (count == 0) {
+    return PN_OK;
+  }
+  if (!util || !numbers || !valid) {
+    return PN_INVALID_ARGUMENT;
+  }
+  ParallelFor(util->executor.get(), count, kValidateCostNs,
+              [&](int64 begin, int64 end) {
+    PhoneNumber number;
+    for (int64 i = begin; i < end; ++i) {
+      FromCNumber(numbers[i], &number);
+      if (types) {
+        // GetNumberType() returns UNKNOWN for invalid numbers, which saves
+        // validating the other ones twice.
+        const PhoneNumberUtil::PhoneNumberType type =
+            util->phone_util.GetNumberType(number);
+        types[i] = static_cast<int8_t>(type);
+        valid[i] = type != PhoneNumberUtil::UNKNOWN;
+      } else {
+        valid[i] = util->phone_util.IsValidNumber(number);
+      }
+    }
+  });
+  return PN_OK;
+}
+
+pn_status pn_match_text(const pn_util* util,
+                        const char* text,
+                        size_t text_length,
+                        const char* region,
+                        pn_leniency leniency,
+                        pn_match* matches,
+                        size_t max_matches,
+                        size_t* num_matches) {
+  if (!util || (text_length > 0 && !text) || !region ||
+      (max_matches > 0 && !matches) || !num_matches ||
+      leniency < PN_LENIENCY_POSSIBLE ||
+      leniency > PN_LENIENCY_EXACT_GROUPING) {
+    return PN_INVALID_ARGUMENT;
+  }
+  *num_matches = 0;
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+  using i18n::phonenumbers::PhoneNumberMatch;
+  using i18n::phonenumbers::PhoneNumberMatcher;
+  PhoneNumberMatcher matcher(
+      util->phone_util, text_length > 0 ? string(text, text_length) : string(),
+      region,
+      static_cast<PhoneNumberMatcher::Leniency>(leniency),
+      std::numeric_limits<int>::max());
+  PhoneNumberMatch match;
+  size_t found = 0;
+  while (matcher.Next(&match)) {
+    if (found < max_matches) {
+      pn_match* const c_match = &matches[found];
+      c_match->start = match.start();
+      c_match->length = match.length();
+      ToCNumber(match.number(), &c_match->number);
+    }
+    ++found;
+  }
+  *num_matches = found;
+  return found <= max_matches ? PN_OK : PN_BUFFER_TOO_SMALL;
+#else
+  return PN_UNSUPPORTED;
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+}
+
+}  // extern "C"
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 The Libphonenumber Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * C interface to the library, for bindings from other languages through their
+ * foreign function interfaces. Each call processes a batch of numbers, so that
+ * the cost of crossing the language boundary is paid once per batch rather
+ * than once per number, and writes its results into buffers owned by the
+ * caller, so that no memory crosses the boundary.
+ *
+ * Batches of strings are laid out like the string arrays of Apache Arrow: the
+ * strings are concatenated in a data buffer, string i spanning
+ * [offsets[i], offsets[i + 1]) of it.
+ *
+ *   pn_util* util = pn_util_create();
+ *   const char data[] = "+41 44 668 1800044 668 1800";
+ *   const int32_t offsets[] = {0, 15, 27};
+ *   pn_number numbers[2];
+ *   int32_t errors[2];
+ *   pn_parse_batch(util, data, offsets, 2, "CH", numbers, errors);
+ *   pn_util_destroy(util);
+ *
+ * The functions return PN_OK, or a negative pn_status if the call failed as a
+ * whole. They are thread-safe, and a pn_util may be shared by threads.
+ *
+ * This interface is stable: the existing declarations and the layout of the
+ * structs won't change, so that bindings keep working with later versions of
+ * the library.
+ */
+
+#ifndef I18N_PHONENUMBERS_PHONENUMBERS_C_H_
+#define I18N_PHONENUMBERS_PHONENUMBERS_C_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The library, created by pn_util_create(). */
+typedef struct pn_util pn_util;
+
+typedef enum {
+  PN_OK = 0,
+  /* A required pointer is NULL, or an enum value is out of range. */
+  PN_INVALID_ARGUMENT = -1,
+  /* The output buffer is too small. The required size is returned. */
+  PN_BUFFER_TOO_SMALL = -2,
+  /* The library was built without the feature, e.g. without ICU for
+   * pn_match_text(). */
+  PN_UNSUPPORTED = -3
+} pn_status;
+
+/* The result of parsing each number, the values of
+ * PhoneNumberUtil::ErrorType. */
+typedef enum {
+  PN_NO_PARSING_ERROR = 0,
+  PN_INVALID_COUNTRY_CODE_ERROR = 1,
+  PN_NOT_A_NUMBER = 2,
+  PN_TOO_SHORT_AFTER_IDD = 3,
+  PN_TOO_SHORT_NSN = 4,
+  PN_TOO_LONG_NSN = 5,
+  PN_DEADLINE_EXCEEDED = 6
+} pn_parse_error;
+
+/* The values of PhoneNumberUtil::PhoneNumberFormat. */
+typedef enum {
+  PN_FORMAT_E164 = 0,
+  PN_FORMAT_INTERNATIONAL = 1,
+  PN_FORMAT_NATIONAL = 2,
+  PN_FORMAT_RFC3966 = 3
+} pn_format;
+
+/* The values of PhoneNumberUtil::PhoneNumberType. */
+typedef enum {
+  PN_TYPE_FIXED_LINE = 0,
+  PN_TYPE_MOBILE = 1,
+  PN_TYPE_FIXED_LINE_OR_MOBILE = 2,
+  PN_TYPE_TOLL_FREE = 3,
+  PN_TYPE_PREMIUM_RATE = 4,
+  PN_TYPE_SHARED_COST = 5,
+  PN_TYPE_VOIP = 6,
+  PN_TYPE_PERSONAL_NUMBER = 7,
+  PN_TYPE_PAGER = 8,
+  PN_TYPE_UAN = 9,
+  PN_TYPE_VOICEMAIL = 10,
+  PN_TYPE_UNKNOWN = 11
+} pn_number_type;
+
+/* The values of PhoneNumberMatcher::Leniency. */
+typedef enum {
+  PN_LENIENCY_POSSIBLE = 0,
+  PN_LENIENCY_VALID = 1,
+  PN_LENIENCY_STRICT_GROUPING = 2,
+  PN_LENIENCY_EXACT_GROUPING = 3
+} pn_leniency;
+
+/* The longest extension the parser accepts. */
+#define PN_MAX_EXTENSION_LENGTH 20
+
+/* A phone number, the fields of the PhoneNumber message which identify it. */
+typedef struct {
+  int32_t country_code;
+  /* The number of zeros the national significant number starts with, which
+   * aren't part of national_number, e.g. 1 for the Italian fixed-line
+   * numbers. */
+  int32_t leading_zeros;
+  uint64_t national_number;
+  /* NUL-terminated, and empty if the number has no extension. */
+  char extension[PN_MAX_EXTENSION_LENGTH + 4];
+} pn_number;
+
+/* A phone number found in a text by pn_match_text(). */
+typedef struct {
+  /* The byte offset of the number in the text, and its length in bytes. */
+  int32_t start;
+  int32_t length;
+  pn_number number;
+} pn_match;
+
+/* Returns a new handle to the library, to be released with pn_util_destroy().
+ * The metadata is loaded by the first call. */
+pn_util* pn_util_create(void);
+
+void pn_util_destroy(pn_util* util);
+
+/* Makes the batch functions process their numbers on num_threads threads owned
+ * by util, or on one per hardware thread if num_threads is 0. With 1, the
+ * default, they run on the calling thread alone. The results are the same.
+ * This must not be called while util is used by other calls. */
+pn_status pn_util_set_num_threads(pn_util* util, int num_threads);
+
+/* Parses the count strings of data and offsets, as PhoneNumberUtil::Parse()
+ * does with default_region, a NUL-terminated region code such as "CH" or "ZZ".
+ * numbers[i] receives the number parsed from string i, and errors[i] the result
+ * of parsing it as a pn_parse_error. The numbers which failed to parse are
+ * zeroed. */
+pn_status pn_parse_batch(const pn_util* util,
+                         const char* data,
+                         const int32_t* offsets,
+                         size_t count,
+                         const char* default_region,
+                         pn_number* numbers,
+                         int32_t* errors);
+
+/* Formats the count numbers in format. The formatted numbers are written to
+ * out_data, which has room for out_capacity bytes, number i spanning
+ * [out_offsets[i], out_offsets[i + 1]), and out_offsets has room for
+ * count + 1 offsets. The total size of the formatted numbers is written to
+ * out_size. If it exceeds out_capacity, PN_BUFFER_TOO_SMALL is returned and
+ * the call can be repeated with a buffer of out_size bytes. */
+pn_status pn_format_batch(const pn_util* util,
+                          const pn_number* numbers,
+                          size_t count,
+                          pn_format format,
+                          char* out_data,
+                          size_t out_capacity,
+                          int32_t* out_offsets,
+                          size_t* out_size);
+
+/* Writes 1 to valid[i] if numbers[i] is a valid number, and 0 otherwise. If
+ * types isn't NULL, types[i] receives the pn_number_type of numbers[i]. */
+pn_status pn_validate_batch(const pn_util* util,
+                            const pn_number* numbers,
+                            size_t count,
+                            uint8_t* valid,
+                            int8_t* types);
+
+/* Finds the phone numbers of the UTF-8 text of text_length bytes, as
+ * PhoneNumberMatcher does with region and leniency, and writes the first
+ * max_matches of them to matches. The number of numbers found is written to
+ * num_matches. If it exceeds max_matches, PN_BUFFER_TOO_SMALL is returned along
+ * with the first max_matches numbers. */
+pn_status pn_match_text(const pn_util* util,
+                        const char* text,
+                        size_t text_length,
+                        const char* region,
+                        pn_leniency leniency,
+                        pn_match* matches,
+                        size_t max_matches,
+                        size_t* num_matches);
+
+#ifdef __cplusplus
+}  /* extern "C" */
+#endif
+
+#endif  /* I18N_PHONENUMBERS_PHONENUMBERS_C_H_ */
@@ -31,9 +31,14 @@
 #include "phonenumbers/base/memory/singleton.h"
 #include "phonenumbers/default_logger.h"
 #include "phonenumbers/encoding_utils.h"
+#include "phonenumbers/execution_budget.h"
+#include "phonenumbers/executor.h"
+#include "phonenumbers/hot_metadata.h"
+#include "phonenumbers/international_prefix_matcher.h"
 #include "phonenumbers/matcher_api.h"
 #include "phonenumbers/metadata.h"
 #include "phonenumbers/normalize_utf8.h"
+#include "phonenumbers/pattern_pool.h"
 #include "phonenumbers/phonemetadata.pb.h"
 #include "phonenumbers/phonenumber.h"
 #include "phonenumbers/phonenumber.pb.h"
@@ -42,10 +47,13 @@
 #include "phonenumbers/regexp_cache.h"
 #include "phonenumbers/regexp_factory.h"
 #include "phonenumbers/region_code.h"
+#include "phonenumbers/rfc3966_tokenizer.h"
 #include "phonenumbers/stl_util.h"
 #include "phonenumbers/stringutil.h"
 #include "phonenumbers/utf/unicodetext.h"
+#include "phonenumbers/utf/unilib.h"
 #include "phonenumbers/utf/utf.h"
+#include "absl/strings/ascii.h"
 
 namespace i18n {
 namespace phonenumbers {
@@ -121,6 +129,60 @@ const char kPossibleCharsAfterExtLabel[] =
     "[:\\.\xEF\xBC\x8E]?[ \xC2\xA0\\t,-]*";
 const char kOptionalExtSuffix[] = "#?";
 
+// Returns the length of the UTF-8 line terminator at position of text, or 0 if
+// there is none. These are the characters that "." doesn't match in the regular
+// expressions: \n, \v, \f, \r, U+0085, U+2028 and U+2029.
+size_t LineTerminatorLength(const string& text, size_t position) {
+  const char c = text[position];
+  if (c >= '\n' && c <= '\r') {
+    return 1;
+  }
+  if (c == '\xC2' && text.compare(position, 2, "\xC2\x85") == 0) {
+    return 2;
+  }
+  if (c == '\xE2' && (text.compare(position, 3, "\xE2\x80\xA8") == 0 ||
+                      text.compare(position, 3, "\xE2\x80\xA9") == 0)) {
+    return 3;
+  }
+  return 0;
+}
+
+// Returns the length of the UTF-8 character at position of text if it matches
+// [a-z] case-insensitively, or 0 otherwise. Besides the ASCII letters, these
+// are U+017F and U+212A, which fold to "s" and "k".
+size_t AlphaPhoneLetterLength(const string& text, size_t position) {
+  const char c = text[position];
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+    return 1;
+  }
+  if (c == '\xC5' && text.compare(position, 2, "\xC5\xBF") == 0) {
+    return 2;
+  }
+  if (c == '\xE2' && text.compare(position, 3, "\xE2\x84\xAA") == 0) {
+    return 3;
+  }
+  return 0;
+}
+
+// Returns the end of the characters from begin to end once those matching
+// unwanted_end_char_pattern are trimmed from the end.
+UnicodeText::const_iterator FindEndOfWantedChars(
+    const RegExp& unwanted_end_char_pattern,
+    const UnicodeText::const_iterator& begin,
+    const UnicodeText::const_iterator& end) {
+  char current_char[5];
+  int len;
+  UnicodeText::const_reverse_iterator reverse_it(end);
+  for (; reverse_it.base() != begin; ++reverse_it) {
+    len = reverse_it.get_utf8(current_char);
+    current_char[len] = '\0';
+    if (!unwanted_end_char_pattern.FullMatch(current_char)) {
+      break;
+    }
+  }
+  return reverse_it.base();
+}
+
 bool LoadCompiledInMetadata(PhoneMetadataCollection* metadata) {
   if (!metadata->ParseFromArray(metadata_get(), metadata_size())) {
     LOG(ERROR) << "Could not parse binary data.";
@@ -321,12 +383,21 @@ std::string CreateExtnPattern(bool for_parsing) {
 // remove_non_matches - indicates whether characters that are not able to be
 //   replaced should be stripped from the number. If this is false, they will be
 //   left unchanged in the number.
+// utf8_validated - indicates whether the number is already known to be
+//   interchange-valid UTF-8, in which case it isn't validated again.
 void NormalizeHelper(const std::map<char32, char>& normalization_replacements,
                      bool remove_non_matches,
+                     bool utf8_validated,
                      string* number) {
   DCHECK(number);
   UnicodeText number_as_unicode;
-  number_as_unicode.PointToUTF8(number->data(), static_cast<int>(number->size()));
+  if (utf8_validated) {
+    number_as_unicode.PointToValidUTF8(number->data(),
+                                       static_cast<int>(number->size()));
+  } else {
+    number_as_unicode.PointToUTF8(number->data(),
+                                  static_cast<int>(number->size()));
+  }
   if (!number_as_unicode.UTF8WasValid()) {
     // The input wasn't valid UTF-8. Produce an empty string to indicate an error.
     number->clear();
@@ -351,6 +422,63 @@ void NormalizeHelper(const std::map<char32, char>& normalization_replacements,
   number->assign(normalized_number);
 }
 
+void NormalizeHelper(const std::map<char32, char>& normalization_replacements,
+                     bool remove_non_matches,
+                     string* number) {
+  NormalizeHelper(normalization_replacements, remove_non_matches,
+                  false /* utf8 not validated */, number);
+}
+
+// Returns true if first and second are equal once NormalizeHelper() removed the
+// characters without replacement from them, without building the normalized
+// strings.
+bool EqualAfterNormalization(
+    const std::map<char32, char>& normalization_replacements,
+    const string& first,
+    const string& second) {
+  UnicodeText first_as_unicode;
+  first_as_unicode.PointToUTF8(first.data(), static_cast<int>(first.size()));
+  UnicodeText second_as_unicode;
+  second_as_unicode.PointToUTF8(second.data(), static_cast<int>(second.size()));
+  if (!first_as_unicode.UTF8WasValid() || !second_as_unicode.UTF8WasValid()) {
+    string normalized_first(first);
+    NormalizeHelper(normalization_replacements, true, &normalized_first);
+    string normalized_second(second);
+    NormalizeHelper(normalization_replacements, true, &normalized_second);
+    return normalized_first == normalized_second;
+  }
+  UnicodeText::const_iterator first_it = first_as_unicode.begin();
+  UnicodeText::const_iterator second_it = second_as_unicode.begin();
+  while (true) {
+    std::map<char32, char>::const_iterator first_glyph_pair =
+        normalization_replacements.end();
+    for (; first_it != first_as_unicode.end(); ++first_it) {
+      first_glyph_pair = normalization_replacements.find(*first_it);
+      if (first_glyph_pair != normalization_replacements.end()) {
+        break;
+      }
+    }
+    std::map<char32, char>::const_iterator second_glyph_pair =
+        normalization_replacements.end();
+    for (; second_it != second_as_unicode.end(); ++second_it) {
+      second_glyph_pair = normalization_replacements.find(*second_it);
+      if (second_glyph_pair != normalization_replacements.end()) {
+        break;
+      }
+    }
+    if (first_it == first_as_unicode.end() ||
+        second_it == second_as_unicode.end()) {
+      return first_it == first_as_unicode.end() &&
+          second_it == second_as_unicode.end();
+    }
+    if (first_glyph_pair->second != second_glyph_pair->second) {
+      return false;
+    }
+    ++first_it;
+    ++second_it;
+  }
+}
+
 // Returns true if there is any possible number data set for a particular
 // PhoneNumberDesc.
 bool DescHasPossibleNumberData(const PhoneNumberDesc& desc) {
@@ -398,7 +526,9 @@ void GetSupportedTypesForMetadata(
 }
 
 // Helper method to check a number against possible lengths for this number
-// type, and determine whether it matches, or is too short or too long.
+// type, and determine whether it matches, or is too short or too long. This
+// reads the metadata as it was before HotMetadata precomputed the lengths, and
+// is only used when the fast paths are disabled.
 PhoneNumberUtil::ValidationResult TestNumberLength(
     const string& number, const PhoneMetadata& metadata,
     PhoneNumberUtil::PhoneNumberType type) {
@@ -475,14 +605,6 @@ PhoneNumberUtil::ValidationResult TestNumberLength(
              : PhoneNumberUtil::INVALID_LENGTH;
 }
 
-// Helper method to check a number against possible lengths for this region,
-// based on the metadata being passed in, and determine whether it matches, or
-// is too short or too long.
-PhoneNumberUtil::ValidationResult TestNumberLength(
-    const string& number, const PhoneMetadata& metadata) {
-  return TestNumberLength(number, metadata, PhoneNumberUtil::UNKNOWN);
-}
-
 // Returns a new phone number containing only the fields needed to uniquely
 // identify a phone number, rather than any fields that capture the context in
 // which the phone number was created.
@@ -509,6 +631,13 @@ bool IsMatch(const MatcherApi& matcher_api,
   return matcher_api.MatchNationalNumber(number, desc, false);
 }
 
+// Returns true if format[position] starts a reference to a captured group of a
+// formatting pattern, such as "$1".
+bool IsGroupReference(const string& format, size_t position) {
+  return format[position] == '$' && position + 1 < format.length() &&
+      format[position + 1] >= '1' && format[position + 1] <= '9';
+}
+
 }  // namespace
 
 void PhoneNumberUtil::SetLogger(Logger* logger) {
@@ -716,7 +845,6 @@ class PhoneNumberRegExpsAndMappings {
   scoped_ptr<const RegExp> single_international_prefix_;
 
   scoped_ptr<const RegExp> digits_pattern_;
-  scoped_ptr<const RegExp> capturing_digit_pattern_;
   scoped_ptr<const RegExp> capturing_ascii_digits_pattern_;
 
   // Regular expression of acceptable characters that may start a phone number
@@ -730,10 +858,6 @@ class PhoneNumberRegExpsAndMappings {
   // This corresponds to VALID_START_CHAR in the java version.
   scoped_ptr<const RegExp> valid_start_char_pattern_;
 
-  // Regular expression of valid characters before a marker that might indicate
-  // a second number.
-  scoped_ptr<const RegExp> capture_up_to_second_number_start_pattern_;
-
   // Regular expression of trailing characters that we want to remove. We remove
   // all characters that are not alpha or numerical characters. The hash
   // character is retained here, as it may signify the previous block was an
@@ -808,15 +932,10 @@ class PhoneNumberRegExpsAndMappings {
             "[\\d]+(?:[~\xE2\x81\x93\xE2\x88\xBC\xEF\xBD\x9E][\\d]+)?")),
         digits_pattern_(
             regexp_factory_->CreateRegExp(StrCat("[", kDigits, "]*"))),
-        capturing_digit_pattern_(
-            regexp_factory_->CreateRegExp(StrCat("([", kDigits, "])"))),
         capturing_ascii_digits_pattern_(
             regexp_factory_->CreateRegExp("(\\d+)")),
         valid_start_char_pattern_(regexp_factory_->CreateRegExp(
             StrCat("[", PhoneNumberUtil::kPlusChars, kDigits, "]"))),
-        capture_up_to_second_number_start_pattern_(
-            regexp_factory_->CreateRegExp(
-                PhoneNumberUtil::kCaptureUpToSecondNumberStart)),
         unwanted_end_char_pattern_(
             regexp_factory_->CreateRegExp("[^\\p{N}\\p{L}#]")),
         separator_pattern_(regexp_factory_->CreateRegExp(
@@ -854,17 +973,57 @@ class PhoneNumberRegExpsAndMappings {
       const PhoneNumberRegExpsAndMappings&) = delete;
 };
 
+struct PhoneNumberUtil::InternationalPrefixInfo {
+  InternationalPrefixInfo(const PhoneMetadata& metadata,
+                          const PhoneNumberRegExpsAndMappings& reg_exps,
+                          bool compile_idd_matcher)
+      : idd_matcher(metadata.international_prefix(),
+                    *reg_exps.regexp_factory_, compile_idd_matcher),
+        has_single_international_prefix(
+            reg_exps.single_international_prefix_->FullMatch(
+                metadata.international_prefix())) {
+    // In general, if there is a preferred international prefix, use that.
+    // Otherwise, for regions that have multiple international prefixes, the
+    // international format of the number is returned since we would not know
+    // which one to use.
+    if (metadata.has_preferred_international_prefix()) {
+      prefix_for_formatting = metadata.preferred_international_prefix();
+    } else if (has_single_international_prefix) {
+      prefix_for_formatting = metadata.international_prefix();
+    }
+  }
+
+  // Matches the international prefix of the region at the start of a number.
+  const InternationalPrefixMatcher idd_matcher;
+  // Whether the international prefix pattern of the region is a single prefix
+  // rather than a regular expression matching several of them.
+  const bool has_single_international_prefix;
+  // The international prefix to use when formatting a number for out-of-country
+  // dialing from the region, or an empty string if there isn't one.
+  string prefix_for_formatting;
+};
+
 // Private constructor. Also takes care of initialisation.
 PhoneNumberUtil::PhoneNumberUtil()
+    : PhoneNumberUtil(true) {}
+
+PhoneNumberUtil::PhoneNumberUtil(bool use_fast_paths)
     : logger_(Logger::set_logger_impl(new NullLogger())),
       matcher_api_(new RegexBasedMatcher()),
       reg_exps_(new PhoneNumberRegExpsAndMappings),
+      pattern_pool_(new PatternPool(*reg_exps_->regexp_factory_)),
       country_calling_code_to_region_code_map_(
           new std::vector<IntRegionsPair>()),
       nanpa_regions_(new absl::node_hash_set<string>()),
       region_to_metadata_map_(new absl::node_hash_map<string, PhoneMetadata>()),
       country_code_to_non_geographical_metadata_map_(
-          new absl::node_hash_map<int, PhoneMetadata>) {
+          new absl::node_hash_map<int, PhoneMetadata>),
+      region_to_hot_metadata_(new absl::node_hash_map<string, HotMetadata>()),
+      country_code_to_non_geographical_hot_metadata_(
+          new absl::node_hash_map<int, HotMetadata>()),
+      region_to_international_prefix_info_(
+          new absl::node_hash_map<string, InternationalPrefixInfo>()),
+      use_fast_paths_(use_fast_paths) {
   Logger::set_logger_impl(logger_.get());
   // TODO: Update the java version to put the contents of the init
   // method inside the constructor as well to keep both in sync.
@@ -919,6 +1078,30 @@ PhoneNumberUtil::PhoneNumberUtil()
   // Sort all the pairs in ascending order according to country calling code.
   std::sort(country_calling_code_to_region_code_map_->begin(),
             country_calling_code_to_region_code_map_->end(), OrderByFirst());
+
+  for (absl::node_hash_map<string, PhoneMetadata>::const_iterator it =
+           region_to_metadata_map_->begin();
+       it != region_to_metadata_map_->end(); ++it) {
+    region_to_international_prefix_info_->try_emplace(
+        it->first, it->second, *reg_exps_, use_fast_paths_);
+    region_to_hot_metadata_->try_emplace(
+        it->first, it->second,
+        it->second.has_leading_digits()
+            ? &reg_exps_->regexp_cache_->GetRegExp(it->second.leading_digits())
+            : NULL,
+        pattern_pool_.get());
+  }
+  for (absl::node_hash_map<int, PhoneMetadata>::const_iterator it =
+           country_code_to_non_geographical_metadata_map_->begin();
+       it != country_code_to_non_geographical_metadata_map_->end(); ++it) {
+    country_code_to_non_geographical_hot_metadata_->try_emplace(
+        it->first, it->second, static_cast<const RegExp*>(NULL),
+        pattern_pool_.get());
+  }
+  VLOG(1) << "Interned " << pattern_pool_->num_references()
+          << " national number patterns (" << pattern_pool_->referenced_bytes()
+          << " bytes) into " << pattern_pool_->size() << " distinct ones ("
+          << pattern_pool_->pattern_bytes() << " bytes).";
 }
 
 PhoneNumberUtil::~PhoneNumberUtil() {
@@ -997,15 +1180,54 @@ const string& PhoneNumberUtil::GetExtnPatternsForMatching() const {
 
 bool PhoneNumberUtil::StartsWithPlusCharsPattern(const string& number)
     const {
-  const scoped_ptr<RegExpInput> number_string_piece(
-      reg_exps_->regexp_factory_->CreateInput(number));
-  return reg_exps_->plus_chars_pattern_->Consume(number_string_piece.get());
+  return reg_exps_->plus_chars_pattern_->Consume(number, NULL);
 }
 
 bool PhoneNumberUtil::ContainsOnlyValidDigits(const string& s) const {
   return reg_exps_->digits_pattern_->FullMatch(s);
 }
 
+// The regular expression kCaptureUpToSecondNumberStart is evaluated by hand, as
+// it backtracks over every position of the lines that don't match, which takes
+// quadratic time. Since "." doesn't match line terminators, the match starts at
+// the beginning of the first line containing a marker, and the capture extends
+// up to the last marker of that line.
+// static
+bool PhoneNumberUtil::MaybeStripSecondNumber(string* number) {
+  DCHECK(number);
+  const string& text = *number;
+  size_t line_start = 0;
+  size_t marker_start = string::npos;
+  size_t i = 0;
+  while (i < text.length()) {
+    const size_t terminator_length = LineTerminatorLength(text, i);
+    if (terminator_length > 0) {
+      if (marker_start != string::npos) {
+        break;
+      }
+      i += terminator_length;
+      line_start = i;
+      continue;
+    }
+    if (text[i] == '\\' || text[i] == '/') {
+      size_t marker_end = i + 1;
+      while (marker_end < text.length() && text[marker_end] == ' ') {
+        ++marker_end;
+      }
+      if (marker_end < text.length() && text[marker_end] == 'x') {
+        marker_start = i;
+      }
+    }
+    ++i;
+  }
+  if (marker_start == string::npos) {
+    return false;
+  }
+  number->erase(marker_start);
+  number->erase(0, line_start);
+  return true;
+}
+
 void PhoneNumberUtil::TrimUnwantedEndChars(string* number) const {
   DCHECK(number);
   UnicodeText number_as_unicode;
@@ -1015,19 +1237,11 @@ void PhoneNumberUtil::TrimUnwantedEndChars(string* number) const {
     number->clear();
     return;
   }
-  char current_char[5];
-  int len;
-  UnicodeText::const_reverse_iterator reverse_it(number_as_unicode.end());
-  for (; reverse_it.base() != number_as_unicode.begin(); ++reverse_it) {
-    len = reverse_it.get_utf8(current_char);
-    current_char[len] = '\0';
-    if (!reg_exps_->unwanted_end_char_pattern_->FullMatch(current_char)) {
-      break;
-    }
-  }
-
-  number->assign(UnicodeText::UTF8Substring(number_as_unicode.begin(),
-                                            reverse_it.base()));
+  number->assign(UnicodeText::UTF8Substring(
+      number_as_unicode.begin(),
+      FindEndOfWantedChars(*reg_exps_->unwanted_end_char_pattern_,
+                           number_as_unicode.begin(),
+                           number_as_unicode.end())));
 }
 
 bool PhoneNumberUtil::IsFormatEligibleForAsYouTypeFormatter(
@@ -1105,6 +1319,50 @@ const PhoneMetadata* PhoneNumberUtil::GetMetadataForRegion(
   return NULL;
 }
 
+const PhoneNumberUtil::InternationalPrefixInfo*
+PhoneNumberUtil::GetInternationalPrefixInfoForRegion(
+    const string& region_code) const {
+  absl::node_hash_map<string, InternationalPrefixInfo>::const_iterator it =
+      region_to_international_prefix_info_->find(region_code);
+  if (it != region_to_international_prefix_info_->end()) {
+    return &it->second;
+  }
+  return NULL;
+}
+
+const HotMetadata* PhoneNumberUtil::GetHotMetadataForRegion(
+    const string& region_code) const {
+  absl::node_hash_map<string, HotMetadata>::const_iterator it =
+      region_to_hot_metadata_->find(region_code);
+  if (it != region_to_hot_metadata_->end()) {
+    return &it->second;
+  }
+  return NULL;
+}
+
+const HotMetadata* PhoneNumberUtil::GetHotMetadataForRegionOrCallingCode(
+    int country_calling_code, const string& region_code) const {
+  if (kRegionCodeForNonGeoEntity != region_code) {
+    return GetHotMetadataForRegion(region_code);
+  }
+  absl::node_hash_map<int, HotMetadata>::const_iterator it =
+      country_code_to_non_geographical_hot_metadata_->find(
+          country_calling_code);
+  if (it != country_code_to_non_geographical_hot_metadata_->end()) {
+    return &it->second;
+  }
+  return NULL;
+}
+
+const HotMetadata& PhoneNumberUtil::GetHotMetadata(
+    const PhoneMetadata& metadata) const {
+  const HotMetadata* const hot_metadata =
+      GetHotMetadataForRegionOrCallingCode(metadata.country_code(),
+                                           metadata.id());
+  DCHECK(hot_metadata && &hot_metadata->metadata() == &metadata);
+  return *hot_metadata;
+}
+
 const PhoneMetadata* PhoneNumberUtil::GetMetadataForNonGeographicalRegion(
     int country_calling_code) const {
   absl::node_hash_map<int, PhoneMetadata>::const_iterator it =
@@ -1322,11 +1580,13 @@ void PhoneNumberUtil::FormatNumberForMobileDialing(
       // can be dialed internationally, since that always works, except for
       // numbers which might potentially be short numbers, which are always
       // dialled in national format.
-      const PhoneMetadata* region_metadata = GetMetadataForRegion(calling_from);
+      const HotMetadata* region_metadata =
+          GetHotMetadataForRegion(calling_from);
       string national_number;
       GetNationalSignificantNumber(number_no_extension, &national_number);
       if (CanBeInternationallyDialled(number_no_extension) &&
-          TestNumberLength(national_number, *region_metadata) != TOO_SHORT) {
+          TestNumberLengthForType(national_number, *region_metadata,
+                                  UNKNOWN) != TOO_SHORT) {
         Format(number_no_extension, INTERNATIONAL, formatted_number);
       } else {
         Format(number_no_extension, NATIONAL, formatted_number);
@@ -1420,24 +1680,13 @@ void PhoneNumberUtil::FormatOutOfCountryCallingNumber(
     Format(number, NATIONAL, formatted_number);
     return;
   }
-  // Metadata cannot be NULL because we checked 'IsValidRegionCode()' above.
-  const PhoneMetadata* metadata_calling_from =
-      GetMetadataForRegion(calling_from);
-  const string& international_prefix =
-      metadata_calling_from->international_prefix();
-
-  // In general, if there is a preferred international prefix, use that.
+  // The data cannot be NULL because we checked 'IsValidRegionCode()' above.
+  // In general, if there is a preferred international prefix, it is used.
   // Otherwise, for regions that have multiple international prefixes, the
   // international format of the number is returned since we would not know
   // which one to use.
-  std::string international_prefix_for_formatting;
-  if (metadata_calling_from->has_preferred_international_prefix()) {
-    international_prefix_for_formatting =
-        metadata_calling_from->preferred_international_prefix();
-  } else if (reg_exps_->single_international_prefix_->FullMatch(
-                 international_prefix)) {
-    international_prefix_for_formatting = international_prefix;
-  }
+  const string& international_prefix_for_formatting =
+      GetInternationalPrefixInfoForRegion(calling_from)->prefix_for_formatting;
 
   string region_code;
   GetRegionCodeForCountryCode(country_code, &region_code);
@@ -1462,7 +1711,20 @@ void PhoneNumberUtil::FormatInOriginalFormat(const PhoneNumber& number,
                                              string* formatted_number) const {
   DCHECK(formatted_number);
 
-  if (number.has_raw_input() && !HasFormattingPatternForNumber(number)) {
+  // The formatting pattern of the number is looked up once, and reused below
+  // instead of formatting the number from scratch.
+  const int country_calling_code = number.country_code();
+  string region_code;
+  GetRegionCodeForCountryCode(country_calling_code, &region_code);
+  const PhoneMetadata* metadata =
+      GetMetadataForRegionOrCallingCode(country_calling_code, region_code);
+  string national_number;
+  GetNationalSignificantNumber(number, &national_number);
+  const NumberFormat* format_rule =
+      metadata ? ChooseFormattingPatternForNumber(metadata->number_format(),
+                                                  national_number)
+               : NULL;
+  if (number.has_raw_input() && !format_rule) {
     // We check if we have the formatting pattern because without that, we might
     // format the number as a group without national prefix.
     formatted_number->assign(number.raw_input());
@@ -1487,132 +1749,108 @@ void PhoneNumberUtil::FormatInOriginalFormat(const PhoneNumber& number,
     case PhoneNumber::FROM_DEFAULT_COUNTRY:
       // Fall-through to default case.
     default:
-      string region_code;
-      GetRegionCodeForCountryCode(number.country_code(), &region_code);
-      // We strip non-digits from the NDD here, and from the raw input later, so
-      // that we can compare them easily.
-      string national_prefix;
-      GetNddPrefixForRegion(region_code, true /* strip non-digits */,
-                            &national_prefix);
-      if (national_prefix.empty()) {
-        // If the region doesn't have a national prefix at all, we can safely
-        // return the national format without worrying about a national prefix
-        // being added.
-        Format(number, NATIONAL, formatted_number);
-        break;
-      }
-      // Otherwise, we check if the original number was entered with a national
-      // prefix.
-      if (RawInputContainsNationalPrefix(number.raw_input(), national_prefix,
-                                         region_code)) {
-        // If so, we can safely return the national format.
-        Format(number, NATIONAL, formatted_number);
-        break;
-      }
-      // Metadata cannot be NULL here because GetNddPrefixForRegion() (above)
-      // leaves the prefix empty if there is no metadata for the region.
-      const PhoneMetadata* metadata = GetMetadataForRegion(region_code);
-      string national_number;
-      GetNationalSignificantNumber(number, &national_number);
-      // This shouldn't be NULL, because we have checked that above with
-      // HasFormattingPatternForNumber.
-      const NumberFormat* format_rule =
-          ChooseFormattingPatternForNumber(metadata->number_format(),
-                                           national_number);
-      // The format rule could still be NULL here if the national number was 0
-      // and there was no raw input (this should not be possible for numbers
+      // The format rule could be NULL here if the national number was 0 and
+      // there was no raw input (this should not be possible for numbers
       // generated by the phonenumber library as they would also not have a
       // country calling code and we would have exited earlier).
       if (!format_rule) {
         Format(number, NATIONAL, formatted_number);
         break;
       }
-      // When the format we apply to this number doesn't contain national
-      // prefix, we can just return the national format.
-      // TODO: Refactor the code below with the code in
-      // IsNationalPrefixPresentIfRequired.
-      string candidate_national_prefix_rule(
-          format_rule->national_prefix_formatting_rule());
-      // We assume that the first-group symbol will never be _before_ the
-      // national prefix.
-      if (!candidate_national_prefix_rule.empty()) {
-        size_t index_of_first_group = candidate_national_prefix_rule.find("$1");
-        if (index_of_first_group == string::npos) {
-          LOG(ERROR) << "First group missing in national prefix rule: "
-              << candidate_national_prefix_rule;
-          Format(number, NATIONAL, formatted_number);
-          break;
+      // We strip non-digits from the NDD here, and from the raw input later, so
+      // that we can compare them easily.
+      string national_prefix;
+      GetNddPrefixForRegion(region_code, true /* strip non-digits */,
+                            &national_prefix);
+      // If the region doesn't have a national prefix at all, we can safely
+      // return the national format without worrying about a national prefix
+      // being added. Otherwise, we check if the original number was entered
+      // with a national prefix, in which case we can also safely return the
+      // national format.
+      bool strip_national_prefix = false;
+      if (!national_prefix.empty() &&
+          !RawInputContainsNationalPrefix(number, national_number,
+                                          national_prefix)) {
+        // When the format we apply to this number doesn't contain national
+        // prefix, we can just return the national format.
+        // TODO: Refactor the code below with the code in
+        // IsNationalPrefixPresentIfRequired.
+        string candidate_national_prefix_rule(
+            format_rule->national_prefix_formatting_rule());
+        // We assume that the first-group symbol will never be _before_ the
+        // national prefix.
+        if (!candidate_national_prefix_rule.empty()) {
+          size_t index_of_first_group =
+              candidate_national_prefix_rule.find("$1");
+          if (index_of_first_group == string::npos) {
+            LOG(ERROR) << "First group missing in national prefix rule: "
+                << candidate_national_prefix_rule;
+            candidate_national_prefix_rule.clear();
+          } else {
+            candidate_national_prefix_rule.erase(index_of_first_group);
+            NormalizeDigitsOnly(&candidate_national_prefix_rule);
+          }
         }
-        candidate_national_prefix_rule.erase(index_of_first_group);
-        NormalizeDigitsOnly(&candidate_national_prefix_rule);
-      }
-      if (candidate_national_prefix_rule.empty()) {
-        // National prefix not used when formatting this number.
-        Format(number, NATIONAL, formatted_number);
-        break;
+        // Otherwise, we need to remove the national prefix from our output.
+        strip_national_prefix = !candidate_national_prefix_rule.empty();
       }
-      // Otherwise, we need to remove the national prefix from our output.
-      RepeatedPtrField<NumberFormat> number_formats;
-      NumberFormat* number_format = number_formats.Add();
-      number_format->MergeFrom(*format_rule);
-      number_format->clear_national_prefix_formatting_rule();
-      FormatByPattern(number, NATIONAL, number_formats, formatted_number);
+      // Only the NATIONAL format applies the national prefix formatting rule
+      // of a pattern, so the INTERNATIONAL format of the national number is its
+      // national format without national prefix.
+      FormatNsnUsingPattern(national_number, *format_rule,
+                            strip_national_prefix ? INTERNATIONAL : NATIONAL,
+                            formatted_number);
+      MaybeAppendFormattedExtension(number, *metadata, NATIONAL,
+                                    formatted_number);
       break;
   }
   // If no digit is inserted/removed/modified as a result of our formatting, we
   // return the formatted phone number; otherwise we return the raw input the
   // user entered.
-  if (!formatted_number->empty() && !number.raw_input().empty()) {
-    string normalized_formatted_number(*formatted_number);
-    NormalizeDiallableCharsOnly(&normalized_formatted_number);
-    string normalized_raw_input(number.raw_input());
-    NormalizeDiallableCharsOnly(&normalized_raw_input);
-    if (normalized_formatted_number != normalized_raw_input) {
-      formatted_number->assign(number.raw_input());
-    }
+  if (!formatted_number->empty() && !number.raw_input().empty() &&
+      !EqualAfterNormalization(reg_exps_->diallable_char_mappings_,
+                               *formatted_number, number.raw_input())) {
+    formatted_number->assign(number.raw_input());
   }
 }
 
-// Check if raw_input, which is assumed to be in the national format, has a
+// Check if the raw input of a number parsed from its national format has a
 // national prefix. The national prefix is assumed to be in digits-only form.
 bool PhoneNumberUtil::RawInputContainsNationalPrefix(
-    const string& raw_input,
-    const string& national_prefix,
-    const string& region_code) const {
-  string normalized_national_number(raw_input);
-  NormalizeDigitsOnly(&normalized_national_number);
-  if (HasPrefixString(normalized_national_number, national_prefix)) {
-    // Some Japanese numbers (e.g. 00777123) might be mistaken to contain
-    // the national prefix when written without it (e.g. 0777123) if we just
-    // do prefix matching. To tackle that, we check the validity of the
-    // number if the assumed national prefix is removed (777123 won't be
-    // valid in Japan).
-    PhoneNumber number_without_national_prefix;
-    if (Parse(normalized_national_number.substr(national_prefix.length()),
-              region_code, &number_without_national_prefix)
-        == NO_PARSING_ERROR) {
-      return IsValidNumber(number_without_national_prefix);
-    }
+    const PhoneNumber& number,
+    const string& national_number,
+    const string& national_prefix) const {
+  string normalized_raw_input(number.raw_input());
+  NormalizeDigitsOnly(&normalized_raw_input);
+  if (!HasPrefixString(normalized_raw_input, national_prefix)) {
+    return false;
+  }
+  // Some Japanese numbers (e.g. 00777123) might be mistaken to contain the
+  // national prefix when written without it (e.g. 0777123) if we just do
+  // prefix matching. When the digits following the national prefix are exactly
+  // the national number, with no carrier code or extension, parsing stripped
+  // the prefix, since the raw input of a number from the default country has
+  // no country calling code. The number itself then tells whether it is valid
+  // without the prefix. Otherwise, we have to parse them again to find out.
+  // This includes numbers with an extension, whose digits are then parsed as
+  // part of the national number.
+  const size_t national_number_start = national_prefix.length();
+  if (use_fast_paths_ &&
+      number.country_code_source() == PhoneNumber::FROM_DEFAULT_COUNTRY &&
+      !number.has_preferred_domestic_carrier_code() &&
+      !number.has_extension() &&
+      normalized_raw_input.compare(national_number_start, string::npos,
+                                   national_number) == 0) {
+    return IsValidNumber(number);
   }
-  return false;
-}
-
-bool PhoneNumberUtil::HasFormattingPatternForNumber(
-    const PhoneNumber& number) const {
-  int country_calling_code = number.country_code();
   string region_code;
-  GetRegionCodeForCountryCode(country_calling_code, &region_code);
-  const PhoneMetadata* metadata =
-      GetMetadataForRegionOrCallingCode(country_calling_code, region_code);
-  if (!metadata) {
-    return false;
+  GetRegionCodeForCountryCode(number.country_code(), &region_code);
+  PhoneNumber number_without_national_prefix;
+  if (Parse(normalized_raw_input.substr(national_number_start), region_code,
+            &number_without_national_prefix) == NO_PARSING_ERROR) {
+    return IsValidNumber(number_without_national_prefix);
   }
-  string national_number;
-  GetNationalSignificantNumber(number, &national_number);
-  const NumberFormat* format_rule =
-      ChooseFormattingPatternForNumber(metadata->number_format(),
-                                       national_number);
-  return format_rule;
+  return false;
 }
 
 void PhoneNumberUtil::FormatOutOfCountryKeepingAlphaChars(
@@ -1689,11 +1927,11 @@ void PhoneNumberUtil::FormatOutOfCountryKeepingAlphaChars(
   // multiple international prefixes, the international format of the number is
   // returned, unless there is a preferred international prefix.
   if (metadata) {
-    const string& international_prefix = metadata->international_prefix();
     international_prefix_for_formatting =
-        reg_exps_->single_international_prefix_->FullMatch(international_prefix)
-        ? international_prefix
-        : metadata->preferred_international_prefix();
+        GetInternationalPrefixInfoForRegion(calling_from)
+                ->has_single_international_prefix
+            ? metadata->international_prefix()
+            : metadata->preferred_international_prefix();
   }
   if (!international_prefix_for_formatting.empty()) {
     StrAppend(formatted_number, international_prefix_for_formatting, " ",
@@ -1730,13 +1968,11 @@ const NumberFormat* PhoneNumberUtil::ChooseFormattingPatternForNumber(
        it = available_formats.begin(); it != available_formats.end(); ++it) {
     int size = it->leading_digits_pattern_size();
     if (size > 0) {
-      const scoped_ptr<RegExpInput> number_copy(
-          reg_exps_->regexp_factory_->CreateInput(national_number));
       // We always use the last leading_digits_pattern, as it is the most
       // detailed.
       if (!reg_exps_->regexp_cache_->GetRegExp(
               it->leading_digits_pattern(size - 1)).Consume(
-                  number_copy.get())) {
+                  national_number, NULL)) {
         continue;
       }
     }
@@ -1790,10 +2026,10 @@ void PhoneNumberUtil::FormatNsnUsingPatternWithCarrier(
 
   if (number_format == RFC3966) {
     // First consume any leading punctuation, if any was present.
-    const scoped_ptr<RegExpInput> number(
-        reg_exps_->regexp_factory_->CreateInput(*formatted_number));
-    if (reg_exps_->separator_pattern_->Consume(number.get())) {
-      formatted_number->assign(number->ToString());
+    size_t end_of_separators;
+    if (reg_exps_->separator_pattern_->Consume(*formatted_number,
+                                               &end_of_separators)) {
+      formatted_number->erase(0, end_of_separators);
     }
     // Then replace all separators with a "-".
     reg_exps_->separator_pattern_->GlobalReplace(formatted_number, "-");
@@ -1833,7 +2069,7 @@ void PhoneNumberUtil::FormatNsnWithCarrier(const string& number,
   DCHECK(formatted_number);
   // When the intl_number_formats exists, we use that to format national number
   // for the INTERNATIONAL format instead of using the number_formats.
-  const RepeatedPtrField<NumberFormat> available_formats =
+  const RepeatedPtrField<NumberFormat>& available_formats =
       (metadata.intl_number_format_size() == 0 || number_format == NATIONAL)
       ? metadata.number_format()
       : metadata.intl_number_format();
@@ -1938,12 +2174,9 @@ void PhoneNumberUtil::GetRegionCodeForNumberFromRegionList(
        it != region_codes.end(); ++it) {
     // Metadata cannot be NULL because the region codes come from the country
     // calling code map.
-    const PhoneMetadata* metadata = GetMetadataForRegion(*it);
-    if (metadata->has_leading_digits()) {
-      const scoped_ptr<RegExpInput> number(
-          reg_exps_->regexp_factory_->CreateInput(national_number));
-      if (reg_exps_->regexp_cache_->
-              GetRegExp(metadata->leading_digits()).Consume(number.get())) {
+    const HotMetadata* metadata = GetHotMetadataForRegion(*it);
+    if (metadata->leading_digits()) {
+      if (metadata->leading_digits()->Consume(national_number, NULL)) {
         *region_code = *it;
         return;
       }
@@ -2149,6 +2382,65 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseAndKeepRawInput(
   return ParseHelper(number_to_parse, default_region, true, true, number);
 }
 
+PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseWithBudget(
+    const string& number_to_parse,
+    const string& default_region,
+    ExecutionBudget* budget,
+    PhoneNumber* number) const {
+  DCHECK(budget);
+  DCHECK(number);
+  if (!budget->Consume()) {
+    return DEADLINE_EXCEEDED;
+  }
+  const ScopedExecutionBudget scoped_budget(budget);
+  // The regular expressions fail once the budget is exhausted, in which case
+  // ParseHelper() leaves number unchanged.
+  const ErrorType error =
+      ParseHelper(number_to_parse, default_region, false, true, number);
+  if (budget->IsExhausted()) {
+    VLOG(1) << "Ran out of budget while parsing the number.";
+    return DEADLINE_EXCEEDED;
+  }
+  return error;
+}
+
+void PhoneNumberUtil::ParseBatch(const std::vector<string>& numbers_to_parse,
+                                 const string& default_region,
+                                 bool keep_raw_input,
+                                 google::protobuf::Arena* arena,
+                                 std::vector<PhoneNumber*>* numbers,
+                                 std::vector<ErrorType>* errors) const {
+  ParseBatch(numbers_to_parse, default_region, keep_raw_input, arena, NULL,
+             numbers, errors);
+}
+
+void PhoneNumberUtil::ParseBatch(const std::vector<string>& numbers_to_parse,
+                                 const string& default_region,
+                                 bool keep_raw_input,
+                                 google::protobuf::Arena* arena,
+                                 Executor* executor,
+                                 std::vector<PhoneNumber*>* numbers,
+                                 std::vector<ErrorType>* errors) const {
+  DCHECK(arena);
+  DCHECK(numbers);
+  DCHECK(errors);
+  // About the cost of parsing a number, in nanoseconds.
+  static const int64 kParseCostNs = 2000;
+  numbers->assign(numbers_to_parse.size(), NULL);
+  errors->assign(numbers_to_parse.size(), NO_PARSING_ERROR);
+  // Arenas are thread-safe, and each number is written to its own position.
+  ParallelFor(executor, numbers_to_parse.size(), kParseCostNs,
+              [&](int64 begin, int64 end) {
+    for (int64 i = begin; i < end; ++i) {
+      PhoneNumber* const number =
+          google::protobuf::Arena::CreateMessage<PhoneNumber>(arena);
+      (*errors)[i] = ParseHelper(numbers_to_parse[i], default_region,
+                                 keep_raw_input, true, number);
+      (*numbers)[i] = number;
+    }
+  });
+}
+
 // Checks to see that the region code used is valid, or if it is not valid, that
 // the number to parse starts with a + symbol so that we can attempt to infer
 // the country from the number. Returns false if it cannot use the region
@@ -2157,9 +2449,7 @@ bool PhoneNumberUtil::CheckRegionForParsing(
     const string& number_to_parse,
     const string& default_region) const {
   if (!IsValidRegionCode(default_region) && !number_to_parse.empty()) {
-    const scoped_ptr<RegExpInput> number(
-        reg_exps_->regexp_factory_->CreateInput(number_to_parse));
-    if (!reg_exps_->plus_chars_pattern_->Consume(number.get())) {
+    if (!reg_exps_->plus_chars_pattern_->Consume(number_to_parse, NULL)) {
       return false;
     }
   }
@@ -2218,9 +2508,33 @@ bool PhoneNumberUtil::IsPhoneContextValid(
 
 // Converts number_to_parse to a form that we can parse and write it to
 // national_number if it is written in RFC3966; otherwise extract a possible
-// number out of it and write to national_number.
+// number out of it and write to national_number. utf8_validated is set to true
+// if national_number is known to be interchange-valid UTF-8, which is when the
+// possible number was extracted.
 PhoneNumberUtil::ErrorType PhoneNumberUtil::BuildNationalNumberForParsing(
-    const string& number_to_parse, string* national_number) const {
+    const string& number_to_parse,
+    string* national_number,
+    bool* utf8_validated) const {
+  DCHECK(utf8_validated);
+  *utf8_validated = false;
+  // tel URIs, such as those found in SIP headers, are split without regular
+  // expressions when they are made of ASCII characters.
+  TelUri tel_uri;
+  if (use_fast_paths_ && TokenizeTelUri(number_to_parse, &tel_uri) &&
+      std::find_if(number_to_parse.begin(), number_to_parse.end(),
+                   [](char c) { return !absl::ascii_isascii(c); }) ==
+          number_to_parse.end()) {
+    if (tel_uri.has_phone_context &&
+        !IsValidAsciiPhoneContext(tel_uri.phone_context)) {
+      VLOG(2) << "The phone-context value is invalid.";
+      return NOT_A_NUMBER;
+    }
+    if (MaybeBuildNationalNumberFromTelUri(number_to_parse, tel_uri,
+                                           national_number)) {
+      return NO_PARSING_ERROR;
+    }
+  }
+
   size_t index_of_phone_context = number_to_parse.find(kRfc3966PhoneContext);
 
   absl::optional<string> phone_context =
@@ -2255,8 +2569,10 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::BuildNationalNumberForParsing(
             index_of_phone_context - index_of_national_number));
   } else {
     // Extract a possible number from the string passed in (this strips leading
-    // characters that could not be the start of a phone number.)
+    // characters that could not be the start of a phone number.) This checks
+    // that the number is valid UTF-8, so that it isn't checked again.
     ExtractPossibleNumber(number_to_parse, national_number);
+    *utf8_validated = true;
   }
 
   // Delete the isdn-subaddress and everything after it if it is present. Note
@@ -2274,6 +2590,53 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::BuildNationalNumberForParsing(
   return NO_PARSING_ERROR;
 }
 
+bool PhoneNumberUtil::MaybeBuildNationalNumberFromTelUri(
+    const string& number_to_parse,
+    const TelUri& tel_uri,
+    string* national_number) const {
+  DCHECK(national_number);
+  const size_t index_of_national_number = strlen(kRfc3966Prefix);
+  size_t end_of_national_number;
+  if (tel_uri.has_phone_context) {
+    // If the phone context contains a phone number prefix, we need to capture
+    // it, whereas domains will be ignored.
+    if (tel_uri.phone_context[0] == kPlusSign[0]) {
+      national_number->assign(tel_uri.phone_context.data(),
+                              tel_uri.phone_context.length());
+    }
+    // Now append everything between the "tel:" prefix and the phone-context
+    // parameter.
+    end_of_national_number =
+        tel_uri.phone_context.data() - number_to_parse.data() -
+        strlen(kRfc3966PhoneContext);
+  } else {
+    // This is what ExtractPossibleNumber() does when the number starts right
+    // after the "tel:" prefix and there is no second number: the characters
+    // that are neither alphanumeric nor '#' are trimmed from the end.
+    if (tel_uri.number.empty() ||
+        (!absl::ascii_isdigit(tel_uri.number[0]) &&
+         tel_uri.number[0] != kPlusSign[0]) ||
+        number_to_parse.find_first_of("\\/") != string::npos) {
+      return false;
+    }
+    end_of_national_number = number_to_parse.length();
+    // The number may have nothing left, like in "tel:+".
+    while (end_of_national_number > index_of_national_number &&
+           !absl::ascii_isalnum(number_to_parse[end_of_national_number - 1]) &&
+           number_to_parse[end_of_national_number - 1] != '#') {
+      --end_of_national_number;
+    }
+  }
+  national_number->append(number_to_parse, index_of_national_number,
+                          end_of_national_number - index_of_national_number);
+  // Delete the isdn-subaddress and everything after it if it is present.
+  size_t index_of_isdn = national_number->find(kRfc3966IsdnSubaddress);
+  if (index_of_isdn != string::npos) {
+    national_number->erase(index_of_isdn);
+  }
+  return true;
+}
+
 // Note if any new field is added to this method that should always be filled
 // in, even when keepRawInput is false, it should also be handled in the
 // CopyCoreFieldsOnly() method.
@@ -2286,8 +2649,10 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseHelper(
   DCHECK(phone_number);
 
   string national_number;
+  bool utf8_validated;
   PhoneNumberUtil::ErrorType build_national_number_for_parsing_return =
-      BuildNationalNumberForParsing(number_to_parse, &national_number);
+      BuildNationalNumberForParsing(number_to_parse, &national_number,
+                                    &utf8_validated);
   if (build_national_number_for_parsing_return != NO_PARSING_ERROR) {
     return build_national_number_for_parsing_return;
   }
@@ -2302,33 +2667,34 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseHelper(
     VLOG(1) << "Missing or invalid default country.";
     return INVALID_COUNTRY_CODE_ERROR;
   }
+  // The strings of the number are kept aside until it is complete, and
+  // temp_number only gets its other fields.
   PhoneNumber temp_number;
-  if (keep_raw_input) {
-    temp_number.set_raw_input(number_to_parse);
-  }
   // Attempt to parse extension first, since it doesn't require country-specific
   // data and we want to have the non-normalised number here.
   string extension;
   MaybeStripExtension(&national_number, &extension);
-  if (!extension.empty()) {
-    temp_number.set_extension(extension);
-  }
-  const PhoneMetadata* country_metadata = GetMetadataForRegion(default_region);
+  const HotMetadata* country_metadata = GetHotMetadataForRegion(default_region);
+  const PhoneMetadata* const default_region_metadata =
+      country_metadata ? &country_metadata->metadata() : NULL;
   // Check to see if the number is given in international format so we know
   // whether this number is from the default country or not.
   string normalized_national_number(national_number);
   ErrorType country_code_error =
-      MaybeExtractCountryCode(country_metadata, keep_raw_input,
-                              &normalized_national_number, &temp_number);
+      MaybeExtractCountryCode(default_region_metadata, keep_raw_input,
+                              utf8_validated, &normalized_national_number,
+                              &temp_number);
   if (country_code_error != NO_PARSING_ERROR) {
-    const scoped_ptr<RegExpInput> number_string_piece(
-        reg_exps_->regexp_factory_->CreateInput(national_number));
+    size_t end_of_plus_chars;
     if ((country_code_error == INVALID_COUNTRY_CODE_ERROR) &&
-        (reg_exps_->plus_chars_pattern_->Consume(number_string_piece.get()))) {
-      normalized_national_number.assign(number_string_piece->ToString());
+        (reg_exps_->plus_chars_pattern_->Consume(national_number,
+                                                 &end_of_plus_chars))) {
+      normalized_national_number.assign(national_number, end_of_plus_chars,
+                                        string::npos);
       // Strip the plus-char, and try again.
-      MaybeExtractCountryCode(country_metadata,
+      MaybeExtractCountryCode(default_region_metadata,
                               keep_raw_input,
+                              utf8_validated,
                               &normalized_national_number,
                               &temp_number);
       if (temp_number.country_code() == 0) {
@@ -2343,8 +2709,8 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseHelper(
     string phone_number_region;
     GetRegionCodeForCountryCode(country_code, &phone_number_region);
     if (phone_number_region != default_region) {
-      country_metadata =
-          GetMetadataForRegionOrCallingCode(country_code, phone_number_region);
+      country_metadata = GetHotMetadataForRegionOrCallingCode(
+          country_code, phone_number_region);
     }
   } else if (country_metadata) {
     // If no extracted country calling code, use the region supplied instead.
@@ -2356,25 +2722,26 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseHelper(
     VLOG(2) << "The string supplied is too short to be a phone number.";
     return TOO_SHORT_NSN;
   }
+  string preferred_domestic_carrier_code;
   if (country_metadata) {
     string carrier_code;
     string potential_national_number(normalized_national_number);
-    MaybeStripNationalPrefixAndCarrierCode(*country_metadata,
+    MaybeStripNationalPrefixAndCarrierCode(country_metadata->metadata(),
                                            &potential_national_number,
                                            &carrier_code);
     // We require that the NSN remaining after stripping the national prefix
     // and carrier code be long enough to be a possible length for the region.
     // Otherwise, we don't do the stripping, since the original number could be
     // a valid short number.
-    ValidationResult validation_result =
-        TestNumberLength(potential_national_number, *country_metadata);
+    ValidationResult validation_result = TestNumberLengthForType(
+        potential_national_number, *country_metadata, UNKNOWN);
     if (validation_result != TOO_SHORT &&
         validation_result != IS_POSSIBLE_LOCAL_ONLY &&
         validation_result != INVALID_LENGTH) {
-      normalized_national_number.assign(potential_national_number);
-      if (keep_raw_input && !carrier_code.empty()) {
-        temp_number.set_preferred_domestic_carrier_code(carrier_code);
+      if (keep_raw_input) {
+        preferred_domestic_carrier_code.swap(carrier_code);
       }
+      normalized_national_number.assign(potential_national_number);
     }
   }
   size_t normalized_national_number_length =
@@ -2393,7 +2760,25 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::ParseHelper(
   uint64 number_as_int;
   safe_strtou64(normalized_national_number, &number_as_int);
   temp_number.set_national_number(number_as_int);
-  phone_number->Swap(&temp_number);
+  // A result computed with regular expressions failing for lack of budget
+  // can't be trusted, so that phone_number is left unchanged.
+  const ExecutionBudget* const budget = ExecutionBudget::Current();
+  if (budget && budget->IsExhausted()) {
+    return DEADLINE_EXCEEDED;
+  }
+  // The strings are set on phone_number itself rather than swapped into it, so
+  // that they are allocated once, on its arena if it has one.
+  phone_number->CopyFrom(temp_number);
+  if (keep_raw_input) {
+    phone_number->set_raw_input(number_to_parse);
+  }
+  if (!extension.empty()) {
+    phone_number->set_extension(extension);
+  }
+  if (!preferred_domestic_carrier_code.empty()) {
+    phone_number->set_preferred_domestic_carrier_code(
+        preferred_domestic_carrier_code);
+  }
   return NO_PARSING_ERROR;
 }
 
@@ -2436,16 +2821,22 @@ void PhoneNumberUtil::ExtractPossibleNumber(const string& number,
     return;
   }
 
-  extracted_number->assign(
-      UnicodeText::UTF8Substring(it, number_as_unicode.end()));
-  TrimUnwantedEndChars(extracted_number);
+  // The number was validated above, so that the end is trimmed in place rather
+  // than validating a copy of the rest of the number again.
+  extracted_number->assign(UnicodeText::UTF8Substring(
+      it, FindEndOfWantedChars(*reg_exps_->unwanted_end_char_pattern_, it,
+                               number_as_unicode.end())));
   if (extracted_number->length() == 0) {
     return;
   }
 
   // Now remove any extra numbers at the end.
-  reg_exps_->capture_up_to_second_number_start_pattern_->
-      PartialMatch(*extracted_number, extracted_number);
+  if (use_fast_paths_) {
+    MaybeStripSecondNumber(extracted_number);
+  } else {
+    reg_exps_->regexp_cache_->GetRegExp(kCaptureUpToSecondNumberStart)
+        .PartialMatch(*extracted_number, extracted_number);
+  }
 }
 
 bool PhoneNumberUtil::IsPossibleNumber(const PhoneNumber& number) const {
@@ -2495,9 +2886,9 @@ PhoneNumberUtil::IsPossibleNumberForTypeWithReason(const PhoneNumber& number,
   string region_code;
   GetRegionCodeForCountryCode(country_code, &region_code);
   // Metadata cannot be NULL because the country calling code is valid.
-  const PhoneMetadata* metadata =
-      GetMetadataForRegionOrCallingCode(country_code, region_code);
-  return TestNumberLength(national_number, *metadata, type);
+  const HotMetadata* metadata =
+      GetHotMetadataForRegionOrCallingCode(country_code, region_code);
+  return TestNumberLengthForType(national_number, *metadata, type);
 }
 
 bool PhoneNumberUtil::TruncateTooLongNumber(PhoneNumber* number) const {
@@ -2522,8 +2913,8 @@ PhoneNumberUtil::PhoneNumberType PhoneNumberUtil::GetNumberType(
     const PhoneNumber& number) const {
   string region_code;
   GetRegionCodeForNumber(number, &region_code);
-  const PhoneMetadata* metadata =
-      GetMetadataForRegionOrCallingCode(number.country_code(), region_code);
+  const HotMetadata* metadata =
+      GetHotMetadataForRegionOrCallingCode(number.country_code(), region_code);
   if (!metadata) {
     return UNKNOWN;
   }
@@ -2541,11 +2932,11 @@ bool PhoneNumberUtil::IsValidNumber(const PhoneNumber& number) const {
 bool PhoneNumberUtil::IsValidNumberForRegion(const PhoneNumber& number,
                                              const string& region_code) const {
   int country_code = number.country_code();
-  const PhoneMetadata* metadata =
-      GetMetadataForRegionOrCallingCode(country_code, region_code);
+  const HotMetadata* metadata =
+      GetHotMetadataForRegionOrCallingCode(country_code, region_code);
   if (!metadata ||
       ((kRegionCodeForNonGeoEntity != region_code) &&
-       country_code != GetCountryCodeForValidRegion(region_code))) {
+       country_code != metadata->country_code())) {
     // Either the region code was invalid, or the country calling code for this
     // number does not match that of the region code.
     return false;
@@ -2606,54 +2997,91 @@ bool PhoneNumberUtil::IsNumberMatchingDesc(
   return IsMatch(*matcher_api_, national_number, number_desc);
 }
 
+PhoneNumberUtil::ValidationResult PhoneNumberUtil::TestNumberLengthForType(
+    const string& number, const HotMetadata& metadata,
+    PhoneNumberType type) const {
+  if (!use_fast_paths_) {
+    return TestNumberLength(number, metadata.metadata(), type);
+  }
+  return metadata.TestNumberLength(static_cast<int>(number.length()), type);
+}
+
+bool PhoneNumberUtil::MatchesNationalNumberPattern(
+    const string& national_number, const HotMetadata& metadata,
+    PhoneNumberType type) const {
+  if (!use_fast_paths_) {
+    return IsMatch(*matcher_api_, national_number,
+                   *GetNumberDescByType(metadata.metadata(), type));
+  }
+  return pattern_pool_->FullMatch(metadata.pattern_id(type), national_number);
+}
+
+bool PhoneNumberUtil::IsNumberMatchingDesc(
+    const string& national_number, const HotMetadata& metadata,
+    PhoneNumberType type) const {
+  if (!use_fast_paths_) {
+    return IsNumberMatchingDesc(national_number,
+                                *GetNumberDescByType(metadata.metadata(),
+                                                     type));
+  }
+  return metadata.IsPossibleLengthForDesc(
+             static_cast<int>(national_number.length()), type) &&
+         MatchesNationalNumberPattern(national_number, metadata, type);
+}
+
 PhoneNumberUtil::PhoneNumberType PhoneNumberUtil::GetNumberTypeHelper(
     const string& national_number, const PhoneMetadata& metadata) const {
-  if (!IsNumberMatchingDesc(national_number, metadata.general_desc())) {
+  return GetNumberTypeHelper(national_number, GetHotMetadata(metadata));
+}
+
+PhoneNumberUtil::PhoneNumberType PhoneNumberUtil::GetNumberTypeHelper(
+    const string& national_number, const HotMetadata& hot_metadata) const {
+  if (!IsNumberMatchingDesc(national_number, hot_metadata, UNKNOWN)) {
     VLOG(4) << "Number type unknown - doesn't match general national number"
             << " pattern.";
     return PhoneNumberUtil::UNKNOWN;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.premium_rate())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, PREMIUM_RATE)) {
     VLOG(4) << "Number is a premium number.";
     return PhoneNumberUtil::PREMIUM_RATE;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.toll_free())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, TOLL_FREE)) {
     VLOG(4) << "Number is a toll-free number.";
     return PhoneNumberUtil::TOLL_FREE;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.shared_cost())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, SHARED_COST)) {
     VLOG(4) << "Number is a shared cost number.";
     return PhoneNumberUtil::SHARED_COST;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.voip())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, VOIP)) {
     VLOG(4) << "Number is a VOIP (Voice over IP) number.";
     return PhoneNumberUtil::VOIP;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.personal_number())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, PERSONAL_NUMBER)) {
     VLOG(4) << "Number is a personal number.";
     return PhoneNumberUtil::PERSONAL_NUMBER;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.pager())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, PAGER)) {
     VLOG(4) << "Number is a pager number.";
     return PhoneNumberUtil::PAGER;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.uan())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, UAN)) {
     VLOG(4) << "Number is a UAN.";
     return PhoneNumberUtil::UAN;
   }
-  if (IsNumberMatchingDesc(national_number, metadata.voicemail())) {
+  if (IsNumberMatchingDesc(national_number, hot_metadata, VOICEMAIL)) {
     VLOG(4) << "Number is a voicemail number.";
     return PhoneNumberUtil::VOICEMAIL;
   }
 
   bool is_fixed_line =
-      IsNumberMatchingDesc(national_number, metadata.fixed_line());
+      IsNumberMatchingDesc(national_number, hot_metadata, FIXED_LINE);
   if (is_fixed_line) {
-    if (metadata.same_mobile_and_fixed_line_pattern()) {
+    if (hot_metadata.same_mobile_and_fixed_line_pattern()) {
       VLOG(4) << "Fixed-line and mobile patterns equal, number is fixed-line"
               << " or mobile";
       return PhoneNumberUtil::FIXED_LINE_OR_MOBILE;
-    } else if (IsNumberMatchingDesc(national_number, metadata.mobile())) {
+    } else if (IsNumberMatchingDesc(national_number, hot_metadata, MOBILE)) {
       VLOG(4) << "Fixed-line and mobile patterns differ, but number is "
               << "still fixed-line or mobile";
       return PhoneNumberUtil::FIXED_LINE_OR_MOBILE;
@@ -2663,8 +3091,8 @@ PhoneNumberUtil::PhoneNumberType PhoneNumberUtil::GetNumberTypeHelper(
   }
   // Otherwise, test to see if the number is mobile. Only do this if certain
   // that the patterns for mobile and fixed line aren't the same.
-  if (!metadata.same_mobile_and_fixed_line_pattern() &&
-      IsNumberMatchingDesc(national_number, metadata.mobile())) {
+  if (!hot_metadata.same_mobile_and_fixed_line_pattern() &&
+      IsNumberMatchingDesc(national_number, hot_metadata, MOBILE)) {
     VLOG(4) << "Number is a mobile number.";
     return PhoneNumberUtil::MOBILE;
   }
@@ -2720,11 +3148,32 @@ int PhoneNumberUtil::GetLengthOfGeographicalAreaCode(
     return 0;
   }
 
-  return GetLengthOfNationalDestinationCode(number);
+  if (!use_fast_paths_) {
+    return GetLengthOfNationalDestinationCode(number);
+  }
+  NumberDecomposition decomposition;
+  DecomposeWithType(number, type, &decomposition);
+  return decomposition.national_destination_code.length;
 }
 
 int PhoneNumberUtil::GetLengthOfNationalDestinationCode(
     const PhoneNumber& number) const {
+  if (!use_fast_paths_) {
+    return GetLengthOfNationalDestinationCodeFromFormat(number);
+  }
+  // The type of the number only matters for countries using a mobile token, so
+  // it isn't computed for the others.
+  string mobile_token;
+  GetCountryMobileToken(number.country_code(), &mobile_token);
+  NumberDecomposition decomposition;
+  DecomposeWithType(number,
+                    mobile_token.empty() ? UNKNOWN : GetNumberType(number),
+                    &decomposition);
+  return decomposition.national_destination_code.length;
+}
+
+int PhoneNumberUtil::GetLengthOfNationalDestinationCodeFromFormat(
+    const PhoneNumber& number) const {
   PhoneNumber copied_proto(number);
   if (number.has_extension()) {
     // Clear the extension so it's not included when formatting.
@@ -2767,6 +3216,134 @@ int PhoneNumberUtil::GetLengthOfNationalDestinationCode(
   return static_cast<int>(ndc.size());
 }
 
+void PhoneNumberUtil::Decompose(const PhoneNumber& number,
+                                NumberDecomposition* decomposition) const {
+  DCHECK(decomposition);
+  DecomposeWithType(number, GetNumberType(number), decomposition);
+}
+
+void PhoneNumberUtil::DecomposeWithType(
+    const PhoneNumber& number,
+    PhoneNumberType number_type,
+    NumberDecomposition* decomposition) const {
+  DCHECK(decomposition);
+  const int country_calling_code = number.country_code();
+  decomposition->country_calling_code = country_calling_code;
+  decomposition->number_type = number_type;
+  decomposition->national_destination_code = Span();
+  decomposition->subscriber_number_groups.clear();
+  string* const national_significant_number =
+      &decomposition->national_significant_number;
+  national_significant_number->clear();
+  GetNationalSignificantNumber(number, national_significant_number);
+
+  // Find the groups of digits of the INTERNATIONAL format directly from the
+  // formatting pattern Format() would pick, rather than by formatting the
+  // number and splitting the result.
+  std::vector<Span> groups;
+  const NumberFormat* formatting_pattern = NULL;
+  if (HasValidCountryCallingCode(country_calling_code)) {
+    string region_code;
+    GetRegionCodeForCountryCode(country_calling_code, &region_code);
+    const PhoneMetadata* metadata =
+        GetMetadataForRegionOrCallingCode(country_calling_code, region_code);
+    if (metadata) {
+      formatting_pattern = ChooseFormattingPatternForNumber(
+          metadata->intl_number_format_size() == 0
+              ? metadata->number_format()
+              : metadata->intl_number_format(),
+          *national_significant_number);
+    }
+  }
+  if (formatting_pattern) {
+    const string& format = formatting_pattern->format();
+    // Only the groups referenced by the format are captured.
+    int num_groups = 0;
+    for (size_t i = 0; i + 1 < format.length(); ++i) {
+      if (IsGroupReference(format, i)) {
+        num_groups = std::max(num_groups, format[i + 1] - '0');
+      }
+    }
+    static const int kMaxGroups = 6;
+    string captured_groups[kMaxGroups];
+    string* outputs[kMaxGroups] = {NULL, NULL, NULL, NULL, NULL, NULL};
+    for (int i = 0; i < num_groups && i < kMaxGroups; ++i) {
+      outputs[i] = &captured_groups[i];
+    }
+    const scoped_ptr<RegExpInput> input(
+        reg_exps_->regexp_factory_->CreateInput(*national_significant_number));
+    if (num_groups <= kMaxGroups &&
+        reg_exps_->regexp_cache_->GetRegExp(formatting_pattern->pattern())
+            .Consume(input.get(), outputs[0], outputs[1], outputs[2],
+                     outputs[3], outputs[4], outputs[5])) {
+      // Locate each captured group in the national significant number. The
+      // groups of a formatting pattern appear in order.
+      Span captured_spans[kMaxGroups];
+      size_t position = 0;
+      for (int i = 0; i < num_groups; ++i) {
+        const size_t start =
+            national_significant_number->find(captured_groups[i], position);
+        if (start == string::npos) {
+          break;
+        }
+        captured_spans[i] = Span(static_cast<int>(start),
+                                 static_cast<int>(captured_groups[i].length()));
+        position = start + captured_groups[i].length();
+      }
+      // Groups referenced next to each other in the format, such as in "$1$2",
+      // end up in the same group of digits.
+      bool previous_was_group = false;
+      for (size_t i = 0; i < format.length(); ++i) {
+        if (IsGroupReference(format, i)) {
+          const Span& span = captured_spans[format[++i] - '1'];
+          if (span.length == 0) {
+            continue;
+          }
+          if (previous_was_group &&
+              groups.back().start + groups.back().length == span.start) {
+            groups.back().length += span.length;
+          } else {
+            groups.push_back(span);
+          }
+          previous_was_group = true;
+        } else {
+          previous_was_group = false;
+        }
+      }
+    }
+  }
+  if (groups.empty() && !national_significant_number->empty()) {
+    groups.push_back(
+        Span(0, static_cast<int>(national_significant_number->length())));
+  }
+
+  // The NDC is the first group, provided a subscriber number follows.
+  size_t first_subscriber_number_group = 0;
+  if (groups.size() >= 2) {
+    string mobile_token;
+    if (number_type == MOBILE) {
+      GetCountryMobileToken(country_calling_code, &mobile_token);
+    }
+    if (!mobile_token.empty()) {
+      // For example Argentinian mobile numbers, when formatted in the
+      // international format, are in the form of +54 9 NDC XXXX.... As a
+      // result, we take the length of the second group (NDC) and add the length
+      // of the mobile token, which also forms part of the national significant
+      // number. This assumes that the mobile token is always formatted
+      // separately from the rest of the phone number.
+      decomposition->national_destination_code = Span(
+          groups[0].start,
+          static_cast<int>(mobile_token.length()) + groups[1].length);
+      first_subscriber_number_group = 2;
+    } else {
+      decomposition->national_destination_code = groups[0];
+      first_subscriber_number_group = 1;
+    }
+  }
+  decomposition->subscriber_number_groups.assign(
+      groups.begin() + first_subscriber_number_group, groups.end());
+}
+
 void PhoneNumberUtil::GetCountryMobileToken(int country_calling_code,
                                             string* mobile_token) const {
   DCHECK(mobile_token);
@@ -2780,13 +3357,19 @@ void PhoneNumberUtil::GetCountryMobileToken(int country_calling_code,
 }
 
 void PhoneNumberUtil::NormalizeDigitsOnly(string* number) const {
+  NormalizeDigits(false /* utf8 not validated */, number);
+}
+
+void PhoneNumberUtil::NormalizeDigits(bool utf8_validated,
+                                      string* number) const {
   DCHECK(number);
   const RegExp& non_digits_pattern = reg_exps_->regexp_cache_->GetRegExp(
       StrCat("[^", kDigits, "]"));
   // Delete everything that isn't valid digits.
   non_digits_pattern.GlobalReplace(number, "");
   // Normalize all decimal digits to ASCII digits.
-  number->assign(NormalizeUTF8::NormalizeDecimalDigits(*number));
+  number->assign(
+      NormalizeUTF8::NormalizeDecimalDigits(*number, utf8_validated));
 }
 
 void PhoneNumberUtil::NormalizeDiallableCharsOnly(string* number) const {
@@ -2804,7 +3387,9 @@ bool PhoneNumberUtil::IsAlphaNumber(const string& number) const {
   string number_copy(number);
   string extension;
   MaybeStripExtension(&number_copy, &extension);
-  return reg_exps_->valid_alpha_phone_pattern_->FullMatch(number_copy);
+  return use_fast_paths_
+      ? FullyMatchesAlphaPhoneLetters(number_copy)
+      : reg_exps_->valid_alpha_phone_pattern_->FullMatch(number_copy);
 }
 
 void PhoneNumberUtil::ConvertAlphaCharactersInNumber(string* number) const {
@@ -2824,12 +3409,61 @@ void PhoneNumberUtil::ConvertAlphaCharactersInNumber(string* number) const {
 //   - Wide-ascii digits are converted to normal ASCII (European) digits.
 //   - Arabic-Indic numerals are converted to European numerals.
 //   - Spurious alpha characters are stripped.
-void PhoneNumberUtil::Normalize(string* number) const {
+// If utf8_validated is true, the number is already known to be
+// interchange-valid UTF-8, and isn't validated again.
+void PhoneNumberUtil::Normalize(bool utf8_validated, string* number) const {
   DCHECK(number);
-  if (reg_exps_->valid_alpha_phone_pattern_->PartialMatch(*number)) {
-    NormalizeHelper(reg_exps_->alpha_phone_mappings_, true, number);
+  DCHECK(!utf8_validated || UniLib::IsInterchangeValid(*number));
+  if (use_fast_paths_
+          ? ContainsAlphaPhoneLetters(*number)
+          : reg_exps_->valid_alpha_phone_pattern_->PartialMatch(*number)) {
+    NormalizeHelper(reg_exps_->alpha_phone_mappings_, true, utf8_validated,
+                    number);
+  }
+  NormalizeDigits(utf8_validated, number);
+}
+
+// The lazy quantifiers of valid_alpha_phone_pattern_ rescan the rest of the
+// line from every position of a number with fewer than three letters, so that
+// the letters are counted by hand instead. They must all be on the same line,
+// since "." doesn't match line terminators.
+// static
+bool PhoneNumberUtil::ContainsAlphaPhoneLetters(const string& number) {
+  int letters_on_line = 0;
+  size_t i = 0;
+  while (i < number.length()) {
+    const size_t terminator_length = LineTerminatorLength(number, i);
+    if (terminator_length > 0) {
+      letters_on_line = 0;
+      i += terminator_length;
+      continue;
+    }
+    if (AlphaPhoneLetterLength(number, i) > 0 && ++letters_on_line == 3) {
+      return true;
+    }
+    ++i;
   }
-  NormalizeDigitsOnly(number);
+  return false;
+}
+
+// When valid_alpha_phone_pattern_ must match the whole number, it backtracks
+// through every way of picking three of its letters before failing, which is
+// cubic in the length of the number.
+// static
+bool PhoneNumberUtil::FullyMatchesAlphaPhoneLetters(const string& number) {
+  int letters = 0;
+  size_t last_letter_end = 0;
+  for (size_t i = 0; i < number.length(); ++i) {
+    if (LineTerminatorLength(number, i) > 0) {
+      return false;
+    }
+    const size_t letter_length = AlphaPhoneLetterLength(number, i);
+    if (letter_length > 0) {
+      ++letters;
+      last_letter_end = i + letter_length;
+    }
+  }
+  return letters >= 3 && last_letter_end == number.length();
 }
 
 // Checks to see if the string of characters could possibly be a phone number at
@@ -2847,25 +3481,22 @@ bool PhoneNumberUtil::IsViablePhoneNumber(const string& number) const {
 
 // Strips the IDD from the start of the number if present. Helper function used
 // by MaybeStripInternationalPrefixAndNormalize.
-bool PhoneNumberUtil::ParsePrefixAsIdd(const RegExp& idd_pattern,
-                                       string* number) const {
+bool PhoneNumberUtil::ParsePrefixAsIdd(
+    const InternationalPrefixMatcher& idd_matcher,
+    string* number) const {
   DCHECK(number);
-  const scoped_ptr<RegExpInput> number_copy(
-      reg_exps_->regexp_factory_->CreateInput(*number));
-  // First attempt to strip the idd_pattern at the start, if present. We make a
-  // copy so that we can revert to the original string if necessary.
-  if (idd_pattern.Consume(number_copy.get())) {
+  // First attempt to strip the IDD at the start, if present. The number is
+  // left untouched unless the prefix is actually stripped.
+  size_t end_of_idd;
+  if (idd_matcher.Consume(*number, &end_of_idd)) {
     // Only strip this if the first digit after the match is not a 0, since
-    // country calling codes cannot begin with 0.
-    string extracted_digit;
-    if (reg_exps_->capturing_digit_pattern_->PartialMatch(
-            number_copy->ToString(), &extracted_digit)) {
-      NormalizeDigitsOnly(&extracted_digit);
-      if (extracted_digit == "0") {
-        return false;
-      }
+    // country calling codes cannot begin with 0. The number has been
+    // normalized, so its digits are ASCII digits.
+    const size_t first_digit = number->find_first_of("0123456789", end_of_idd);
+    if (first_digit != string::npos && (*number)[first_digit] == '0') {
+      return false;
     }
-    number->assign(number_copy->ToString());
+    number->erase(0, end_of_idd);
     return true;
   }
   return false;
@@ -2883,25 +3514,34 @@ bool PhoneNumberUtil::ParsePrefixAsIdd(const RegExp& idd_pattern,
 PhoneNumber::CountryCodeSource
 PhoneNumberUtil::MaybeStripInternationalPrefixAndNormalize(
     const string& possible_idd_prefix,
+    bool utf8_validated,
+    string* number) const {
+  const InternationalPrefixMatcher idd_matcher(
+      possible_idd_prefix, *reg_exps_->regexp_factory_, use_fast_paths_);
+  return MaybeStripInternationalPrefixAndNormalize(&idd_matcher, utf8_validated,
+                                                   number);
+}
+
+PhoneNumber::CountryCodeSource
+PhoneNumberUtil::MaybeStripInternationalPrefixAndNormalize(
+    const InternationalPrefixMatcher* idd_matcher,
+    bool utf8_validated,
     string* number) const {
   DCHECK(number);
   if (number->empty()) {
     return PhoneNumber::FROM_DEFAULT_COUNTRY;
   }
-  const scoped_ptr<RegExpInput> number_string_piece(
-      reg_exps_->regexp_factory_->CreateInput(*number));
-  if (reg_exps_->plus_chars_pattern_->Consume(number_string_piece.get())) {
-    number->assign(number_string_piece->ToString());
+  size_t end_of_plus_chars;
+  if (reg_exps_->plus_chars_pattern_->Consume(*number, &end_of_plus_chars)) {
+    number->erase(0, end_of_plus_chars);
     // Can now normalize the rest of the number since we've consumed the "+"
     // sign at the start.
-    Normalize(number);
+    Normalize(utf8_validated, number);
     return PhoneNumber::FROM_NUMBER_WITH_PLUS_SIGN;
   }
   // Attempt to parse the first digits as an international prefix.
-  const RegExp& idd_pattern =
-      reg_exps_->regexp_cache_->GetRegExp(possible_idd_prefix);
-  Normalize(number);
-  return ParsePrefixAsIdd(idd_pattern, number)
+  Normalize(utf8_validated, number);
+  return idd_matcher && ParsePrefixAsIdd(*idd_matcher, number)
       ? PhoneNumber::FROM_NUMBER_WITH_IDD
       : PhoneNumber::FROM_DEFAULT_COUNTRY;
 }
@@ -3083,18 +3723,28 @@ int PhoneNumberUtil::ExtractCountryCode(string* national_number) const {
 PhoneNumberUtil::ErrorType PhoneNumberUtil::MaybeExtractCountryCode(
     const PhoneMetadata* default_region_metadata,
     bool keep_raw_input,
+    bool utf8_validated,
     string* national_number,
     PhoneNumber* phone_number) const {
   DCHECK(national_number);
   DCHECK(phone_number);
-  // Set the default prefix to be something that will never match if there is no
-  // default region.
-  string possible_country_idd_prefix = default_region_metadata
-      ?  default_region_metadata->international_prefix()
-      : "NonMatch";
+  // No IDD is stripped if there is no default region. The IDD of the default
+  // region is normally precompiled, unless the metadata passed in isn't that of
+  // a supported region.
+  const InternationalPrefixInfo* international_prefix_info =
+      default_region_metadata
+          ? GetInternationalPrefixInfoForRegion(default_region_metadata->id())
+          : NULL;
   PhoneNumber::CountryCodeSource country_code_source =
-      MaybeStripInternationalPrefixAndNormalize(possible_country_idd_prefix,
-                                                national_number);
+      default_region_metadata && !international_prefix_info
+          ? MaybeStripInternationalPrefixAndNormalize(
+                default_region_metadata->international_prefix(),
+                utf8_validated, national_number)
+          : MaybeStripInternationalPrefixAndNormalize(
+                international_prefix_info
+                    ? &international_prefix_info->idd_matcher
+                    : NULL,
+                utf8_validated, national_number);
   if (keep_raw_input) {
     phone_number->set_country_code_source(country_code_source);
   }
@@ -3123,8 +3773,8 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::MaybeExtractCountryCode(
     if (TryStripPrefixString(*national_number,
                              default_country_code_string,
                              &potential_national_number)) {
-      const PhoneNumberDesc& general_num_desc =
-          default_region_metadata->general_desc();
+      const HotMetadata& hot_metadata =
+          GetHotMetadata(*default_region_metadata);
       MaybeStripNationalPrefixAndCarrierCode(*default_region_metadata,
                                              &potential_national_number,
                                              NULL);
@@ -3132,10 +3782,11 @@ PhoneNumberUtil::ErrorType PhoneNumberUtil::MaybeExtractCountryCode(
       // If the number was not valid before but is valid now, or if it was too
       // long before, we consider the number with the country code stripped to
       // be a better result and keep that instead.
-      if ((!IsMatch(*matcher_api_, *national_number, general_num_desc) &&
-          IsMatch(
-              *matcher_api_, potential_national_number, general_num_desc)) ||
-          TestNumberLength(*national_number, *default_region_metadata) ==
+      if ((!MatchesNationalNumberPattern(*national_number, hot_metadata,
+                                         UNKNOWN) &&
+          MatchesNationalNumberPattern(potential_national_number, hot_metadata,
+                                       UNKNOWN)) ||
+          TestNumberLengthForType(*national_number, hot_metadata, UNKNOWN) ==
               TOO_LONG) {
         national_number->assign(potential_national_number);
         if (keep_raw_input) {
@@ -42,13 +42,19 @@ using google::protobuf::RepeatedPtrField;
 using std::string;
 
 class AsYouTypeFormatter;
+class ExecutionBudget;
+class Executor;
+class HotMetadata;
+class InternationalPrefixMatcher;
 class Logger;
 class MatcherApi;
 class NumberFormat;
+class PatternPool;
 class PhoneMetadata;
 class PhoneNumberDesc;
 class PhoneNumberRegExpsAndMappings;
 class RegExp;
+struct TelUri;
 
 // NOTE: A lot of methods in this class require Region Code strings. These must
 // be provided using CLDR two-letter region-code format. These should be in
@@ -58,8 +64,10 @@ class RegExp;
 class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
  private:
   friend class AsYouTypeFormatter;
+  friend class DifferentialChecker;
   friend class PhoneNumberMatcher;
   friend class PhoneNumberMatcherRegExps;
+  friend class PhoneNumberGenerator;
   friend class PhoneNumberMatcherTest;
   friend class PhoneNumberRegExpsAndMappings;
   friend class PhoneNumberUtilTest;
@@ -147,9 +155,12 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
     TOO_SHORT_AFTER_IDD,
     TOO_SHORT_NSN,
     TOO_LONG_NSN,  // TOO_LONG in the java version.
+    // The execution budget given to ParseWithBudget() ran out. This doesn't
+    // tell anything about the validity of the input.
+    DEADLINE_EXCEEDED,
   };
 
-  static const ErrorType kMaxErrorType = TOO_LONG_NSN;
+  static const ErrorType kMaxErrorType = DEADLINE_EXCEEDED;
 
   // Possible outcomes when testing if a PhoneNumber is possible.
   enum ValidationResult {
@@ -177,6 +188,34 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
 
   static const ValidationResult kMaxValidationResult = TOO_LONG;
 
+  // A range of characters of a national significant number.
+  struct Span {
+    Span() : start(0), length(0) {}
+    Span(int start, int length) : start(start), length(length) {}
+
+    int start;
+    int length;
+  };
+
+  // Structure of a phone number, as returned by Decompose(). All the spans are
+  // relative to national_significant_number.
+  struct NumberDecomposition {
+    NumberDecomposition()
+        : country_calling_code(0),
+          number_type(UNKNOWN) {}
+
+    int country_calling_code;
+    string national_significant_number;
+    PhoneNumberType number_type;
+    // Empty if the number has no national destination code (NDC). For mobile
+    // numbers of countries using a mobile token, the NDC includes the token.
+    Span national_destination_code;
+    // The groups of digits following the NDC when the number is formatted in
+    // the INTERNATIONAL format, or the whole national significant number if it
+    // can't be split.
+    std::vector<Span> subscriber_number_groups;
+  };
+
   // Returns all regions the library has metadata for.
   // @returns an unordered set of the two-letter region codes for every
   // geographical region the library supports
@@ -330,6 +369,17 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
   // GetLengthOfGeographicalAreaCode().
   int GetLengthOfNationalDestinationCode(const PhoneNumber& number) const;
 
+  // Splits the phone number passed in into its country calling code, its
+  // national destination code (NDC) and the groups of digits of its subscriber
+  // number, following the digit groups of the INTERNATIONAL format, and also
+  // reports its type. This is cheaper than formatting the number and calling
+  // GetLengthOfNationalDestinationCode() and GetNumberType() separately.
+  //
+  // For example, +1 650 253 0000 is decomposed into the NDC "650" and the
+  // subscriber number groups "253" and "0000", as spans of "6502530000".
+  void Decompose(const PhoneNumber& number,
+                 NumberDecomposition* decomposition) const;
+
   // Returns the mobile token for the provided country calling code if it has
   // one, otherwise returns an empty string. A mobile token is a number inserted
   // before the area code when dialing a mobile number from that country from
@@ -722,6 +772,43 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
                                  const string& default_region,
                                  PhoneNumber* number) const;
 
+  // Same as Parse(), but gives up once budget is exhausted, in which case
+  // DEADLINE_EXCEEDED is returned and number is left unchanged. This bounds the
+  // time spent on adversarial input, such as very long runs of digits and
+  // punctuation. Every regular expression evaluated consumes a step of budget,
+  // which may be shared by several calls.
+  ErrorType ParseWithBudget(const string& number_to_parse,
+                            const string& default_region,
+                            ExecutionBudget* budget,
+                            PhoneNumber* number) const;
+
+  // Parses each string of numbers_to_parse as Parse() does, or as
+  // ParseAndKeepRawInput() does when keep_raw_input is true. The resulting
+  // PhoneNumber messages, including their strings, are all allocated on arena
+  // so that they can be released at once by destroying or resetting it.
+  //
+  // The i-th element of numbers points to the number parsed from the i-th
+  // element of numbers_to_parse, and the i-th element of errors holds the
+  // result of parsing it. Numbers that failed to parse are left empty. Both
+  // vectors are cleared first.
+  void ParseBatch(const std::vector<string>& numbers_to_parse,
+                  const string& default_region,
+                  bool keep_raw_input,
+                  google::protobuf::Arena* arena,
+                  std::vector<PhoneNumber*>* numbers,
+                  std::vector<ErrorType>* errors) const;
+
+  // Same as ParseBatch() above, but parses the numbers on the threads of
+  // executor as well as the calling one. The results are the same, in the same
+  // order. executor may be NULL.
+  void ParseBatch(const std::vector<string>& numbers_to_parse,
+                  const string& default_region,
+                  bool keep_raw_input,
+                  google::protobuf::Arena* arena,
+                  Executor* executor,
+                  std::vector<PhoneNumber*>* numbers,
+                  std::vector<ErrorType>* errors) const;
+
   // Takes two phone numbers and compares them for equality.
   //
   // Returns EXACT_MATCH if the country calling code, NSN, presence of a leading
@@ -816,6 +903,10 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
   // Helper class holding useful regular expressions and character mappings.
   scoped_ptr<PhoneNumberRegExpsAndMappings> reg_exps_;
 
+  // The distinct national number patterns of the metadata, referenced by the
+  // hot metadata and compiled once each.
+  scoped_ptr<PatternPool> pattern_pool_;
+
   // A mapping from a country calling code to a RegionCode object which denotes
   // the region represented by that country calling code. Note regions under
   // NANPA share the country calling code 1 and Russia and Kazakhstan share the
@@ -839,8 +930,40 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
   scoped_ptr<absl::node_hash_map<int, PhoneMetadata> >
       country_code_to_non_geographical_metadata_map_;
 
+  // The fields of the metadata read on every parsing and validation call, for
+  // each region and for each country calling code of a non-geographical
+  // entity. They point to the metadata in the maps above.
+  scoped_ptr<absl::node_hash_map<string, HotMetadata> >
+      region_to_hot_metadata_;
+  scoped_ptr<absl::node_hash_map<int, HotMetadata> >
+      country_code_to_non_geographical_hot_metadata_;
+
+  // The international prefix data of a region, precomputed from its metadata so
+  // that international prefixes can be stripped and formatted without running
+  // regular expressions. Defined in phonenumberutil.cc.
+  struct InternationalPrefixInfo;
+
+  // A mapping from a region code to the international prefix data of that
+  // region.
+  scoped_ptr<absl::node_hash_map<string, InternationalPrefixInfo> >
+      region_to_international_prefix_info_;
+
+  // Whether specialized implementations stand in for the evaluation of some
+  // regular expressions, such as those matching international prefixes, and for
+  // the general parsing of tel URIs. The possible lengths and patterns of the
+  // hot metadata, the groups found by Decompose() and the national prefix
+  // recorded when parsing are used under this flag too. They produce the same
+  // results, which the differential tests check against an instance where this
+  // is false.
+  const bool use_fast_paths_;
+
   PhoneNumberUtil();
 
+  // Constructs an instance with the fast paths disabled if use_fast_paths is
+  // false. Note that, like the default constructor, this sets the logger
+  // implementation to the logger of the new instance.
+  explicit PhoneNumberUtil(bool use_fast_paths);
+
   // Returns a regular expression for the possible extensions that may be found
   // in a number, for use when matching.
   const string& GetExtnPatternsForMatching() const;
@@ -867,6 +990,10 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
   // Trims unwanted end characters from a phone number string.
   void TrimUnwantedEndChars(string* number) const;
 
+  // Replaces number with the part captured by kCaptureUpToSecondNumberStart,
+  // if it matches. Returns true if it does.
+  static bool MaybeStripSecondNumber(string* number);
+
   // Helper function to check region code is not unknown or null.
   bool IsValidRegionCode(const string& region_code) const;
 
@@ -883,10 +1010,54 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
       int country_calling_code,
       const string& region_code) const;
 
+  // Same as the functions above, for the hot metadata.
+  const HotMetadata* GetHotMetadataForRegion(const string& region_code) const;
+
+  const HotMetadata* GetHotMetadataForRegionOrCallingCode(
+      int country_calling_code,
+      const string& region_code) const;
+
+  // Returns the hot metadata of metadata, which must belong to this instance.
+  const HotMetadata& GetHotMetadata(const PhoneMetadata& metadata) const;
+
+  // Checks the length of number against the possible lengths of type in
+  // metadata, and determines whether it matches, or is too short or too long.
+  ValidationResult TestNumberLengthForType(const string& number,
+                                           const HotMetadata& metadata,
+                                           PhoneNumberType type) const;
+
+  // Returns whether national_number matches the national number pattern of
+  // type, without checking its possible lengths.
+  bool MatchesNationalNumberPattern(const string& national_number,
+                                    const HotMetadata& metadata,
+                                    PhoneNumberType type) const;
+
+  // Same as the protected IsNumberMatchingDesc(), for the number description
+  // of type. The possible lengths are checked without reading the description.
+  bool IsNumberMatchingDesc(const string& national_number,
+                            const HotMetadata& metadata,
+                            PhoneNumberType type) const;
+
+  // Same as the protected GetNumberTypeHelper(), without looking the hot
+  // metadata up.
+  PhoneNumberUtil::PhoneNumberType GetNumberTypeHelper(
+      const string& national_number, const HotMetadata& metadata) const;
+
   // As per GetCountryCodeForRegion, but assumes the validity of the region_code
   // has already been checked.
   int GetCountryCodeForValidRegion(const string& region_code) const;
 
+  // Implements Decompose() for a number whose type is already known.
+  void DecomposeWithType(const PhoneNumber& number,
+                         PhoneNumberType number_type,
+                         NumberDecomposition* decomposition) const;
+
+  // Implements GetLengthOfNationalDestinationCode() by formatting the number
+  // and splitting the result, as before Decompose() existed. Only used when
+  // the fast paths are disabled.
+  int GetLengthOfNationalDestinationCodeFromFormat(
+      const PhoneNumber& number) const;
+
   const NumberFormat* ChooseFormattingPatternForNumber(
       const RepeatedPtrField<NumberFormat>& available_formats,
       const string& national_number) const;
@@ -904,14 +1075,13 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
       PhoneNumberUtil::PhoneNumberFormat number_format,
       string* formatted_number) const;
 
-  // Check if raw_input, which is assumed to be in the national format, has a
-  // national prefix. The national prefix is assumed to be in digits-only form.
+  // Check if the raw input of number, which is assumed to be in the national
+  // format, has a national prefix. national_number is the national significant
+  // number of number. The national prefix is assumed to be in digits-only form.
   bool RawInputContainsNationalPrefix(
-      const string& raw_input,
-      const string& national_prefix,
-      const string& region_code) const;
-
-  bool HasFormattingPatternForNumber(const PhoneNumber& number) const;
+      const PhoneNumber& number,
+      const string& national_number,
+      const string& national_prefix) const;
 
   // Simple wrapper of FormatNsnWithCarrier for the common case of
   // no carrier code.
@@ -937,14 +1107,44 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
       const std::list<string>& region_codes,
       string* region_code) const;
 
+  // Returns the international prefix data of the region, or NULL if there is
+  // no metadata for it.
+  const InternationalPrefixInfo* GetInternationalPrefixInfoForRegion(
+      const string& region_code) const;
+
   // Strips the IDD from the start of the number if present. Helper function
   // used by MaybeStripInternationalPrefixAndNormalize.
-  bool ParsePrefixAsIdd(const RegExp& idd_pattern, string* number) const;
+  bool ParsePrefixAsIdd(const InternationalPrefixMatcher& idd_matcher,
+                        string* number) const;
+
+  // If utf8_validated is true, number is already known to be
+  // interchange-valid UTF-8, and isn't validated again. This is the case of
+  // the numbers extracted by ExtractPossibleNumber().
+  void Normalize(bool utf8_validated, string* number) const;
 
-  void Normalize(string* number) const;
+  // Same as NormalizeDigitsOnly(), without validating a number already known to
+  // be interchange-valid UTF-8 again.
+  void NormalizeDigits(bool utf8_validated, string* number) const;
+
+  // Returns true if number has at least three letters, which is when
+  // valid_alpha_phone_pattern_ partially matches it.
+  static bool ContainsAlphaPhoneLetters(const string& number);
+
+  // Returns true if number is a single line ending with a letter and has at
+  // least three letters, which is when valid_alpha_phone_pattern_ fully matches
+  // it.
+  static bool FullyMatchesAlphaPhoneLetters(const string& number);
 
   PhoneNumber::CountryCodeSource MaybeStripInternationalPrefixAndNormalize(
       const string& possible_idd_prefix,
+      bool utf8_validated,
+      string* number) const;
+
+  // Same as above, with the IDD of the region the number may be dialed in
+  // already compiled. No IDD is stripped if idd_matcher is NULL.
+  PhoneNumber::CountryCodeSource MaybeStripInternationalPrefixAndNormalize(
+      const InternationalPrefixMatcher* idd_matcher,
+      bool utf8_validated,
       string* number) const;
 
   bool MaybeStripNationalPrefixAndCarrierCode(
@@ -963,6 +1163,7 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
   ErrorType MaybeExtractCountryCode(
       const PhoneMetadata* default_region_metadata,
       bool keepRawInput,
+      bool utf8_validated,
       string* national_number,
       PhoneNumber* phone_number) const;
 
@@ -983,6 +1184,15 @@ class PhoneNumberUtil : public Singleton<PhoneNumberUtil> {
   bool IsPhoneContextValid(absl::optional<string> phone_context) const;
 
   ErrorType BuildNationalNumberForParsing(const string& number_to_parse,
+                                          string* national_number,
+                                          bool* utf8_validated) const;
+
+  // Same as BuildNationalNumberForParsing() without regular expressions, for a
+  // tel URI made of ASCII characters with a valid phone-context, if any.
+  // Returns false if the general code path is needed instead, in which case
+  // national_number is left unchanged.
+  bool MaybeBuildNationalNumberFromTelUri(const string& number_to_parse,
+                                          const TelUri& tel_uri,
                                           string* national_number) const;
 
   bool IsShorterThanPossibleNormalNumber(const PhoneMetadata* country_metadata,
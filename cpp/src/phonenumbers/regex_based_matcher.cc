@@ -57,11 +57,7 @@ bool RegexBasedMatcher::Match(
   if (regexp.FullMatch(number)) {
     return true;
   }
-  const scoped_ptr<RegExpInput> normalized_number_input(
-      regexp_factory_->CreateInput(number));
-  return regexp.Consume(normalized_number_input.get())
-      ? allow_prefix_match
-      : false;
+  return allow_prefix_match && regexp.Consume(number, NULL);
 }
 
 }  // namespace phonenumbers
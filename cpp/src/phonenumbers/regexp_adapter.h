@@ -28,6 +28,8 @@
 #include <cstddef>
 #include <string>
 
+#include "absl/strings/string_view.h"
+
 namespace i18n {
 namespace phonenumbers {
 
@@ -132,6 +134,24 @@ class RegExp {
     	           NULL);
   }
 
+  // Matches the regular expression against the UTF-8 string 'input', starting
+  // at byte offset 'start', without the need to create a RegExpInput. This is
+  // the preferred overload on hot paths since it neither copies nor transcodes
+  // the input.
+  // anchor_at_start - if true, match would be successful only if it begins at
+  // 'start', otherwise it can begin anywhere after it.
+  // end - if not NULL, set to the byte offset just past the match on success.
+  virtual bool Consume(absl::string_view input,
+                       size_t start,
+                       bool anchor_at_start,
+                       size_t* end) const = 0;
+
+  // Helper method calling the Consume method above that assumes the match must
+  // start at the beginning of the input.
+  inline bool Consume(absl::string_view input, size_t* end) const {
+    return Consume(input, 0, true, end);
+  }
+
   // Matches string to regular expression, returns true if the expression was
   // matched, false otherwise.
   // input_string - string to be searched.
@@ -22,16 +22,19 @@
 #include "phonenumbers/regexp_adapter_icu.h"
 
 #include <stddef.h>
+#include <atomic>
 #include <string>
 
 #include <unicode/regex.h>
 #include <unicode/stringpiece.h>
 #include <unicode/unistr.h>
+#include <unicode/utext.h>
 
 #include "phonenumbers/base/basictypes.h"
 #include "phonenumbers/base/logging.h"
 #include "phonenumbers/base/memory/scoped_ptr.h"
 #include "phonenumbers/default_logger.h"
+#include "phonenumbers/execution_budget.h"
 #include "phonenumbers/string_byte_sink.h"
 
 namespace i18n {
@@ -57,6 +60,37 @@ UnicodeString Utf8StringToUnicodeString(const string& source) {
       icu::StringPiece(source.c_str(), static_cast<int>(source.size())));
 }
 
+// Accounts for a match against the execution budget of the current thread, if
+// any, and limits the work of matcher to the time left before its deadline.
+// Returns false if the budget is exhausted, in which case the match mustn't be
+// attempted.
+bool StartMatch(RegexMatcher* matcher) {
+  ExecutionBudget* const budget = ExecutionBudget::Current();
+  if (budget && !budget->Consume()) {
+    return false;
+  }
+  // The time limit is counted in steps of the match engine, which take roughly
+  // a millisecond each. It is reset when there is no deadline, since matchers
+  // are reused across calls.
+  const int32 time_limit = budget ? budget->RemainingMilliseconds() : 0;
+  if (time_limit > 0 || matcher->getTimeLimit() > 0) {
+    UErrorCode status = U_ZERO_ERROR;
+    matcher->setTimeLimit(time_limit, status);
+  }
+  return true;
+}
+
+// Exhausts the execution budget of the current thread if the matcher ran out of
+// time.
+void FinishMatch(UErrorCode status) {
+  if (status == U_REGEX_TIME_OUT) {
+    ExecutionBudget* const budget = ExecutionBudget::Current();
+    if (budget) {
+      budget->MarkExhausted();
+    }
+  }
+}
+
 }  // namespace
 
 // Implementation of the abstract classes RegExpInput and RegExp using ICU
@@ -105,7 +139,7 @@ class IcuRegExpInput : public RegExpInput {
 // ICU implementation of the RegExp abstract class.
 class IcuRegExp : public RegExp {
  public:
-  explicit IcuRegExp(const string& utf8_regexp) {
+  explicit IcuRegExp(const string& utf8_regexp) : cached_matcher_(NULL) {
     UParseError parse_error;
     UErrorCode status = U_ZERO_ERROR;
     utf8_regexp_.reset(RegexPattern::compile(
@@ -121,7 +155,9 @@ class IcuRegExp : public RegExp {
   IcuRegExp(const IcuRegExp&) = delete;
   IcuRegExp& operator=(const IcuRegExp&) = delete; 
 
-  virtual ~IcuRegExp() {}
+  virtual ~IcuRegExp() {
+    delete cached_matcher_.load(std::memory_order_relaxed);
+  }
 
   virtual bool Consume(RegExpInput* input_string,
                        bool anchor_at_start,
@@ -137,11 +173,15 @@ class IcuRegExp : public RegExp {
     }
     IcuRegExpInput* const input = static_cast<IcuRegExpInput*>(input_string);
     UErrorCode status = U_ZERO_ERROR;
-    const scoped_ptr<RegexMatcher> matcher(
-        utf8_regexp_->matcher(*input->Data(), status));
+    const ScopedMatcher matcher(*this);
+    if (!matcher.get() || !StartMatch(matcher.get())) {
+      return false;
+    }
+    matcher->reset(*input->Data());
     bool match_succeeded = anchor_at_start
         ? matcher->lookingAt(input->position(), status)
         : matcher->find(input->position(), status);
+    FinishMatch(status);
     if (!match_succeeded || U_FAILURE(status)) {
       return false;
     }
@@ -164,6 +204,37 @@ class IcuRegExp : public RegExp {
     return !U_FAILURE(status);
   }
 
+  virtual bool Consume(absl::string_view input,
+                       size_t start,
+                       bool anchor_at_start,
+                       size_t* end) const {
+    if (!utf8_regexp_.get()) {
+      return false;
+    }
+    // The UText wraps the UTF-8 data in place, so that native indexes are byte
+    // offsets and no conversion to UTF-16 takes place.
+    const ScopedMatcher matcher(*this);
+    if (!matcher.get() || !StartMatch(matcher.get())) {
+      return false;
+    }
+    UErrorCode status = U_ZERO_ERROR;
+    utext_openUTF8(matcher.text(), input.data(),
+                   static_cast<int64_t>(input.size()), &status);
+    if (U_FAILURE(status)) {
+      return false;
+    }
+    matcher->reset(matcher.text());
+    const int64_t start_index = static_cast<int64_t>(start);
+    bool match_succeeded = anchor_at_start
+        ? matcher->lookingAt(start_index, status)
+        : matcher->find(start_index, status);
+    FinishMatch(status);
+    if (match_succeeded && !U_FAILURE(status) && end) {
+      *end = static_cast<size_t>(matcher->end64(status));
+    }
+    return match_succeeded && !U_FAILURE(status);
+  }
+
   bool Match(const string& input_string,
              bool full_match,
              string* matched_string) const {
@@ -172,11 +243,15 @@ class IcuRegExp : public RegExp {
     }
     IcuRegExpInput input(input_string);
     UErrorCode status = U_ZERO_ERROR;
-    const scoped_ptr<RegexMatcher> matcher(
-        utf8_regexp_->matcher(*input.Data(), status));
+    const ScopedMatcher matcher(*this);
+    if (!matcher.get() || !StartMatch(matcher.get())) {
+      return false;
+    }
+    matcher->reset(*input.Data());
     bool match_succeeded = full_match
         ? matcher->matches(input.position(), status)
         : matcher->find(input.position(), status);
+    FinishMatch(status);
     if (!match_succeeded || U_FAILURE(status)) {
       return false;
     }
@@ -195,16 +270,17 @@ class IcuRegExp : public RegExp {
     }
     IcuRegExpInput input(*string_to_process);
     UErrorCode status = U_ZERO_ERROR;
-    const scoped_ptr<RegexMatcher> matcher(
-        utf8_regexp_->matcher(*input.Data(), status));
-    if (U_FAILURE(status)) {
+    const ScopedMatcher matcher(*this);
+    if (!matcher.get() || !StartMatch(matcher.get())) {
       return false;
     }
+    matcher->reset(*input.Data());
 
     UnicodeString output;
     // We reimplement ReplaceFirst and ReplaceAll such that their behaviour is
     // consistent with the RE2 reg-ex matcher.
-    if (!matcher->find()) {
+    if (!matcher->find(status)) {
+      FinishMatch(status);
       return false;
     }
     matcher->appendReplacement(output,
@@ -212,7 +288,7 @@ class IcuRegExp : public RegExp {
                                status);
     if (global) {
       // Continue and look for more matches.
-      while (matcher->find()) {
+      while (matcher->find(status)) {
         matcher->appendReplacement(
             output,
             Utf8StringToUnicodeString(replacement_string),
@@ -220,6 +296,7 @@ class IcuRegExp : public RegExp {
       }
     }
 
+    FinishMatch(status);
     matcher->appendTail(output);
     if (U_FAILURE(status)) {
       return false;
@@ -230,7 +307,75 @@ class IcuRegExp : public RegExp {
   }
 
  private:
+  // A matcher of the regular expression, and the UText wrapping the UTF-8
+  // input of its last match, whose storage is reused by the next one.
+  struct MatcherState {
+    MatcherState() : text(UTEXT_INITIALIZER) {}
+
+    ~MatcherState() {
+      utext_close(&text);
+    }
+
+    scoped_ptr<RegexMatcher> matcher;
+    UText text;
+  };
+
+  // Lends the matcher cached by a regular expression for the lifetime of this
+  // object, or a new matcher if another thread is using it, so that matching
+  // doesn't allocate a matcher each time. The matcher is cached again
+  // afterwards unless another one was meanwhile. The input of the matcher must
+  // be reset before use.
+  class ScopedMatcher {
+   public:
+    explicit ScopedMatcher(const IcuRegExp& regexp)
+        : regexp_(regexp),
+          state_(regexp.cached_matcher_.exchange(NULL,
+                                                 std::memory_order_acquire)) {
+      if (!state_) {
+        UErrorCode status = U_ZERO_ERROR;
+        state_ = new MatcherState();
+        state_->matcher.reset(regexp.utf8_regexp_->matcher(status));
+        if (U_FAILURE(status)) {
+          delete state_;
+          state_ = NULL;
+        }
+      }
+    }
+
+    ~ScopedMatcher() {
+      MatcherState* cached_state = NULL;
+      if (state_ && !regexp_.cached_matcher_.compare_exchange_strong(
+                        cached_state, state_, std::memory_order_release)) {
+        delete state_;
+      }
+    }
+
+    // This type is neither copyable nor movable.
+    ScopedMatcher(const ScopedMatcher&) = delete;
+    ScopedMatcher& operator=(const ScopedMatcher&) = delete;
+
+    // Returns NULL if the matcher couldn't be created.
+    RegexMatcher* get() const {
+      return state_ ? state_->matcher.get() : NULL;
+    }
+
+    RegexMatcher* operator->() const {
+      return state_->matcher.get();
+    }
+
+    // The UText to wrap UTF-8 input in.
+    UText* text() const {
+      return &state_->text;
+    }
+
+   private:
+    const IcuRegExp& regexp_;
+    MatcherState* state_;
+  };
+
   scoped_ptr<RegexPattern> utf8_regexp_;
+  // The matcher lent by ScopedMatcher when no call is using it, or NULL.
+  mutable std::atomic<MatcherState*> cached_matcher_;
 };
 
 RegExpInput* ICURegExpFactory::CreateInput(const string& utf8_input) const {
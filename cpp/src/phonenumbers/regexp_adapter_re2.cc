@@ -25,6 +25,7 @@
 
 #include "phonenumbers/base/basictypes.h"
 #include "phonenumbers/base/logging.h"
+#include "phonenumbers/execution_budget.h"
 #include "phonenumbers/stringutil.h"
 
 #include "absl/strings/string_view.h"
@@ -73,6 +74,14 @@ bool DispatchRE2Call(Function regex_function,
   return regex_function(input, regexp, args, argc);
 }
 
+// Accounts for a match against the execution budget of the current thread, if
+// any. Returns false if the budget is exhausted, in which case the match mustn't
+// be attempted. As RE2 runs in linear time, a match needs no other limit.
+bool StartMatch() {
+  ExecutionBudget* const budget = ExecutionBudget::Current();
+  return !budget || budget->Consume();
+}
+
 // Replaces unescaped dollar-signs with backslashes. Backslashes are deleted
 // when they escape dollar-signs.
 string TransformRegularExpressionToRE2Syntax(const string& regex) {
@@ -105,6 +114,9 @@ class RE2RegExp : public RegExp {
                        string* matched_string5,
                        string* matched_string6) const {
     DCHECK(input_string);
+    if (!StartMatch()) {
+      return false;
+    }
     StringPiece* utf8_input =
         static_cast<RE2RegExpInput*>(input_string)->Data();
 
@@ -121,9 +133,33 @@ class RE2RegExp : public RegExp {
     }
   }
 
+  virtual bool Consume(absl::string_view input,
+                       size_t start,
+                       bool anchor_at_start,
+                       size_t* end) const {
+    if (start > input.size() || !StartMatch()) {
+      return false;
+    }
+    const StringPiece text(input.data(), input.size());
+    StringPiece match;
+    if (!utf8_regexp_.Match(text, start, text.size(),
+                            anchor_at_start ? RE2::ANCHOR_START
+                                            : RE2::UNANCHORED,
+                            &match, 1)) {
+      return false;
+    }
+    if (end) {
+      *end = static_cast<size_t>(match.data() + match.size() - text.data());
+    }
+    return true;
+  }
+
   virtual bool Match(const string& input_string,
                      bool full_match,
                      string* matched_string) const {
+    if (!StartMatch()) {
+      return false;
+    }
     if (full_match) {
       return DispatchRE2Call(RE2::FullMatchN, input_string, utf8_regexp_,
                              matched_string, NULL, NULL, NULL, NULL, NULL);
@@ -137,6 +173,9 @@ class RE2RegExp : public RegExp {
                        bool global,
                        const string& replacement_string) const {
     DCHECK(string_to_process);
+    if (!StartMatch()) {
+      return false;
+    }
     const string re2_replacement_string =
         TransformRegularExpressionToRE2Syntax(replacement_string);
     if (global) {
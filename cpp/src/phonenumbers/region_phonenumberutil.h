@@ -0,0 +1,735 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// RegionPhoneNumberUtil parses, validates and formats the phone numbers of a
+// single region, for builds such as firmware which only ever handle the numbers
+// of one country and can't afford the protocol buffer, ICU and regular
+// expression libraries. It is header-only: the metadata of the region is a
+// constant RegionMetadata generated at build time by the
+// generate_region_metadata tool, which compiles the patterns of the metadata
+// into deterministic automata over the digits, and the template is
+// instantiated with it:
+//
+//   generate_region_metadata --output=region_metadata_de.h DE
+//
+// #include "region_metadata_de.h"
+//
+// RegionPhoneNumber number;
+// if (RegionPhoneNumberUtilDE::Parse("030 123456", &number) ==
+//         RegionPhoneNumberUtilDE::NO_PARSING_ERROR &&
+//     RegionPhoneNumberUtilDE::IsValidNumber(number)) {
+//   string formatted;
+//   RegionPhoneNumberUtilDE::Format(
+//       number, RegionPhoneNumberUtilDE::INTERNATIONAL, &formatted);
+// }
+//
+// The results are those of PhoneNumberUtil for the numbers of the region, with
+// these restrictions:
+// - Parse() accepts the numbers written with ASCII digits, leading plus signs
+//   and the ASCII punctuation " -./()[]". It returns NOT_A_NUMBER for other
+//   input, such as numbers with letters or extensions.
+// - Numbers with the country calling code of another country are not
+//   supported: Parse() returns INVALID_COUNTRY_CODE_ERROR for them, and they
+//   are neither valid nor possible.
+// - IsValidNumber() is PhoneNumberUtil::IsValidNumberForRegion() for the
+//   region, which only differs from IsValidNumber() for the regions sharing
+//   their country calling code with others.
+
+#ifndef I18N_PHONENUMBERS_REGION_PHONENUMBERUTIL_H_
+#define I18N_PHONENUMBERS_REGION_PHONENUMBERUTIL_H_
+
+#include <cstddef>
+#include <string>
+
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+// The counterpart of the PhoneNumber message for RegionPhoneNumberUtil.
+struct RegionPhoneNumber {
+  RegionPhoneNumber()
+      : country_code(0),
+        national_number(0),
+        italian_leading_zero(false),
+        number_of_leading_zeros(1) {}
+
+  int32 country_code;
+  uint64 national_number;
+  bool italian_leading_zero;
+  int32 number_of_leading_zeros;
+};
+
+// A deterministic automaton over the ASCII digits. State 0 rejects every
+// input and state 1 is the initial state; transitions[10 * state + digit] is
+// the state reached from state on digit. A NULL automaton matches nothing.
+struct DigitAutomaton {
+  const uint16* transitions;
+  // Non-zero for the accepting states.
+  const uint8* accepting;
+};
+
+// A prefix of fixed length, each digit of which is in a set of digits. Bit d
+// of digits[i] is set if digit d may be the i-th digit of the prefix.
+struct DigitPrefix {
+  const uint16* digits;
+  int length;
+};
+
+// A number format, the counterpart of the NumberFormat message.
+struct RegionNumberFormat {
+  // The last leading digits pattern of the format, matched at the start of the
+  // number, or a NULL automaton if it has none.
+  DigitAutomaton leading_digits;
+  // The capturing groups of the pattern, which is their concatenation.
+  const DigitAutomaton* groups;
+  int num_groups;
+  // The format, with the national prefix formatting rule already applied for
+  // the national formats.
+  const char* format;
+};
+
+// The metadata of a region, generated by generate_region_metadata.
+struct RegionMetadata {
+  // The number types, in the order of PhoneNumberUtil::PhoneNumberType.
+  static const int kNumTypes = 12;
+  static const int kUnknownType = kNumTypes - 1;
+
+  const char* region_code;
+  int country_code;
+  // The country calling codes of all the regions and non-geographical
+  // entities, in ascending order.
+  const int* country_codes;
+  int num_country_codes;
+  // The prefixes matched by the international and national prefix patterns,
+  // in the order a regular expression engine tries them.
+  const DigitPrefix* international_prefixes;
+  int num_international_prefixes;
+  const DigitPrefix* national_prefixes;
+  int num_national_prefixes;
+  // Indexed by number type, the last one being the general description. Bit n
+  // of the possible lengths is set if n is a possible length, 0 if the
+  // description has no possible lengths of its own.
+  uint32 possible_lengths[kNumTypes];
+  uint32 local_only_lengths[kNumTypes];
+  DigitAutomaton national_number_patterns[kNumTypes];
+  // Bit type is set if there is no number of this type.
+  uint32 types_without_numbers;
+  bool same_mobile_and_fixed_line_pattern;
+  const RegionNumberFormat* national_formats;
+  int num_national_formats;
+  // The formats used for the international and RFC3966 formats.
+  const RegionNumberFormat* international_formats;
+  int num_international_formats;
+};
+
+// The enums and the implementation of RegionPhoneNumberUtil, which don't
+// depend on the region.
+class RegionPhoneNumberUtilBase {
+ public:
+  // These enums have the same values as those of PhoneNumberUtil.
+  enum PhoneNumberFormat {
+    E164,
+    INTERNATIONAL,
+    NATIONAL,
+    RFC3966
+  };
+
+  enum PhoneNumberType {
+    FIXED_LINE,
+    MOBILE,
+    FIXED_LINE_OR_MOBILE,
+    TOLL_FREE,
+    PREMIUM_RATE,
+    SHARED_COST,
+    VOIP,
+    PERSONAL_NUMBER,
+    PAGER,
+    UAN,
+    VOICEMAIL,
+    UNKNOWN
+  };
+
+  enum ErrorType {
+    NO_PARSING_ERROR,
+    INVALID_COUNTRY_CODE_ERROR,
+    NOT_A_NUMBER,
+    TOO_SHORT_AFTER_IDD,
+    TOO_SHORT_NSN,
+    TOO_LONG_NSN,
+  };
+
+  enum ValidationResult {
+    IS_POSSIBLE,
+    IS_POSSIBLE_LOCAL_ONLY,
+    INVALID_COUNTRY_CODE,
+    TOO_SHORT,
+    INVALID_LENGTH,
+    TOO_LONG,
+  };
+
+ protected:
+  static const size_t kMinLengthForNsn = 2;
+  static const size_t kMaxLengthForNsn = 17;
+  static const size_t kMaxLengthCountryCode = 3;
+
+  static bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  // Returns whether c is one of the ASCII characters of
+  // PhoneNumberUtil::kValidPunctuation accepted by Parse(). 'x' and '~' aren't,
+  // as they may start an extension.
+  static bool IsPunctuation(char c) {
+    switch (c) {
+      case ' ': case '-': case '.': case '/': case '(': case ')': case '[':
+      case ']':
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  static bool FullMatch(const DigitAutomaton& automaton, const char* digits,
+                        size_t length) {
+    if (!automaton.transitions) {
+      return false;
+    }
+    int state = 1;
+    for (size_t i = 0; i < length && state != 0; ++i) {
+      state = automaton.transitions[10 * state + (digits[i] - '0')];
+    }
+    return automaton.accepting[state] != 0;
+  }
+
+  // Returns whether automaton matches a prefix of digits, as RegExp::Consume()
+  // does. True if there is no automaton.
+  static bool MatchesPrefix(const DigitAutomaton& automaton,
+                            const char* digits, size_t length) {
+    if (!automaton.transitions) {
+      return true;
+    }
+    int state = 1;
+    for (size_t i = 0; !automaton.accepting[state]; ++i) {
+      if (i == length) {
+        return false;
+      }
+      state = automaton.transitions[10 * state + (digits[i] - '0')];
+      if (state == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns the length of the first of prefixes digits starts with, or -1.
+  static int ConsumePrefix(const DigitPrefix* prefixes, int num_prefixes,
+                           const string& digits) {
+    for (int i = 0; i < num_prefixes; ++i) {
+      const DigitPrefix& prefix = prefixes[i];
+      if (static_cast<size_t>(prefix.length) > digits.length()) {
+        continue;
+      }
+      int j = 0;
+      while (j < prefix.length &&
+             (prefix.digits[j] >> (digits[j] - '0')) & 1) {
+        ++j;
+      }
+      if (j == prefix.length) {
+        return prefix.length;
+      }
+    }
+    return -1;
+  }
+
+  static bool HasLength(uint32 lengths, size_t length) {
+    return length < 32 && (lengths >> length) & 1;
+  }
+
+  static bool IsNumberMatchingDesc(const RegionMetadata& metadata,
+                                   const string& national_number, int type) {
+    const size_t length = national_number.length();
+    if (metadata.possible_lengths[type] != 0 &&
+        !HasLength(metadata.possible_lengths[type], length)) {
+      return false;
+    }
+    if ((metadata.types_without_numbers >> type) & 1) {
+      // A possible length of -1 is never matched.
+      return false;
+    }
+    return FullMatch(metadata.national_number_patterns[type],
+                     national_number.data(), length);
+  }
+
+  // The same as PhoneNumberUtil::TestNumberLength() for the general
+  // description.
+  static ValidationResult TestNumberLength(const RegionMetadata& metadata,
+                                           size_t length) {
+    const int type = RegionMetadata::kUnknownType;
+    const uint32 possible_lengths =
+        (metadata.types_without_numbers >> type) & 1
+            ? 0 : metadata.possible_lengths[type];
+    if (possible_lengths == 0) {
+      return INVALID_LENGTH;
+    }
+    if (HasLength(metadata.local_only_lengths[type], length)) {
+      return IS_POSSIBLE_LOCAL_ONLY;
+    }
+    if (HasLength(possible_lengths, length)) {
+      return IS_POSSIBLE;
+    }
+    if (length < 32 && (possible_lengths & ((uint32{1} << length) - 1)) == 0) {
+      return TOO_SHORT;
+    }
+    if (length >= 32 || possible_lengths >> length == 0) {
+      return TOO_LONG;
+    }
+    return INVALID_LENGTH;
+  }
+
+  static PhoneNumberType GetNumberTypeHelper(const RegionMetadata& metadata,
+                                             const string& national_number) {
+    if (!IsNumberMatchingDesc(metadata, national_number, UNKNOWN)) {
+      return UNKNOWN;
+    }
+    static const PhoneNumberType kTypesInOrder[] = {
+      PREMIUM_RATE, TOLL_FREE, SHARED_COST, VOIP, PERSONAL_NUMBER, PAGER, UAN,
+      VOICEMAIL,
+    };
+    for (PhoneNumberType type : kTypesInOrder) {
+      if (IsNumberMatchingDesc(metadata, national_number, type)) {
+        return type;
+      }
+    }
+    if (IsNumberMatchingDesc(metadata, national_number, FIXED_LINE)) {
+      return metadata.same_mobile_and_fixed_line_pattern ||
+             IsNumberMatchingDesc(metadata, national_number, MOBILE)
+          ? FIXED_LINE_OR_MOBILE : FIXED_LINE;
+    }
+    if (!metadata.same_mobile_and_fixed_line_pattern &&
+        IsNumberMatchingDesc(metadata, national_number, MOBILE)) {
+      return MOBILE;
+    }
+    return UNKNOWN;
+  }
+
+  // Strips the national prefix of number, as
+  // PhoneNumberUtil::MaybeStripNationalPrefixAndCarrierCode() does.
+  static void MaybeStripNationalPrefix(const RegionMetadata& metadata,
+                                       string* number) {
+    if (number->empty()) {
+      return;
+    }
+    const int prefix_length = ConsumePrefix(
+        metadata.national_prefixes, metadata.num_national_prefixes, *number);
+    if (prefix_length < 0) {
+      return;
+    }
+    const string stripped_number = number->substr(prefix_length);
+    const DigitAutomaton& general_pattern =
+        metadata.national_number_patterns[UNKNOWN];
+    // The number isn't stripped if it was a viable number before, but isn't
+    // anymore.
+    if (FullMatch(general_pattern, number->data(), number->length()) &&
+        !FullMatch(general_pattern, stripped_number.data(),
+                   stripped_number.length())) {
+      return;
+    }
+    number->assign(stripped_number);
+  }
+
+  // Returns the country calling code number starts with and strips it, or
+  // returns 0 if there is none.
+  static int ExtractCountryCode(const RegionMetadata& metadata,
+                                string* number) {
+    if (number->empty() || (*number)[0] == '0') {
+      return 0;
+    }
+    int country_code = 0;
+    for (size_t i = 0; i < kMaxLengthCountryCode && i < number->length();
+         ++i) {
+      country_code = 10 * country_code + ((*number)[i] - '0');
+      for (int j = 0; j < metadata.num_country_codes; ++j) {
+        if (metadata.country_codes[j] == country_code) {
+          number->erase(0, i + 1);
+          return country_code;
+        }
+      }
+    }
+    return 0;
+  }
+
+  // The same as PhoneNumberUtil::MaybeExtractCountryCode(), with number
+  // already normalized: sets country_code to the country calling code, or to
+  // 0 if number doesn't have one.
+  static ErrorType MaybeExtractCountryCode(const RegionMetadata& metadata,
+                                           bool has_plus_sign, string* number,
+                                           int* country_code) {
+    *country_code = 0;
+    bool has_idd = has_plus_sign;
+    if (!has_plus_sign) {
+      // The international prefix is only stripped if the country calling code
+      // following it doesn't start with 0.
+      const int idd_length = ConsumePrefix(metadata.international_prefixes,
+                                           metadata.num_international_prefixes,
+                                           *number);
+      if (idd_length >= 0 &&
+          (static_cast<size_t>(idd_length) == number->length() ||
+           (*number)[idd_length] != '0')) {
+        number->erase(0, idd_length);
+        has_idd = true;
+      }
+    }
+    if (has_idd) {
+      if (number->length() <= kMinLengthForNsn) {
+        return TOO_SHORT_AFTER_IDD;
+      }
+      *country_code = ExtractCountryCode(metadata, number);
+      return *country_code != 0 ? NO_PARSING_ERROR
+                                : INVALID_COUNTRY_CODE_ERROR;
+    }
+    const string country_code_string = std::to_string(metadata.country_code);
+    if (number->compare(0, country_code_string.length(),
+                        country_code_string) == 0) {
+      string potential_national_number =
+          number->substr(country_code_string.length());
+      MaybeStripNationalPrefix(metadata, &potential_national_number);
+      const DigitAutomaton& general_pattern =
+          metadata.national_number_patterns[UNKNOWN];
+      if ((!FullMatch(general_pattern, number->data(), number->length()) &&
+           FullMatch(general_pattern, potential_national_number.data(),
+                     potential_national_number.length())) ||
+          TestNumberLength(metadata, number->length()) == TOO_LONG) {
+        number->assign(potential_national_number);
+        *country_code = metadata.country_code;
+      }
+    }
+    return NO_PARSING_ERROR;
+  }
+
+  static ErrorType Parse(const RegionMetadata& metadata,
+                         const string& number_to_parse,
+                         RegionPhoneNumber* number) {
+    // Only the characters which may be part of the number are kept, as
+    // PhoneNumberUtil::ExtractPossibleNumber() does.
+    size_t start = 0;
+    while (start < number_to_parse.length() &&
+           !IsDigit(number_to_parse[start]) && number_to_parse[start] != '+') {
+      if (!IsPunctuation(number_to_parse[start])) {
+        return NOT_A_NUMBER;
+      }
+      ++start;
+    }
+    size_t num_plus_signs = 0;
+    while (start + num_plus_signs < number_to_parse.length() &&
+           number_to_parse[start + num_plus_signs] == '+') {
+      ++num_plus_signs;
+    }
+    string national_number;
+    size_t end = start + num_plus_signs;
+    for (size_t i = end; i < number_to_parse.length(); ++i) {
+      const char c = number_to_parse[i];
+      if (IsDigit(c)) {
+        national_number.push_back(c);
+        end = i + 1;
+      } else if (!IsPunctuation(c)) {
+        return NOT_A_NUMBER;
+      }
+    }
+    // This is PhoneNumberUtil::IsViablePhoneNumber(): either two digits, or at
+    // least three digits.
+    const bool is_two_digits =
+        end - start == 2 && num_plus_signs == 0 && national_number.length() == 2;
+    if (end - start < kMinLengthForNsn ||
+        (!is_two_digits && national_number.length() < 3)) {
+      return NOT_A_NUMBER;
+    }
+
+    const string digits = national_number;
+    int country_code;
+    ErrorType error = MaybeExtractCountryCode(metadata, num_plus_signs > 0,
+                                              &national_number, &country_code);
+    if (error != NO_PARSING_ERROR) {
+      if (error != INVALID_COUNTRY_CODE_ERROR || num_plus_signs == 0) {
+        return error;
+      }
+      // The plus sign is ignored, and the number parsed again.
+      national_number = digits;
+      MaybeExtractCountryCode(metadata, false, &national_number,
+                              &country_code);
+      if (country_code == 0) {
+        return INVALID_COUNTRY_CODE_ERROR;
+      }
+    }
+    if (country_code == 0) {
+      country_code = metadata.country_code;
+    }
+    if (national_number.length() < kMinLengthForNsn) {
+      return TOO_SHORT_NSN;
+    }
+    if (country_code != metadata.country_code) {
+      // The number belongs to another country.
+      return INVALID_COUNTRY_CODE_ERROR;
+    }
+    string potential_national_number(national_number);
+    MaybeStripNationalPrefix(metadata, &potential_national_number);
+    // The national prefix is only stripped if the rest is long enough to be a
+    // number of the region.
+    const ValidationResult validation_result =
+        TestNumberLength(metadata, potential_national_number.length());
+    if (validation_result != TOO_SHORT &&
+        validation_result != IS_POSSIBLE_LOCAL_ONLY &&
+        validation_result != INVALID_LENGTH) {
+      national_number.swap(potential_national_number);
+    }
+    if (national_number.length() < kMinLengthForNsn) {
+      return TOO_SHORT_NSN;
+    }
+    if (national_number.length() > kMaxLengthForNsn) {
+      return TOO_LONG_NSN;
+    }
+
+    *number = RegionPhoneNumber();
+    number->country_code = country_code;
+    if (national_number.length() > 1 && national_number[0] == '0') {
+      number->italian_leading_zero = true;
+      // If the number is all zeros, the last zero isn't a leading zero.
+      size_t number_of_leading_zeros = 1;
+      while (number_of_leading_zeros < national_number.length() - 1 &&
+             national_number[number_of_leading_zeros] == '0') {
+        ++number_of_leading_zeros;
+      }
+      number->number_of_leading_zeros =
+          static_cast<int32>(number_of_leading_zeros);
+    }
+    for (size_t i = 0; i < national_number.length(); ++i) {
+      number->national_number =
+          10 * number->national_number + (national_number[i] - '0');
+    }
+    return NO_PARSING_ERROR;
+  }
+
+  static void GetNationalSignificantNumber(const RegionPhoneNumber& number,
+                                           string* national_number) {
+    if (number.italian_leading_zero && number.number_of_leading_zeros > 0) {
+      national_number->append(number.number_of_leading_zeros, '0');
+    }
+    national_number->append(std::to_string(number.national_number));
+  }
+
+  // Splits national_number from position into the groups of format from
+  // group, trying the longest match of each group first like a regular
+  // expression engine. group_ends receives the end of each group.
+  static bool SplitIntoGroups(const RegionNumberFormat& format, int group,
+                              const string& national_number, size_t position,
+                              size_t* group_ends) {
+    if (group == format.num_groups) {
+      return position == national_number.length();
+    }
+    const DigitAutomaton& automaton = format.groups[group];
+    // The ends of the matches of the group, from the shortest.
+    size_t ends[kMaxLengthForNsn + 1];
+    int num_ends = 0;
+    int state = 1;
+    for (size_t i = position; state != 0; ++i) {
+      if (automaton.accepting[state]) {
+        ends[num_ends++] = i;
+      }
+      if (i == national_number.length()) {
+        break;
+      }
+      state = automaton.transitions[10 * state + (national_number[i] - '0')];
+    }
+    while (num_ends > 0) {
+      group_ends[group] = ends[--num_ends];
+      if (SplitIntoGroups(format, group + 1, national_number,
+                          group_ends[group], group_ends)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Formats national_number with the first of formats that matches it, as
+  // PhoneNumberUtil::FormatNsn() does.
+  static void FormatNsn(const RegionNumberFormat* formats, int num_formats,
+                        const string& national_number,
+                        PhoneNumberFormat number_format,
+                        string* formatted_number) {
+    size_t group_ends[10];
+    const RegionNumberFormat* format = NULL;
+    for (int i = 0; i < num_formats && !format; ++i) {
+      if (national_number.length() <= kMaxLengthForNsn &&
+          MatchesPrefix(formats[i].leading_digits, national_number.data(),
+                        national_number.length()) &&
+          SplitIntoGroups(formats[i], 0, national_number, 0, group_ends)) {
+        format = &formats[i];
+      }
+    }
+    if (!format) {
+      formatted_number->append(national_number);
+      return;
+    }
+    string formatted;
+    for (const char* c = format->format; *c; ++c) {
+      if (*c == '$' && c[1] >= '1' && c[1] <= '9') {
+        const int group = c[1] - '1';
+        if (group < format->num_groups) {
+          const size_t start = group == 0 ? 0 : group_ends[group - 1];
+          formatted.append(national_number, start, group_ends[group] - start);
+        }
+        ++c;
+      } else {
+        formatted.push_back(*c);
+      }
+    }
+    if (number_format == RFC3966) {
+      // The leading punctuation is removed, and the other runs of punctuation
+      // are replaced with a dash.
+      size_t i = 0;
+      while (i < formatted.length() && IsSeparator(formatted[i])) {
+        ++i;
+      }
+      for (; i < formatted.length(); ++i) {
+        if (!IsSeparator(formatted[i])) {
+          formatted_number->push_back(formatted[i]);
+        } else if (i + 1 == formatted.length() ||
+                   !IsSeparator(formatted[i + 1])) {
+          formatted_number->push_back('-');
+        }
+      }
+    } else {
+      formatted_number->append(formatted);
+    }
+  }
+
+  // The ASCII characters of PhoneNumberUtil::kValidPunctuation.
+  static bool IsSeparator(char c) {
+    return c == 'x' || c == '~' || IsPunctuation(c);
+  }
+
+  static void Format(const RegionMetadata& metadata,
+                     const RegionPhoneNumber& number,
+                     PhoneNumberFormat number_format,
+                     string* formatted_number) {
+    formatted_number->clear();
+    string national_significant_number;
+    GetNationalSignificantNumber(number, &national_significant_number);
+    if (number_format == E164) {
+      formatted_number->append("+");
+      formatted_number->append(std::to_string(number.country_code));
+      formatted_number->append(national_significant_number);
+      return;
+    }
+    if (number.country_code != metadata.country_code) {
+      // The number of another country is left unformatted.
+      formatted_number->assign(national_significant_number);
+      return;
+    }
+    switch (number_format) {
+      case INTERNATIONAL:
+        formatted_number->append("+");
+        formatted_number->append(std::to_string(number.country_code));
+        formatted_number->push_back(' ');
+        break;
+      case RFC3966:
+        formatted_number->append("tel:+");
+        formatted_number->append(std::to_string(number.country_code));
+        formatted_number->push_back('-');
+        break;
+      default:
+        break;
+    }
+    if (number_format == NATIONAL) {
+      FormatNsn(metadata.national_formats, metadata.num_national_formats,
+                national_significant_number, number_format, formatted_number);
+    } else {
+      FormatNsn(metadata.international_formats,
+                metadata.num_international_formats,
+                national_significant_number, number_format, formatted_number);
+    }
+  }
+};
+
+// The counterpart of PhoneNumberUtil for the region of metadata.
+template <const RegionMetadata& metadata>
+class RegionPhoneNumberUtil : public RegionPhoneNumberUtilBase {
+ public:
+  static const char* GetRegionCode() {
+    return metadata.region_code;
+  }
+
+  static int GetCountryCode() {
+    return metadata.country_code;
+  }
+
+  // Parses number_to_parse, written as a number of the region or with its
+  // country calling code. number is left unchanged unless it returns
+  // NO_PARSING_ERROR.
+  static ErrorType Parse(const string& number_to_parse,
+                         RegionPhoneNumber* number) {
+    return RegionPhoneNumberUtilBase::Parse(metadata, number_to_parse, number);
+  }
+
+  static void GetNationalSignificantNumber(const RegionPhoneNumber& number,
+                                           string* national_number) {
+    national_number->clear();
+    RegionPhoneNumberUtilBase::GetNationalSignificantNumber(number,
+                                                            national_number);
+  }
+
+  static PhoneNumberType GetNumberType(const RegionPhoneNumber& number) {
+    if (number.country_code != metadata.country_code) {
+      return UNKNOWN;
+    }
+    string national_number;
+    GetNationalSignificantNumber(number, &national_number);
+    return GetNumberTypeHelper(metadata, national_number);
+  }
+
+  static bool IsValidNumber(const RegionPhoneNumber& number) {
+    return GetNumberType(number) != UNKNOWN;
+  }
+
+  static ValidationResult IsPossibleNumberWithReason(
+      const RegionPhoneNumber& number) {
+    if (number.country_code != metadata.country_code) {
+      return INVALID_COUNTRY_CODE;
+    }
+    string national_number;
+    GetNationalSignificantNumber(number, &national_number);
+    return TestNumberLength(metadata, national_number.length());
+  }
+
+  static bool IsPossibleNumber(const RegionPhoneNumber& number) {
+    const ValidationResult result = IsPossibleNumberWithReason(number);
+    return result == IS_POSSIBLE || result == IS_POSSIBLE_LOCAL_ONLY;
+  }
+
+  // Formats number, which is left unformatted except in E164 if it belongs to
+  // another country.
+  static void Format(const RegionPhoneNumber& number,
+                     PhoneNumberFormat number_format,
+                     string* formatted_number) {
+    RegionPhoneNumberUtilBase::Format(metadata, number, number_format,
+                                      formatted_number);
+  }
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_REGION_PHONENUMBERUTIL_H_
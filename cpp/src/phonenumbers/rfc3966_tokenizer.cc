@@ -0,0 +1,136 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/rfc3966_tokenizer.h"
+
+#include <cstddef>
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+const char kTelUriScheme[] = "tel:";
+const char kExtensionName[] = "ext=";
+const char kIsdnSubaddressName[] = "isub=";
+const char kPhoneContextName[] = "phone-context=";
+
+bool IsAsciiDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsAsciiAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool IsAsciiAlphanumeric(char c) {
+  return IsAsciiDigit(c) || IsAsciiAlpha(c);
+}
+
+// Sets value to the part of parameter following name, if parameter starts with
+// name and value hasn't been set yet.
+void MaybeSetParameter(absl::string_view parameter, absl::string_view name,
+                       absl::string_view* value, bool* has_value) {
+  if (!*has_value && parameter.substr(0, name.length()) == name) {
+    *value = parameter.substr(name.length());
+    *has_value = true;
+  }
+}
+
+// global-number-digits = "+" *phonedigit DIGIT *phonedigit
+// phonedigit = DIGIT / visual-separator
+// visual-separator = "-" / "." / "(" / ")"
+bool IsGlobalNumberDigits(absl::string_view phone_context) {
+  if (phone_context.empty() || phone_context[0] != '+') {
+    return false;
+  }
+  bool has_digit = false;
+  for (size_t i = 1; i < phone_context.length(); ++i) {
+    const char c = phone_context[i];
+    if (IsAsciiDigit(c)) {
+      has_digit = true;
+    } else if (c != '-' && c != '.' && c != '(' && c != ')') {
+      return false;
+    }
+  }
+  return has_digit;
+}
+
+// domainname = *( domainlabel "." ) toplabel [ "." ]
+// domainlabel = alphanum / alphanum *( alphanum / "-" ) alphanum
+// toplabel = ALPHA / ALPHA *( alphanum / "-" ) alphanum
+bool IsDomainName(absl::string_view phone_context) {
+  if (!phone_context.empty() && phone_context.back() == '.') {
+    phone_context.remove_suffix(1);
+  }
+  if (phone_context.empty()) {
+    return false;
+  }
+  size_t label_start = 0;
+  while (true) {
+    size_t label_end = phone_context.find('.', label_start);
+    if (label_end == absl::string_view::npos) {
+      label_end = phone_context.length();
+    }
+    const absl::string_view label =
+        phone_context.substr(label_start, label_end - label_start);
+    if (label.empty() || !IsAsciiAlphanumeric(label.front()) ||
+        !IsAsciiAlphanumeric(label.back())) {
+      return false;
+    }
+    for (size_t i = 1; i + 1 < label.length(); ++i) {
+      if (!IsAsciiAlphanumeric(label[i]) && label[i] != '-') {
+        return false;
+      }
+    }
+    if (label_end == phone_context.length()) {
+      return IsAsciiAlpha(label.front());
+    }
+    label_start = label_end + 1;
+  }
+}
+
+}  // namespace
+
+bool TokenizeTelUri(absl::string_view uri, TelUri* tel_uri) {
+  const absl::string_view scheme(kTelUriScheme);
+  if (uri.substr(0, scheme.length()) != scheme) {
+    return false;
+  }
+  *tel_uri = TelUri();
+  size_t position = scheme.length();
+  size_t parameter_start = uri.find(';', position);
+  tel_uri->number = uri.substr(position, parameter_start - position);
+  while (parameter_start != absl::string_view::npos) {
+    position = parameter_start + 1;
+    parameter_start = uri.find(';', position);
+    const absl::string_view parameter =
+        uri.substr(position, parameter_start - position);
+    MaybeSetParameter(parameter, kExtensionName, &tel_uri->extension,
+                      &tel_uri->has_extension);
+    MaybeSetParameter(parameter, kIsdnSubaddressName,
+                      &tel_uri->isdn_subaddress,
+                      &tel_uri->has_isdn_subaddress);
+    MaybeSetParameter(parameter, kPhoneContextName, &tel_uri->phone_context,
+                      &tel_uri->has_phone_context);
+  }
+  return true;
+}
+
+bool IsValidAsciiPhoneContext(absl::string_view phone_context) {
+  return IsGlobalNumberDigits(phone_context) || IsDomainName(phone_context);
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
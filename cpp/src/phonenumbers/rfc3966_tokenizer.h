@@ -0,0 +1,66 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Allocation-free tokenizer for tel URIs, as defined in RFC3966, such as
+// "tel:863-1234;phone-context=+1-914-555". The components of the URI are
+// returned as views of the input, which must outlive them.
+//
+// TelUri tel_uri;
+// if (TokenizeTelUri("tel:+1-650-253-0000;ext=123", &tel_uri)) {
+//   // tel_uri.number is "+1-650-253-0000", tel_uri.extension is "123".
+// }
+//
+// PhoneNumberUtil::Parse() uses it for the input starting with "tel:".
+
+#ifndef I18N_PHONENUMBERS_RFC3966_TOKENIZER_H_
+#define I18N_PHONENUMBERS_RFC3966_TOKENIZER_H_
+
+#include "absl/strings/string_view.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+struct TelUri {
+  TelUri()
+      : has_extension(false),
+        has_isdn_subaddress(false),
+        has_phone_context(false) {}
+
+  // Everything between "tel:" and the first parameter.
+  absl::string_view number;
+  // The values of the first ext, isub and phone-context parameters. The names
+  // of the parameters are case-sensitive, and the other parameters are
+  // ignored.
+  absl::string_view extension;
+  absl::string_view isdn_subaddress;
+  absl::string_view phone_context;
+  bool has_extension;
+  bool has_isdn_subaddress;
+  bool has_phone_context;
+};
+
+// Splits uri into the components of a tel URI. Returns false if uri doesn't
+// start with "tel:", in which case tel_uri is left unchanged. The syntax of the
+// components isn't checked.
+bool TokenizeTelUri(absl::string_view uri, TelUri* tel_uri);
+
+// Returns true if phone_context is an ASCII string following the syntax of the
+// phone-context parameter value defined in RFC3966, which is either a global
+// number such as "+1-914-555" or a domain name such as "example.com".
+bool IsValidAsciiPhoneContext(absl::string_view phone_context);
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_RFC3966_TOKENIZER_H_
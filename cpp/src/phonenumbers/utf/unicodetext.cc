@@ -280,6 +280,12 @@ UnicodeText& UnicodeText::PointToUTF8(const char* buffer, int byte_length) {
   return *this;
 }
 
+UnicodeText& UnicodeText::PointToValidUTF8(const char* buffer,
+                                          int byte_length) {
+  repr_.utf8_was_valid_ = true;
+  return UnsafePointToUTF8(buffer, byte_length);
+}
+
 UnicodeText& UnicodeText::UnsafePointToUTF8(const char* buffer,
                                           int byte_length) {
   repr_.PointTo(buffer, byte_length);
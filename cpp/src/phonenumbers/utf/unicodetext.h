@@ -313,6 +313,11 @@ class UnicodeText {
   // CopyUTF8(utf8_buffer, byte_length).
   UnicodeText& PointToUTF8(const char* utf8_buffer, int byte_length);
 
+  // x.PointToValidUTF8(buf,len) is the same as x.PointToUTF8(buf,len) for a
+  // buffer the caller already checked to be interchange-valid, which isn't
+  // checked again.
+  UnicodeText& PointToValidUTF8(const char* utf8_buffer, int byte_length);
+
   // Was this UnicodeText created from valid UTF-8?
   bool UTF8WasValid() const { return repr_.utf8_was_valid_; }
 
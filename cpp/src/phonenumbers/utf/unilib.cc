@@ -18,6 +18,8 @@
 
 #include "phonenumbers/utf/unilib.h"
 
+#include <string.h>
+
 #include "phonenumbers/base/basictypes.h"
 #include "phonenumbers/utf/utf.h"
 
@@ -43,13 +45,53 @@ inline bool IsInterchangeValidCodepoint(char32 c) {
            (c >= 0xFDD0 && c <= 0xFDEF) || (c&0xFFFE) == 0xFFFE);
 }
 
+// Returns true if the eight bytes of word are all printable ASCII characters,
+// from U+0020 to U+007E, using the usual bit tricks to test the bytes in
+// parallel: a byte is below n if subtracting n from it borrows into its high
+// bit while it was clear.
+inline bool IsPrintableAsciiWord(uint64 word) {
+  const uint64 kOnes = 0x0101010101010101ULL;
+  const uint64 kHighBits = 0x8080808080808080ULL;
+  const uint64 below_space = (word - kOnes * 0x20) & ~word & kHighBits;
+  const uint64 del = word ^ (kOnes * 0x7F);
+  const uint64 is_del = (del - kOnes) & ~del & kHighBits;
+  return ((word & kHighBits) | below_space | is_del) == 0;
+}
+
 }  // namespace
 
+int SpanInterchangeValidAscii(const char* begin, int byte_length) {
+  const char* p = begin;
+  const char* end = begin + byte_length;
+  while (p < end) {
+    if (end - p >= 8) {
+      uint64 word;
+      memcpy(&word, p, sizeof(word));
+      if (IsPrintableAsciiWord(word)) {
+        p += 8;
+        continue;
+      }
+    }
+    if (static_cast<unsigned char>(*p) >= Runeself ||
+        !IsInterchangeValidCodepoint(*p)) {
+      break;
+    }
+    ++p;
+  }
+  return static_cast<int>(p - begin);
+}
+
 int SpanInterchangeValid(const char* begin, int byte_length) {
   Rune rune;
   const char* p = begin;
   const char* end = begin + byte_length;
   while (p < end) {
+    // Skip the ASCII characters, which make up most phone numbers, without
+    // decoding them.
+    p += SpanInterchangeValidAscii(p, static_cast<int>(end - p));
+    if (p == end) {
+      break;
+    }
     int bytes_consumed = charntorune(&rune, p, static_cast<int>(end - p));
     // We want to accept Runeerror == U+FFFD as a valid char, but it is used
     // by chartorune to indicate error. Luckily, the real codepoint is size 3
@@ -75,6 +75,13 @@ inline bool IsTrailByte(char x) {
   return static_cast<signed char>(x) < -0x40;
 }
 
+// Returns the length in bytes of the prefix of src that is all
+//  interchange valid ASCII. Printable characters are checked eight at a time.
+int SpanInterchangeValidAscii(const char* src, int byte_length);
+inline int SpanInterchangeValidAscii(const std::string& src) {
+  return SpanInterchangeValidAscii(src.data(), static_cast<int>(src.size()));
+}
+
 // Returns the length in bytes of the prefix of src that is all
 //  interchange valid UTF-8
 int SpanInterchangeValid(const char* src, int byte_length);
@@ -0,0 +1,127 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/allocation_counter.h"
+
+#include <cstdlib>
+#include <new>
+
+#include <unicode/uclean.h>
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+// Plain thread-local integers don't require dynamic initialization, so they
+// can be safely touched from operator new.
+thread_local int64 thread_allocation_count = 0;
+thread_local int64 thread_allocated_bytes = 0;
+
+}  // namespace
+
+int64 GetThreadAllocationCount() {
+  return thread_allocation_count;
+}
+
+int64 GetThreadAllocatedBytes() {
+  return thread_allocated_bytes;
+}
+
+// Not declared in the header since it's only meant to be called by the
+// replacement operators below.
+void* CountedAllocate(std::size_t size) {
+  ++thread_allocation_count;
+  thread_allocated_bytes += static_cast<int64>(size);
+  // malloc(0) may return NULL, which operator new is not allowed to do.
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+namespace {
+
+// ICU allocates its memory with malloc() rather than operator new, unless it is
+// given memory functions such as these ones.
+void* IcuAllocate(const void* /* context */, size_t size) {
+  return CountedAllocate(size);
+}
+
+void* IcuReallocate(const void* /* context */, void* ptr, size_t size) {
+  ++thread_allocation_count;
+  thread_allocated_bytes += static_cast<int64>(size);
+  return std::realloc(ptr, size == 0 ? 1 : size);
+}
+
+void IcuFree(const void* /* context */, void* ptr) {
+  std::free(ptr);
+}
+
+// Installs the memory functions above when the binary is loaded.
+const bool icu_memory_functions_set = []() {
+  UErrorCode status = U_ZERO_ERROR;
+  u_setMemoryFunctions(NULL, IcuAllocate, IcuReallocate, IcuFree, &status);
+  return U_SUCCESS(status);
+}();
+
+}  // namespace
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+using i18n::phonenumbers::CountedAllocate;
+
+// The replacements below cover the throwing, non-throwing and sized variants
+// that the library and its dependencies may call. Over-aligned allocations are
+// not counted.
+void* operator new(std::size_t size) {
+  void* const ptr = CountedAllocate(size);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
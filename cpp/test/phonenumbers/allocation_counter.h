@@ -0,0 +1,67 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Test-only heap allocation accounting. Linking allocation_counter.cc into a
+// binary replaces the global operator new and operator delete, as well as the
+// memory functions of ICU, so that every allocation made by the calling thread
+// is counted.
+
+#ifndef I18N_PHONENUMBERS_TEST_ALLOCATION_COUNTER_H_
+#define I18N_PHONENUMBERS_TEST_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+// Returns the number of calls to operator new and to the ICU memory functions
+// made so far by the current thread.
+int64 GetThreadAllocationCount();
+
+// Returns the number of bytes requested from operator new and ICU so far by the
+// current thread.
+int64 GetThreadAllocatedBytes();
+
+// Counts the heap allocations made by the current thread during the lifetime
+// of an instance. Allocations made by other threads are not taken into
+// account.
+class ScopedAllocationCounter {
+ public:
+  ScopedAllocationCounter()
+      : start_count_(GetThreadAllocationCount()),
+        start_bytes_(GetThreadAllocatedBytes()) {}
+
+  // This type is neither copyable nor movable.
+  ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+  ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+  int64 allocations() const {
+    return GetThreadAllocationCount() - start_count_;
+  }
+
+  int64 allocated_bytes() const {
+    return GetThreadAllocatedBytes() - start_bytes_;
+  }
+
+ private:
+  const int64 start_count_;
+  const int64 start_bytes_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_TEST_ALLOCATION_COUNTER_H_
@@ -0,0 +1,157 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Upper bounds on the number of heap allocations made by the hot paths of the
+// library once caches have been warmed up. The bounds are the counts measured
+// with the toolchain the library is developed with, which other versions of
+// ICU, protobuf or the standard library may lower. When one of these tests
+// fails after a change, the change introduced new allocations that should be
+// avoided. When a change removes some, the corresponding bound is tightened.
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/allocation_counter.h"
+#include "phonenumbers/asyoutypeformatter.h"
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
+#include "phonenumbers/test_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+class AllocationTest : public testing::Test {
+ public:
+  // This type is neither copyable nor movable.
+  AllocationTest(const AllocationTest&) = delete;
+  AllocationTest& operator=(const AllocationTest&) = delete;
+
+ protected:
+  AllocationTest() : phone_util_(*PhoneNumberUtil::GetInstance()) {}
+
+  // Runs 'function' once to warm up the caches it relies on, then returns the
+  // number of heap allocations made by a second run.
+  template <typename Function>
+  static int64 CountAllocationsAfterWarmUp(const Function& function) {
+    function();
+    ScopedAllocationCounter counter;
+    function();
+    return counter.allocations();
+  }
+
+  const PhoneNumberUtil& phone_util_;
+};
+
+TEST_F(AllocationTest, CountsAllocationsOfCurrentThread) {
+  ScopedAllocationCounter counter;
+  void* const allocated = ::operator new(16);
+  EXPECT_EQ(1, counter.allocations());
+  EXPECT_EQ(16, counter.allocated_bytes());
+  ::operator delete(allocated);
+}
+
+TEST_F(AllocationTest, RegExpConsume) {
+  const RegExpFactory regexp_factory;
+  const scoped_ptr<const RegExp> regexp(
+      regexp_factory.CreateRegExp("\\d{3}-(\\d{4})"));
+  const string input("Call 253-0000 now.");
+  size_t end;
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    regexp->Consume(input, 0, false, &end);
+  });
+  EXPECT_EQ(13U, end);
+  EXPECT_EQ(0, allocations);
+}
+
+TEST_F(AllocationTest, Parse) {
+  PhoneNumber number;
+  const string input("+1 650-253-0000");
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    phone_util_.Parse(input, RegionCode::US(), &number);
+  });
+  EXPECT_LE(allocations, 12);
+}
+
+TEST_F(AllocationTest, ParseNational) {
+  PhoneNumber number;
+  const string input("(650) 253-0000");
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    phone_util_.Parse(input, RegionCode::US(), &number);
+  });
+  EXPECT_LE(allocations, 4);
+}
+
+TEST_F(AllocationTest, IsValidNumber) {
+  PhoneNumber number;
+  number.set_country_code(1);
+  number.set_national_number(uint64{6502530000});
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    phone_util_.IsValidNumber(number);
+  });
+  EXPECT_LE(allocations, 4);
+}
+
+TEST_F(AllocationTest, GetNumberType) {
+  PhoneNumber number;
+  number.set_country_code(1);
+  number.set_national_number(uint64{6502530000});
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    phone_util_.GetNumberType(number);
+  });
+  EXPECT_LE(allocations, 4);
+}
+
+TEST_F(AllocationTest, FormatE164) {
+  PhoneNumber number;
+  number.set_country_code(1);
+  number.set_national_number(uint64{6502530000});
+  string formatted;
+  formatted.reserve(32);
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    phone_util_.Format(number, PhoneNumberUtil::E164, &formatted);
+  });
+  EXPECT_EQ(0, allocations);
+}
+
+TEST_F(AllocationTest, FormatInOriginalFormat) {
+  PhoneNumber number;
+  phone_util_.ParseAndKeepRawInput("020 7031 3000", RegionCode::GB(), &number);
+  string formatted;
+  formatted.reserve(32);
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    phone_util_.FormatInOriginalFormat(number, RegionCode::GB(), &formatted);
+  });
+  EXPECT_EQ("(020) 7031 3000", formatted);
+  EXPECT_LE(allocations, 6);
+}
+
+TEST_F(AllocationTest, AsYouTypeFormatterInputDigit) {
+  const scoped_ptr<AsYouTypeFormatter> formatter(
+      phone_util_.GetAsYouTypeFormatter(RegionCode::US()));
+  string result;
+  const int64 allocations = CountAllocationsAfterWarmUp([&]() {
+    formatter->Clear();
+    for (const char digit : string("6502530000")) {
+      formatter->InputDigit(digit, &result);
+    }
+  });
+  EXPECT_LE(allocations, 177);
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
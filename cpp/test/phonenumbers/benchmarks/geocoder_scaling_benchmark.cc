@@ -0,0 +1,60 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of geocoder lookups from 1 to kMaxThreads threads
+// sharing a single PhoneNumberOfflineGeocoder, whose mapping cache is
+// protected by a mutex.
+
+#include <benchmark/benchmark.h>
+#include <unicode/locid.h>
+
+#include "phonenumbers/geocoding/phonenumber_offline_geocoder.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+const int kMaxThreads = 16;
+
+void BM_GetDescriptionForNumber(benchmark::State& state) {
+  static const PhoneNumberOfflineGeocoder* const geocoder =
+      new PhoneNumberOfflineGeocoder();
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const char* const kNumbers[][2] = {
+    { "+1 650-253-0000", "US" },
+    { "044 668 18 00", "CH" },
+    { "020 7031 3000", "GB" },
+    { "+49 30 303986300", "DE" },
+  };
+  PhoneNumber numbers[4];
+  for (int i = 0; i < 4; ++i) {
+    phone_util.Parse(kNumbers[i][0], kNumbers[i][1], &numbers[i]);
+  }
+  const icu::Locale locale("en", "US");
+  int i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        geocoder->GetDescriptionForNumber(numbers[i++ % 4], locale));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetDescriptionForNumber)
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,242 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of the main entry points of the library when called
+// from 1 to kMaxThreads threads at once. With perfect scaling the reported
+// items_per_second grows linearly with the number of threads; a plateau points
+// at contention on shared state such as the regular expression cache.
+
+#include <iterator>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/shortnumberinfo.h"
+
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+#include "phonenumbers/phonenumbermatch.h"
+#include "phonenumbers/phonenumbermatcher.h"
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+
+#include "phonenumber_generator.h"
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+const int kMaxThreads = 16;
+
+// Inputs from several regions, so that several entries of the regular
+// expression cache are used concurrently.
+const char* const kNumbers[][2] = {
+  { "+1 650-253-0000", "US" },
+  { "044 668 18 00", "CH" },
+  { "020 7031 3000", "GB" },
+  { "+49 30 303986300", "DE" },
+  { "01 42 68 53 00", "FR" },
+  { "03-6384-9000", "JP" },
+  { "(02) 9374 4000", "AU" },
+  { "+55 11 2395-8400", "BR" },
+};
+const int kNumNumbers = sizeof(kNumbers) / sizeof(kNumbers[0]);
+
+void BM_Parse(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumber number;
+  int i = state.thread_index();
+  for (auto _ : state) {
+    const char* const* test_case = kNumbers[i++ % kNumNumbers];
+    benchmark::DoNotOptimize(
+        phone_util.Parse(test_case[0], test_case[1], &number));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Parse)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_FormatInternational(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumber numbers[kNumNumbers];
+  for (int i = 0; i < kNumNumbers; ++i) {
+    phone_util.Parse(kNumbers[i][0], kNumbers[i][1], &numbers[i]);
+  }
+  string formatted;
+  int i = state.thread_index();
+  for (auto _ : state) {
+    phone_util.Format(numbers[i++ % kNumNumbers],
+                      PhoneNumberUtil::INTERNATIONAL, &formatted);
+    benchmark::DoNotOptimize(formatted);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatInternational)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_GetNumberType(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumber numbers[kNumNumbers];
+  for (int i = 0; i < kNumNumbers; ++i) {
+    phone_util.Parse(kNumbers[i][0], kNumbers[i][1], &numbers[i]);
+  }
+  int i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        phone_util.GetNumberType(numbers[i++ % kNumNumbers]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetNumberType)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_ShortNumberInfo(benchmark::State& state) {
+  static const ShortNumberInfo* const short_info = new ShortNumberInfo();
+  const char* const kShortNumbers[][2] = {
+    { "911", "US" }, { "112", "DE" }, { "999", "GB" }, { "117", "CH" },
+  };
+  int i = state.thread_index();
+  for (auto _ : state) {
+    const char* const* test_case = kShortNumbers[i++ % 4];
+    benchmark::DoNotOptimize(
+        short_info->ConnectsToEmergencyNumber(test_case[0], test_case[1]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShortNumberInfo)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+// Numbers of every supported region and type, written the way people write
+// them, with their region. Unlike kNumbers they use most formatting patterns
+// and parsing paths of the metadata.
+const std::vector<std::pair<string, string> >& GetGeneratedNumbers() {
+  static const std::vector<std::pair<string, string> >* const numbers = [] {
+    const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+    PhoneNumberGenerator generator(phone_util, 1);
+    generator.set_extension_percentage(5);
+    std::set<string> regions;
+    phone_util.GetSupportedRegions(&regions);
+    auto* numbers = new std::vector<std::pair<string, string> >();
+    PhoneNumber number;
+    string formatted;
+    for (const string& region : regions) {
+      std::set<PhoneNumberUtil::PhoneNumberType> types;
+      phone_util.GetSupportedTypesForRegion(region, &types);
+      for (PhoneNumberUtil::PhoneNumberType type : types) {
+        for (int i = 0; i < 10 && generator.Generate(region, type, &number);
+             ++i) {
+          generator.FormatMessy(number, region, &formatted);
+          numbers->push_back(std::make_pair(formatted, region));
+        }
+      }
+    }
+    return numbers;
+  }();
+  return *numbers;
+}
+
+void BM_ParseGeneratedNumbers(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const std::vector<std::pair<string, string> >& numbers =
+      GetGeneratedNumbers();
+  PhoneNumber number;
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    const std::pair<string, string>& test_case = numbers[i++ % numbers.size()];
+    benchmark::DoNotOptimize(
+        phone_util.Parse(test_case.first, test_case.second, &number));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseGeneratedNumbers)->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+void BM_PhoneNumberMatcher(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const string text(
+      "Reach us at +1 650-253-0000 (HQ) or 044 668 18 00 during office "
+      "hours, 9:00-17:00. Ticket 2013/11/04, fax 020 7031 3000.");
+  PhoneNumberMatch match;
+  for (auto _ : state) {
+    PhoneNumberMatcher matcher(phone_util, text, "CH",
+                               PhoneNumberMatcher::VALID, 100);
+    while (matcher.HasNext()) {
+      matcher.Next(&match);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_PhoneNumberMatcher)->ThreadRange(1, kMaxThreads)->UseRealTime();
+
+void BM_PhoneNumberMatcherSpans(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const string text(
+      "Reach us at +1 650-253-0000 (HQ) or 044 668 18 00 during office "
+      "hours, 9:00-17:00. Ticket 2013/11/04, fax 020 7031 3000.");
+  std::vector<PhoneNumberMatcher::MatchSpan> spans;
+  for (auto _ : state) {
+    PhoneNumberMatcher matcher(phone_util, text, "CH",
+                               PhoneNumberMatcher::VALID, 100);
+    spans.clear();
+    matcher.AppendRemainingSpans(&spans);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_PhoneNumberMatcherSpans)->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+// Searches a support ticket for numbers of any of four regions, once with a
+// matcher per region and once with a single multi-region matcher.
+const char kSupportTicket[] =
+    "Customer called from 020 7031 3000, callback on 650-253-0000 or "
+    "+91 80 6721 8000. Office in Munich: 089 839300. Ticket 2013/11/04.";
+const char* const kTicketRegions[] = {"US", "GB", "IN", "DE"};
+
+void BM_PhoneNumberMatcherPerRegion(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const string text(kSupportTicket);
+  PhoneNumberMatch match;
+  for (auto _ : state) {
+    for (const char* region : kTicketRegions) {
+      PhoneNumberMatcher matcher(phone_util, text, region,
+                                 PhoneNumberMatcher::VALID, 100);
+      while (matcher.Next(&match)) {}
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_PhoneNumberMatcherPerRegion);
+
+void BM_PhoneNumberMatcherMultiRegion(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const string text(kSupportTicket);
+  const std::vector<string> regions(std::begin(kTicketRegions),
+                                    std::end(kTicketRegions));
+  PhoneNumberMatch match;
+  string region;
+  for (auto _ : state) {
+    PhoneNumberMatcher matcher(phone_util, text, regions,
+                               PhoneNumberMatcher::VALID, 100);
+    while (matcher.Next(&match, &region)) {}
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_PhoneNumberMatcherMultiRegion);
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+
+}  // namespace
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,79 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the parsing of tel URIs as found in the headers of SIP requests,
+// such as P-Asserted-Identity or the Request-URI, by a session border
+// controller.
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/rfc3966_tokenizer.h"
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+// Global numbers, and local numbers qualified by a number prefix or a domain.
+const char* const kTelUris[] = {
+  "tel:+1-650-253-0000",
+  "tel:+41-44-668-1800;ext=123",
+  "tel:+44-20-7031-3000;isub=1411",
+  "tel:253-0000;phone-context=+1-650",
+  "tel:7031-3000;phone-context=+44-20",
+  "tel:668-1800;ext=42;phone-context=+41-44",
+  "tel:6681800;phone-context=example.ch",
+  "tel:+49-30-303986300;npdi;rn=+49-30-3039",
+};
+const int kNumTelUris = sizeof(kTelUris) / sizeof(kTelUris[0]);
+
+void BM_TokenizeTelUri(benchmark::State& state) {
+  const string uris[] = {
+    kTelUris[0], kTelUris[1], kTelUris[2], kTelUris[3],
+    kTelUris[4], kTelUris[5], kTelUris[6], kTelUris[7],
+  };
+  TelUri tel_uri;
+  int i = 0;
+  for (auto _ : state) {
+    const string& uri = uris[i++ % kNumTelUris];
+    benchmark::DoNotOptimize(TokenizeTelUri(uri, &tel_uri) &&
+                             (!tel_uri.has_phone_context ||
+                              IsValidAsciiPhoneContext(tel_uri.phone_context)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TokenizeTelUri);
+
+void BM_ParseTelUri(benchmark::State& state) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  const string uris[] = {
+    kTelUris[0], kTelUris[1], kTelUris[2], kTelUris[3],
+    kTelUris[4], kTelUris[5], kTelUris[6], kTelUris[7],
+  };
+  PhoneNumber number;
+  int i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        phone_util.Parse(uris[i++ % kNumTelUris], "CH", &number));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseTelUri)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,272 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Note that these tests use the test metadata, not the normal metadata file.
+
+#include "phonenumbers/columnar_batch.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/executor.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/test_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+class ColumnarBatchTest : public testing::Test {
+ protected:
+  ColumnarBatchTest()
+      : phone_util_(*PhoneNumberUtil::GetInstance()),
+        columnar_(phone_util_) {}
+
+  // Returns the formatted value of row i, or "null".
+  string FormattedValue(int64 i) const {
+    const StringArray formatted = columns_.formatted.View();
+    if (formatted.IsNull(i)) {
+      return "null";
+    }
+    return string(formatted.Value(i));
+  }
+
+  const PhoneNumberUtil& phone_util_;
+  const ColumnarPhoneNumberUtil columnar_;
+  ParsedNumberColumns columns_;
+};
+
+TEST_F(ColumnarBatchTest, StringArrayBuilder) {
+  StringArrayBuilder builder;
+  EXPECT_EQ(0, builder.length());
+  builder.Append("+41");
+  builder.Append("");
+  EXPECT_TRUE(builder.validity().empty());
+  // The validity bitmap is only allocated with the first null value.
+  for (int i = 0; i < 8; ++i) {
+    builder.AppendNull();
+  }
+  builder.Append("44");
+  EXPECT_EQ(11, builder.length());
+  EXPECT_EQ(8, builder.null_count());
+  ASSERT_EQ(2U, builder.validity().size());
+  EXPECT_EQ(0x03, builder.validity()[0]);
+  EXPECT_EQ(0x04, builder.validity()[1]);
+
+  const StringArray array = builder.View();
+  EXPECT_EQ(11, array.length);
+  EXPECT_FALSE(array.IsNull(0));
+  EXPECT_EQ("+41", array.Value(0));
+  EXPECT_FALSE(array.IsNull(1));
+  EXPECT_EQ("", array.Value(1));
+  EXPECT_TRUE(array.IsNull(2));
+  EXPECT_EQ("", array.Value(2));
+  EXPECT_FALSE(array.IsNull(10));
+  EXPECT_EQ("44", array.Value(10));
+
+  builder.Clear();
+  EXPECT_EQ(0, builder.length());
+  EXPECT_EQ(0, builder.null_count());
+  EXPECT_TRUE(builder.validity().empty());
+}
+
+TEST_F(ColumnarBatchTest, RegionIds) {
+  EXPECT_EQ(RegionCode::ZZ(), columnar_.GetRegionCodeForId(0));
+  EXPECT_EQ("001", columnar_.GetRegionCodeForId(1));
+  EXPECT_EQ(0, columnar_.GetIdForRegionCode(RegionCode::ZZ()));
+  EXPECT_EQ(0, columnar_.GetIdForRegionCode("XX"));
+  EXPECT_EQ(1, columnar_.GetIdForRegionCode("001"));
+  for (int id = 1; id < columnar_.num_region_ids(); ++id) {
+    EXPECT_EQ(id,
+              columnar_.GetIdForRegionCode(columnar_.GetRegionCodeForId(id)));
+  }
+}
+
+TEST_F(ColumnarBatchTest, ParseColumn) {
+  StringArrayBuilder numbers;
+  numbers.Append("+1 650-253-0000");
+  numbers.Append("invalid");
+  numbers.AppendNull();
+  numbers.Append("033316005 ext. 1");
+  numbers.Append("02 3661 8300");
+  StringArrayBuilder regions;
+  regions.AppendNull();
+  regions.AppendNull();
+  regions.AppendNull();
+  regions.AppendNull();
+  regions.Append(RegionCode::IT());
+  const StringArray regions_view = regions.View();
+
+  ColumnarParseOptions options;
+  options.number_types = true;
+  options.region_ids = true;
+  options.formatted = true;
+  columnar_.ParseColumn(numbers.View(), &regions_view, RegionCode::NZ(),
+                        options, &columns_);
+  ASSERT_EQ(5U, columns_.errors.size());
+  ASSERT_EQ(5U, columns_.country_codes.size());
+  ASSERT_EQ(5U, columns_.national_numbers.size());
+  ASSERT_EQ(5U, columns_.leading_zeros.size());
+  ASSERT_EQ(5U, columns_.has_extensions.size());
+  ASSERT_EQ(5U, columns_.number_types.size());
+  ASSERT_EQ(5U, columns_.region_ids.size());
+  ASSERT_EQ(5, columns_.formatted.length());
+
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR, columns_.errors[0]);
+  EXPECT_EQ(1, columns_.country_codes[0]);
+  EXPECT_EQ(uint64{6502530000}, columns_.national_numbers[0]);
+  EXPECT_EQ(0, columns_.leading_zeros[0]);
+  EXPECT_EQ(0, columns_.has_extensions[0]);
+  EXPECT_EQ(PhoneNumberUtil::FIXED_LINE_OR_MOBILE, columns_.number_types[0]);
+  EXPECT_EQ(RegionCode::US(),
+            columnar_.GetRegionCodeForId(columns_.region_ids[0]));
+  EXPECT_EQ("+16502530000", FormattedValue(0));
+
+  EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER, columns_.errors[1]);
+  EXPECT_EQ(0, columns_.country_codes[1]);
+  EXPECT_EQ(0U, columns_.national_numbers[1]);
+  EXPECT_EQ(PhoneNumberUtil::UNKNOWN, columns_.number_types[1]);
+  EXPECT_EQ(0, columns_.region_ids[1]);
+  EXPECT_EQ("null", FormattedValue(1));
+
+  // Null values aren't numbers.
+  EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER, columns_.errors[2]);
+  EXPECT_EQ("null", FormattedValue(2));
+
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR, columns_.errors[3]);
+  EXPECT_EQ(64, columns_.country_codes[3]);
+  EXPECT_EQ(uint64{33316005}, columns_.national_numbers[3]);
+  EXPECT_EQ(1, columns_.has_extensions[3]);
+  EXPECT_EQ(RegionCode::NZ(),
+            columnar_.GetRegionCodeForId(columns_.region_ids[3]));
+  EXPECT_EQ("+6433316005", FormattedValue(3));
+
+  // The region of the last row is IT rather than the default region.
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR, columns_.errors[4]);
+  EXPECT_EQ(39, columns_.country_codes[4]);
+  EXPECT_EQ(uint64{236618300}, columns_.national_numbers[4]);
+  EXPECT_EQ(1, columns_.leading_zeros[4]);
+  EXPECT_EQ(RegionCode::IT(),
+            columnar_.GetRegionCodeForId(columns_.region_ids[4]));
+  EXPECT_EQ("+390236618300", FormattedValue(4));
+}
+
+TEST_F(ColumnarBatchTest, ParseColumnMatchesParse) {
+  static const char* const kNumbers[] = {
+    "+41 44 668 1800", "tel:+49-30-1234", "+800 1234 5678", "1-800-FLOWERS",
+    "+1 (650) 253-0000 x 1234", "++", "+39 0236618300",
+  };
+  StringArrayBuilder builder;
+  for (size_t i = 0; i < sizeof(kNumbers) / sizeof(kNumbers[0]); ++i) {
+    builder.Append(kNumbers[i]);
+  }
+  // A slice of the column, whose offsets don't start at 0.
+  StringArray slice = builder.View();
+  ++slice.offsets;
+  --slice.length;
+
+  ColumnarParseOptions options;
+  options.formatted = true;
+  options.format = PhoneNumberUtil::INTERNATIONAL;
+  columnar_.ParseColumn(slice, NULL, RegionCode::US(), options, &columns_);
+  // Only the requested columns are filled in.
+  EXPECT_TRUE(columns_.number_types.empty());
+  EXPECT_TRUE(columns_.region_ids.empty());
+  ASSERT_EQ(static_cast<size_t>(slice.length), columns_.errors.size());
+  PhoneNumber number;
+  string formatted;
+  for (int64 i = 0; i < slice.length; ++i) {
+    const string text(slice.Value(i));
+    EXPECT_EQ(text, kNumbers[i + 1]);
+    const PhoneNumberUtil::ErrorType error =
+        phone_util_.Parse(text, RegionCode::US(), &number);
+    EXPECT_EQ(error, columns_.errors[i]) << text;
+    if (error != PhoneNumberUtil::NO_PARSING_ERROR) {
+      EXPECT_EQ("null", FormattedValue(i));
+      continue;
+    }
+    EXPECT_EQ(number.country_code(), columns_.country_codes[i]) << text;
+    EXPECT_EQ(number.national_number(), columns_.national_numbers[i]) << text;
+    phone_util_.Format(number, PhoneNumberUtil::INTERNATIONAL, &formatted);
+    EXPECT_EQ(formatted, FormattedValue(i));
+  }
+
+  // The bits of a slice in the validity bitmap start at its offset.
+  builder.AppendNull();
+  builder.Append("+1 650 253 0000");
+  const StringArray column = builder.View();
+  slice = StringArray(column.data, column.offsets + 6, column.validity, 6, 3);
+  EXPECT_FALSE(slice.IsNull(0));
+  EXPECT_TRUE(slice.IsNull(1));
+  EXPECT_FALSE(slice.IsNull(2));
+  columnar_.ParseColumn(slice, NULL, RegionCode::US(), options, &columns_);
+  ASSERT_EQ(3U, columns_.errors.size());
+  EXPECT_EQ("+39 02 3661 8300", FormattedValue(0));
+  EXPECT_EQ("null", FormattedValue(1));
+  EXPECT_EQ(1, columns_.country_codes[2]);
+
+  // Reusing the columns for a smaller batch resizes them.
+  columnar_.ParseColumn(StringArray(), NULL, RegionCode::US(),
+                        ColumnarParseOptions(), &columns_);
+  EXPECT_TRUE(columns_.errors.empty());
+  EXPECT_TRUE(columns_.national_numbers.empty());
+  EXPECT_EQ(0, columns_.formatted.length());
+}
+
+TEST_F(ColumnarBatchTest, ParseColumnWithExecutor) {
+  static const char* const kNumbers[] = {
+    "+1 650-253-0000", "invalid", "033316005 ext. 1", "+44 7912 345 678",
+    "02 3661 8300", "tel:+64-3-331-6005",
+  };
+  const int kNumNumbers = sizeof(kNumbers) / sizeof(kNumbers[0]);
+  StringArrayBuilder builder;
+  for (int i = 0; i < 3000; ++i) {
+    if (i % 11 == 0) {
+      builder.AppendNull();
+    } else {
+      builder.Append(kNumbers[i % kNumNumbers]);
+    }
+  }
+  ColumnarParseOptions options;
+  options.number_types = true;
+  options.region_ids = true;
+  options.formatted = true;
+  columnar_.ParseColumn(builder.View(), NULL, RegionCode::IT(), options,
+                        &columns_);
+
+  WorkStealingExecutor executor(4);
+  options.executor = &executor;
+  ParsedNumberColumns parallel_columns;
+  columnar_.ParseColumn(builder.View(), NULL, RegionCode::IT(), options,
+                        &parallel_columns);
+  EXPECT_EQ(columns_.errors, parallel_columns.errors);
+  EXPECT_EQ(columns_.country_codes, parallel_columns.country_codes);
+  EXPECT_EQ(columns_.national_numbers, parallel_columns.national_numbers);
+  EXPECT_EQ(columns_.leading_zeros, parallel_columns.leading_zeros);
+  EXPECT_EQ(columns_.has_extensions, parallel_columns.has_extensions);
+  EXPECT_EQ(columns_.number_types, parallel_columns.number_types);
+  EXPECT_EQ(columns_.region_ids, parallel_columns.region_ids);
+  EXPECT_EQ(columns_.formatted.data(), parallel_columns.formatted.data());
+  EXPECT_EQ(columns_.formatted.offsets(), parallel_columns.formatted.offsets());
+  EXPECT_EQ(columns_.formatted.validity(),
+            parallel_columns.formatted.validity());
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,273 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Stress tests calling the library from many threads at once. Each test first
+// runs its workload concurrently, starting from caches that are as cold as
+// possible, then checks that every thread got the same results as a
+// sequential run. These tests are meant to be run under ThreadSanitizer too.
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/base/memory/singleton.h"
+#include "phonenumbers/concurrency_test_util.h"
+#include "phonenumbers/parse_cache.h"
+#include "phonenumbers/pattern_pool.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
+#include "phonenumbers/shortnumberinfo.h"
+#include "phonenumbers/test_util.h"
+
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+#include "phonenumbers/phonenumbermatch.h"
+#include "phonenumbers/phonenumbermatcher.h"
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::vector;
+
+namespace {
+
+struct ParseTestCase {
+  const char* number_to_parse;
+  const char* region_code;
+};
+
+// A mix of inputs going through the different parsing and formatting paths.
+const ParseTestCase kParseTestCases[] = {
+  { "+1 650-253-0000", "US" },
+  { "(650) 253-0000", "US" },
+  { "1-800-SIX-FLAG", "US" },
+  { "020 8738 9353", "GB" },
+  { "+44 7912 345 678", "ZZ" },
+  { "011 44 20 8738 9353", "US" },
+  { "030 123456", "DE" },
+  { "tel:331-6005;phone-context=+64-3", "NZ" },
+  { "03-331 6005 ext. 3456", "NZ" },
+  { "+800 1234 5678", "ZZ" },
+  { "02 3661 8300", "AU" },
+  { "not a number", "US" },
+};
+
+// Parses and formats all the test cases, appending the results to 'results'.
+void ParseAndFormatAll(const PhoneNumberUtil& phone_util,
+                       vector<string>* results) {
+  const PhoneNumberUtil::PhoneNumberFormat kFormats[] = {
+    PhoneNumberUtil::E164,
+    PhoneNumberUtil::INTERNATIONAL,
+    PhoneNumberUtil::NATIONAL,
+    PhoneNumberUtil::RFC3966,
+  };
+  for (const ParseTestCase& test_case : kParseTestCases) {
+    PhoneNumber number;
+    const PhoneNumberUtil::ErrorType error = phone_util.ParseAndKeepRawInput(
+        test_case.number_to_parse, test_case.region_code, &number);
+    results->push_back(std::to_string(error));
+    if (error != PhoneNumberUtil::NO_PARSING_ERROR) {
+      continue;
+    }
+    string formatted;
+    for (const PhoneNumberUtil::PhoneNumberFormat format : kFormats) {
+      phone_util.Format(number, format, &formatted);
+      results->push_back(formatted);
+    }
+    phone_util.FormatInOriginalFormat(number, test_case.region_code,
+                                      &formatted);
+    results->push_back(formatted);
+    phone_util.FormatOutOfCountryCallingNumber(number, "CH", &formatted);
+    results->push_back(formatted);
+    results->push_back(std::to_string(phone_util.GetNumberType(number)));
+    results->push_back(phone_util.IsValidNumber(number) ? "valid" : "invalid");
+  }
+}
+
+void CheckShortNumbers(const ShortNumberInfo& short_info,
+                       vector<string>* results) {
+  const ParseTestCase kShortNumbers[] = {
+    { "911", "US" },
+    { "112", "DE" },
+    { "999", "GB" },
+    { "1234", "FR" },
+    { "18", "FR" },
+  };
+  for (const ParseTestCase& test_case : kShortNumbers) {
+    results->push_back(short_info.ConnectsToEmergencyNumber(
+        test_case.number_to_parse, test_case.region_code) ? "emergency" : "-");
+    results->push_back(short_info.IsEmergencyNumber(
+        test_case.number_to_parse, test_case.region_code) ? "exact" : "-");
+  }
+}
+
+// Singleton whose construction is slow enough for all the test threads to
+// request the instance while it is being created.
+class SlowSingleton : public Singleton<SlowSingleton> {
+ public:
+  SlowSingleton() : value(42) {
+    ++num_constructions;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  const int value;
+  static std::atomic<int> num_constructions;
+};
+
+std::atomic<int> SlowSingleton::num_constructions(0);
+
+}  // namespace
+
+class ConcurrencyTest : public testing::Test {
+ public:
+  // This type is neither copyable nor movable.
+  ConcurrencyTest(const ConcurrencyTest&) = delete;
+  ConcurrencyTest& operator=(const ConcurrencyTest&) = delete;
+
+ protected:
+  ConcurrencyTest() {}
+
+  // Runs 'workload' kNumTestIterations times on each of kNumTestThreads
+  // threads, then checks the results of every run against a sequential one.
+  void RunAndCompare(
+      const std::function<void(vector<string>*)>& workload) const {
+    vector<vector<string> > thread_results(kNumTestThreads);
+    RunConcurrently(kNumTestThreads, [&](int thread_index) {
+      vector<string>* const results = &thread_results[thread_index];
+      for (int i = 0; i < kNumTestIterations; ++i) {
+        workload(results);
+      }
+    });
+    vector<string> expected_results;
+    for (int i = 0; i < kNumTestIterations; ++i) {
+      workload(&expected_results);
+    }
+    for (int i = 0; i < kNumTestThreads; ++i) {
+      EXPECT_EQ(expected_results, thread_results[i]) << "Thread " << i;
+    }
+  }
+};
+
+TEST_F(ConcurrencyTest, SingletonIsCreatedOnce) {
+  vector<SlowSingleton*> instances(kNumTestThreads);
+  vector<int> values(kNumTestThreads);
+  RunConcurrently(kNumTestThreads, [&](int thread_index) {
+    instances[thread_index] = SlowSingleton::GetInstance();
+    values[thread_index] = instances[thread_index]->value;
+  });
+  EXPECT_EQ(1, SlowSingleton::num_constructions.load());
+  for (int i = 0; i < kNumTestThreads; ++i) {
+    EXPECT_EQ(SlowSingleton::GetInstance(), instances[i]) << "Thread " << i;
+    EXPECT_EQ(42, values[i]) << "Thread " << i;
+  }
+}
+
+TEST_F(ConcurrencyTest, ParseAndFormat) {
+  RunAndCompare([](vector<string>* results) {
+    // GetInstance() is called from every thread on purpose, to exercise the
+    // lazy initialization of the singleton.
+    ParseAndFormatAll(*PhoneNumberUtil::GetInstance(), results);
+  });
+}
+
+TEST_F(ConcurrencyTest, ShortNumberInfo) {
+  const ShortNumberInfo short_info;
+  RunAndCompare([&short_info](vector<string>* results) {
+    CheckShortNumbers(short_info, results);
+  });
+}
+
+TEST_F(ConcurrencyTest, ParseCache) {
+  // The cache is smaller than the number of test cases, so that entries are
+  // evicted and added again all the time.
+  const ParseCache cache(*PhoneNumberUtil::GetInstance(), 4);
+  RunAndCompare([&cache](vector<string>* results) {
+    for (const ParseTestCase& test_case : kParseTestCases) {
+      PhoneNumber number;
+      const PhoneNumberUtil::ErrorType error = cache.ParseAndKeepRawInput(
+          test_case.number_to_parse, test_case.region_code, &number);
+      results->push_back(std::to_string(error));
+      if (error == PhoneNumberUtil::NO_PARSING_ERROR) {
+        results->push_back(number.SerializeAsString());
+      }
+    }
+  });
+}
+
+TEST_F(ConcurrencyTest, PatternPool) {
+  static const char* const kPatterns[] = {
+    "[2-9]\\d{9}", "7\\d{9}", "(?:1|6\\d)\\d{7}", "800\\d{7}", "\\d{7,10}",
+  };
+  static const char* const kNumbers[] = {
+    "6502530000", "7912345678", "1234567", "8001234567", "123",
+  };
+  const RegExpFactory regexp_factory;
+  PatternPool pattern_pool(regexp_factory);
+  for (const char* pattern : kPatterns) {
+    pattern_pool.Intern(pattern);
+  }
+  // Every thread starts by compiling the patterns at once.
+  vector<const RegExp*> regexps(kNumTestThreads * pattern_pool.size());
+  RunConcurrently(kNumTestThreads, [&](int thread_index) {
+    for (int id = 0; id < pattern_pool.size(); ++id) {
+      regexps[thread_index * pattern_pool.size() + id] =
+          &pattern_pool.GetRegExp(id);
+    }
+  });
+  EXPECT_EQ(pattern_pool.size(), pattern_pool.num_compiled());
+  for (size_t i = 0; i < regexps.size(); ++i) {
+    EXPECT_EQ(&pattern_pool.GetRegExp(i % pattern_pool.size()), regexps[i]);
+  }
+  RunAndCompare([&pattern_pool](vector<string>* results) {
+    for (int id = 0; id < pattern_pool.size(); ++id) {
+      for (const char* number : kNumbers) {
+        results->push_back(pattern_pool.FullMatch(id, number) ? "1" : "0");
+      }
+    }
+  });
+}
+
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+TEST_F(ConcurrencyTest, PhoneNumberMatcher) {
+  const string text(
+      "Call +1 650-253-0000 or (650) 253-0001 before 10:30, otherwise "
+      "try 020 8738 9353 x12 or tel:+44-7912-345-678. Ref 2012/01/02.");
+  RunAndCompare([&text](vector<string>* results) {
+    const PhoneNumberMatcher::Leniency kLeniencies[] = {
+      PhoneNumberMatcher::POSSIBLE,
+      PhoneNumberMatcher::VALID,
+      PhoneNumberMatcher::STRICT_GROUPING,
+      PhoneNumberMatcher::EXACT_GROUPING,
+    };
+    for (const PhoneNumberMatcher::Leniency leniency : kLeniencies) {
+      PhoneNumberMatcher matcher(*PhoneNumberUtil::GetInstance(), text,
+                                 RegionCode::US(), leniency, 100);
+      PhoneNumberMatch match;
+      while (matcher.HasNext()) {
+        matcher.Next(&match);
+        results->push_back(match.ToString());
+      }
+    }
+  });
+}
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+
+}  // namespace phonenumbers
+}  // namespace i18n
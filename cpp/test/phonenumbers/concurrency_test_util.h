@@ -0,0 +1,62 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Helpers shared by the tests run by libphonenumber_concurrency_test.
+
+#ifndef I18N_PHONENUMBERS_TEST_CONCURRENCY_TEST_UTIL_H_
+#define I18N_PHONENUMBERS_TEST_CONCURRENCY_TEST_UTIL_H_
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace i18n {
+namespace phonenumbers {
+
+// Number of threads used by the concurrency tests. It is deliberately larger
+// than the number of cores of most test machines so that threads get
+// preempted in the middle of library calls.
+const int kNumTestThreads = 16;
+
+// Number of times each thread repeats its workload.
+const int kNumTestIterations = 50;
+
+// Runs 'function' on 'num_threads' threads and waits for all of them to
+// finish. The threads are released at the same time to maximize contention,
+// in particular on lazily initialized state. Each thread is passed its index.
+inline void RunConcurrently(int num_threads,
+                            const std::function<void(int)>& function) {
+  std::atomic<bool> start(false);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(std::thread([&start, &function, i]() {
+      while (!start.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      function(i);
+    }));
+  }
+  start.store(true, std::memory_order_release);
+  for (std::vector<std::thread>::iterator it = threads.begin();
+       it != threads.end(); ++it) {
+    it->join();
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_TEST_CONCURRENCY_TEST_UTIL_H_
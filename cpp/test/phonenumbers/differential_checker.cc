@@ -0,0 +1,187 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/differential_checker.h"
+
+#include <algorithm>
+
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/logger.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/stringutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+string DescribeNumber(const PhoneNumber& number) {
+  return StrCat(
+      "country_code=", SimpleItoa(number.country_code()),
+      " national_number=", SimpleItoa(number.national_number()),
+      " extension=", number.extension(),
+      StrCat(" italian_leading_zero=", number.italian_leading_zero(),
+             " number_of_leading_zeros=",
+             SimpleItoa(number.number_of_leading_zeros()),
+             " raw_input=", number.raw_input()),
+      StrCat(" country_code_source=", SimpleItoa(number.country_code_source()),
+             " preferred_domestic_carrier_code=",
+             number.preferred_domestic_carrier_code()));
+}
+
+// Appends the results of the API taking a parsed number.
+void RunOnNumber(const PhoneNumberUtil& phone_util, const PhoneNumber& number,
+                 const string& region, vector<string>* transcript) {
+  transcript->push_back(StrCat("IsValidNumber: ",
+                               phone_util.IsValidNumber(number)));
+  transcript->push_back(StrCat("IsValidNumberForRegion: ",
+                               phone_util.IsValidNumberForRegion(number,
+                                                                 region)));
+  transcript->push_back(
+      StrCat("IsPossibleNumberWithReason: ",
+             SimpleItoa(phone_util.IsPossibleNumberWithReason(number))));
+  transcript->push_back(StrCat("GetNumberType: ",
+                               SimpleItoa(phone_util.GetNumberType(number))));
+  string result;
+  phone_util.GetRegionCodeForNumber(number, &result);
+  transcript->push_back(StrCat("GetRegionCodeForNumber: ", result));
+
+  static const PhoneNumberUtil::PhoneNumberFormat kFormats[] = {
+    PhoneNumberUtil::E164,
+    PhoneNumberUtil::INTERNATIONAL,
+    PhoneNumberUtil::NATIONAL,
+    PhoneNumberUtil::RFC3966,
+  };
+  for (PhoneNumberUtil::PhoneNumberFormat format : kFormats) {
+    phone_util.Format(number, format, &result);
+    transcript->push_back(StrCat("Format(", SimpleItoa(format), "): ", result));
+  }
+  phone_util.FormatInOriginalFormat(number, region, &result);
+  transcript->push_back(StrCat("FormatInOriginalFormat: ", result));
+  phone_util.FormatOutOfCountryCallingNumber(number, region, &result);
+  transcript->push_back(StrCat("FormatOutOfCountryCallingNumber: ", result));
+  phone_util.FormatOutOfCountryKeepingAlphaChars(number, region, &result);
+  transcript->push_back(StrCat("FormatOutOfCountryKeepingAlphaChars: ",
+                               result));
+  phone_util.FormatNumberForMobileDialing(number, region, true, &result);
+  transcript->push_back(StrCat("FormatNumberForMobileDialing: ", result));
+  phone_util.FormatNationalNumberWithPreferredCarrierCode(number, "15",
+                                                          &result);
+  transcript->push_back(
+      StrCat("FormatNationalNumberWithPreferredCarrierCode: ", result));
+
+  transcript->push_back(StrCat(
+      "GetLengthOfGeographicalAreaCode: ",
+      SimpleItoa(phone_util.GetLengthOfGeographicalAreaCode(number))));
+  transcript->push_back(StrCat(
+      "GetLengthOfNationalDestinationCode: ",
+      SimpleItoa(phone_util.GetLengthOfNationalDestinationCode(number))));
+  transcript->push_back(StrCat("IsNumberGeographical: ",
+                               phone_util.IsNumberGeographical(number)));
+  transcript->push_back(StrCat("CanBeInternationallyDialled: ",
+                               phone_util.CanBeInternationallyDialled(number)));
+  phone_util.GetNationalSignificantNumber(number, &result);
+  transcript->push_back(StrCat("GetNationalSignificantNumber: ", result));
+
+  PhoneNumber truncated(number);
+  const bool truncated_ok = phone_util.TruncateTooLongNumber(&truncated);
+  transcript->push_back(StrCat("TruncateTooLongNumber: ", truncated_ok, " ",
+                               DescribeNumber(truncated)));
+}
+
+}  // namespace
+
+// static
+const PhoneNumberUtil& DifferentialChecker::GetReferenceInstance() {
+  static const PhoneNumberUtil* const reference_util = [] {
+    // Constructing an instance replaces the logger implementation, which is
+    // owned by the shared instance: make sure it exists first, and restore its
+    // logger afterwards.
+    PhoneNumberUtil::GetInstance();
+    Logger* const logger = Logger::mutable_logger_impl();
+    const PhoneNumberUtil* const util = new PhoneNumberUtil(false);
+    Logger::set_logger_impl(logger);
+    return util;
+  }();
+  return *reference_util;
+}
+
+DifferentialChecker::DifferentialChecker()
+    : fast_util_(*PhoneNumberUtil::GetInstance()),
+      reference_util_(GetReferenceInstance()) {}
+
+string DifferentialChecker::Check(const string& text,
+                                  const string& region) const {
+  vector<string> fast_transcript;
+  Run(fast_util_, text, region, &fast_transcript);
+  vector<string> reference_transcript;
+  Run(reference_util_, text, region, &reference_transcript);
+
+  // Both instances make the same calls, so the transcripts only differ in the
+  // results.
+  DCHECK_EQ(fast_transcript.size(), reference_transcript.size());
+  const std::pair<vector<string>::const_iterator,
+                  vector<string>::const_iterator> mismatch =
+      std::mismatch(fast_transcript.begin(), fast_transcript.end(),
+                    reference_transcript.begin());
+  if (mismatch.first == fast_transcript.end()) {
+    return "";
+  }
+  return StrCat("On \"", text, "\" in region \"", region, "\": fast path ",
+                StrCat("\"", *mismatch.first, "\", reference \"",
+                       *mismatch.second, "\""));
+}
+
+// static
+void DifferentialChecker::Run(const PhoneNumberUtil& phone_util,
+                              const string& text, const string& region,
+                              vector<string>* transcript) {
+  PhoneNumber number;
+  PhoneNumberUtil::ErrorType error = phone_util.Parse(text, region, &number);
+  transcript->push_back(StrCat("Parse: ", SimpleItoa(error), " ",
+                               DescribeNumber(number)));
+  if (error == PhoneNumberUtil::NO_PARSING_ERROR) {
+    RunOnNumber(phone_util, number, region, transcript);
+  }
+  number.Clear();
+  error = phone_util.ParseAndKeepRawInput(text, region, &number);
+  transcript->push_back(StrCat("ParseAndKeepRawInput: ", SimpleItoa(error),
+                               " ", DescribeNumber(number)));
+  if (error == PhoneNumberUtil::NO_PARSING_ERROR) {
+    RunOnNumber(phone_util, number, region, transcript);
+  }
+
+  transcript->push_back(StrCat("IsAlphaNumber: ",
+                               phone_util.IsAlphaNumber(text)));
+  string normalized(text);
+  phone_util.NormalizeDigitsOnly(&normalized);
+  transcript->push_back(StrCat("NormalizeDigitsOnly: ", normalized));
+  normalized = text;
+  phone_util.NormalizeDiallableCharsOnly(&normalized);
+  transcript->push_back(StrCat("NormalizeDiallableCharsOnly: ", normalized));
+  normalized = text;
+  phone_util.ConvertAlphaCharactersInNumber(&normalized);
+  transcript->push_back(StrCat("ConvertAlphaCharactersInNumber: ",
+                               normalized));
+  transcript->push_back(StrCat("IsPossibleNumberForString: ",
+                               phone_util.IsPossibleNumberForString(text,
+                                                                    region)));
+  transcript->push_back(StrCat(
+      "IsNumberMatchWithTwoStrings: ",
+      SimpleItoa(phone_util.IsNumberMatchWithTwoStrings(text, text))));
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,66 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the results of the public PhoneNumberUtil API between the shared
+// instance and an instance that evaluates the original regular expressions
+// instead of the hand-written fast paths, such as the precompiled
+// international prefix matchers, the tel URI tokenizer and the hot metadata.
+// This is used both by the differential fuzz target and by the replay of its
+// corpus in the unit tests.
+
+#ifndef I18N_PHONENUMBERS_TEST_DIFFERENTIAL_CHECKER_H_
+#define I18N_PHONENUMBERS_TEST_DIFFERENTIAL_CHECKER_H_
+
+#include <string>
+#include <vector>
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+class PhoneNumberUtil;
+
+class DifferentialChecker {
+ public:
+  DifferentialChecker();
+
+  // This type is neither copyable nor movable.
+  DifferentialChecker(const DifferentialChecker&) = delete;
+  DifferentialChecker& operator=(const DifferentialChecker&) = delete;
+
+  // Runs the API on text, parsed with region as the default region and also
+  // used as the region calling from. Returns a description of the first
+  // result that differs between the two instances, or an empty string if they
+  // all agree.
+  string Check(const string& text, const string& region) const;
+
+ private:
+  // Returns the instance with the fast paths disabled. It is never destroyed,
+  // like the shared instance.
+  static const PhoneNumberUtil& GetReferenceInstance();
+
+  // Appends one line per API call made on text by phone_util to transcript.
+  static void Run(const PhoneNumberUtil& phone_util, const string& text,
+                  const string& region, vector<string>* transcript);
+
+  const PhoneNumberUtil& fast_util_;
+  const PhoneNumberUtil& reference_util_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_TEST_DIFFERENTIAL_CHECKER_H_
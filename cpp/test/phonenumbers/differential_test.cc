@@ -0,0 +1,88 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays the corpus of the differential fuzz target, and a deterministic
+// sample of inputs built from the tokens handled by the fast paths.
+
+#include "phonenumbers/differential_checker.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+// The reference implementation is superlinear on some inputs, so that the fuzz
+// target is limited to inputs of this size, see fuzz_differential.options.
+const size_t kMaxInputLength = 512;
+
+}  // namespace
+
+TEST(DifferentialTest, ReplayFuzzCorpus) {
+  const DifferentialChecker checker;
+  int num_inputs = 0;
+  for (const std::filesystem::directory_entry& entry :
+       std::filesystem::directory_iterator(FUZZ_CORPUS_DIR)) {
+    std::ifstream file(entry.path(), std::ios::binary);
+    string data((std::istreambuf_iterator<char>(file)),
+                std::istreambuf_iterator<char>());
+    data.resize(std::min(data.size(), kMaxInputLength));
+    // Like the fuzz target, the first two bytes are the region.
+    const string region(data.substr(0, 2));
+    const string text(data.size() > 2 ? data.substr(2) : "");
+    EXPECT_EQ("", checker.Check(text, region)) << entry.path();
+    ++num_inputs;
+  }
+  EXPECT_GT(num_inputs, 0);
+}
+
+TEST(DifferentialTest, RandomInputs) {
+  static const char* const kTokens[] = {
+    "+", "00", "011", "0011", "tel:", ";phone-context=", ";ext=", ";isub=",
+    "0", "1", "2", "3", "5", "6", "7", "8", "9", " ", "-", "(", ")", ".", "/",
+    "/x", " x ", "ext", "A", "b", "FLOWERS", "\n", "\r", "\xC5\xBF",
+    "\xEF\xBC\x91", "example.com", "+1", "+44", "+800",
+  };
+  static const char* const kRegions[] = {
+    "US", "GB", "AU", "NZ", "IT", "DE", "AR", "MX", "JP", "KR", "001", "ZZ", "",
+  };
+  const int num_tokens = sizeof(kTokens) / sizeof(kTokens[0]);
+  const int num_regions = sizeof(kRegions) / sizeof(kRegions[0]);
+
+  const DifferentialChecker checker;
+  unsigned int random = 1;
+  for (int i = 0; i < 3000; ++i) {
+    random = random * 1103515245 + 12345;
+    const string region(kRegions[(random >> 16) % num_regions]);
+    random = random * 1103515245 + 12345;
+    const int length = (random >> 16) % 16;
+    string text;
+    for (int j = 0; j < length; ++j) {
+      random = random * 1103515245 + 12345;
+      text.append(kTokens[(random >> 16) % num_tokens]);
+    }
+    const string difference = checker.Check(text, region);
+    ASSERT_EQ("", difference);
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
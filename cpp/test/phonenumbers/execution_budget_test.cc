@@ -0,0 +1,95 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/execution_budget.h"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+TEST(ExecutionBudgetTest, MaxSteps) {
+  ExecutionBudget budget;
+  budget.set_max_steps(2);
+  EXPECT_EQ(0, budget.RemainingMilliseconds());
+  EXPECT_TRUE(budget.Consume());
+  EXPECT_TRUE(budget.Consume());
+  EXPECT_FALSE(budget.IsExhausted());
+  EXPECT_FALSE(budget.Consume());
+  EXPECT_TRUE(budget.IsExhausted());
+  EXPECT_FALSE(budget.Consume());
+  EXPECT_EQ(3, budget.steps());
+}
+
+TEST(ExecutionBudgetTest, Deadline) {
+  ExecutionBudget budget;
+  budget.set_timeout(std::chrono::hours(1));
+  EXPECT_TRUE(budget.Consume());
+  EXPECT_LT(3500000, budget.RemainingMilliseconds());
+
+  budget.set_deadline(ExecutionBudget::Clock::now());
+  // There is always some time left for a regular expression to run.
+  EXPECT_EQ(1, budget.RemainingMilliseconds());
+  EXPECT_FALSE(budget.Consume());
+  EXPECT_TRUE(budget.IsExhausted());
+}
+
+TEST(ExecutionBudgetTest, ScopedExecutionBudget) {
+  EXPECT_TRUE(ExecutionBudget::Current() == NULL);
+  ExecutionBudget outer_budget;
+  {
+    const ScopedExecutionBudget outer_scope(&outer_budget);
+    EXPECT_EQ(&outer_budget, ExecutionBudget::Current());
+    ExecutionBudget inner_budget;
+    {
+      const ScopedExecutionBudget inner_scope(&inner_budget);
+      EXPECT_EQ(&inner_budget, ExecutionBudget::Current());
+      {
+        const ScopedExecutionBudget null_scope(NULL);
+        EXPECT_EQ(&inner_budget, ExecutionBudget::Current());
+      }
+      EXPECT_EQ(&inner_budget, ExecutionBudget::Current());
+    }
+    EXPECT_EQ(&outer_budget, ExecutionBudget::Current());
+  }
+  EXPECT_TRUE(ExecutionBudget::Current() == NULL);
+}
+
+TEST(ExecutionBudgetTest, RegExpsConsumeSteps) {
+  const RegExpFactory regexp_factory;
+  const scoped_ptr<const RegExp> regexp(regexp_factory.CreateRegExp("\\d+"));
+  ExecutionBudget budget;
+  budget.set_max_steps(2);
+  // Regular expressions evaluated outside the scope are unbounded.
+  EXPECT_TRUE(regexp->FullMatch("123"));
+  {
+    const ScopedExecutionBudget scoped_budget(&budget);
+    EXPECT_TRUE(regexp->FullMatch("123"));
+    EXPECT_TRUE(regexp->Consume("123", NULL));
+    // The budget is exhausted, so that the regular expression isn't evaluated.
+    EXPECT_FALSE(regexp->FullMatch("123"));
+  }
+  EXPECT_EQ(3, budget.steps());
+  EXPECT_TRUE(budget.IsExhausted());
+  EXPECT_TRUE(regexp->FullMatch("123"));
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,202 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Note that these tests use the test metadata, not the normal metadata file.
+
+#include "phonenumbers/executor.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/test_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+namespace {
+
+// An executor of the host, which starts a thread per task.
+class ThreadPerTaskExecutor : public Executor {
+ public:
+  ThreadPerTaskExecutor() : tasks_scheduled_(0) {}
+
+  ~ThreadPerTaskExecutor() {
+    for (vector<std::thread>::iterator it = threads_.begin();
+         it != threads_.end(); ++it) {
+      it->join();
+    }
+  }
+
+  int Concurrency() const {
+    return 3;
+  }
+
+  void Schedule(std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++tasks_scheduled_;
+    threads_.push_back(std::thread(task));
+  }
+
+  int tasks_scheduled() const {
+    return tasks_scheduled_;
+  }
+
+ private:
+  std::mutex mutex_;
+  vector<std::thread> threads_;
+  int tasks_scheduled_;
+};
+
+// Checks that ParallelFor() calls its body on each item exactly once.
+void ExpectEachItemProcessedOnce(Executor* executor, int64 size,
+                                 int64 cost_per_item_ns) {
+  vector<std::atomic<int> > calls(size);
+  for (int64 i = 0; i < size; ++i) {
+    calls[i] = 0;
+  }
+  ParallelFor(executor, size, cost_per_item_ns, [&](int64 begin, int64 end) {
+    ASSERT_LE(0, begin);
+    ASSERT_LT(begin, end);
+    ASSERT_LE(end, size);
+    for (int64 i = begin; i < end; ++i) {
+      ++calls[i];
+    }
+  });
+  for (int64 i = 0; i < size; ++i) {
+    ASSERT_EQ(1, calls[i]) << i;
+  }
+}
+
+}  // namespace
+
+TEST(ExecutorTest, ParallelForWithoutExecutor) {
+  int calls = 0;
+  ParallelFor(NULL, 1000, 1000000, [&](int64 begin, int64 end) {
+    EXPECT_EQ(0, begin);
+    EXPECT_EQ(1000, end);
+    ++calls;
+  });
+  EXPECT_EQ(1, calls);
+  ParallelFor(NULL, 0, 1000, [&](int64, int64) { ++calls; });
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ExecutorTest, ParallelForProcessesSmallBatchesInline) {
+  WorkStealingExecutor executor(4);
+  const std::thread::id calling_thread = std::this_thread::get_id();
+  int calls = 0;
+  // 100 items of 100 ns are cheaper than a chunk.
+  ParallelFor(&executor, 100, 100, [&](int64 begin, int64 end) {
+    EXPECT_EQ(calling_thread, std::this_thread::get_id());
+    EXPECT_EQ(0, begin);
+    EXPECT_EQ(100, end);
+    ++calls;
+  });
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ExecutorTest, ParallelForProcessesEachItemOnce) {
+  WorkStealingExecutor executor(4);
+  ExpectEachItemProcessedOnce(&executor, 1, 1000000);
+  ExpectEachItemProcessedOnce(&executor, 7, 1000000);
+  ExpectEachItemProcessedOnce(&executor, 100000, 1000);
+  ExpectEachItemProcessedOnce(&executor, 100001, 1);
+}
+
+TEST(ExecutorTest, ParallelForWithHostExecutor) {
+  ThreadPerTaskExecutor executor;
+  ExpectEachItemProcessedOnce(&executor, 1000, 1000000);
+  // No more tasks than the executor runs concurrently are scheduled.
+  EXPECT_LT(0, executor.tasks_scheduled());
+  EXPECT_GE(3, executor.tasks_scheduled());
+}
+
+TEST(ExecutorTest, NestedParallelFor) {
+  // The threads of the executor running the outer loop also run the inner
+  // ones, which mustn't wait for threads which are all busy.
+  WorkStealingExecutor executor(2);
+  std::atomic<int64> sum(0);
+  ParallelFor(&executor, 16, 1000000, [&](int64 begin, int64 end) {
+    for (int64 i = begin; i < end; ++i) {
+      ParallelFor(&executor, 1000, 1000000, [&](int64 inner_begin,
+                                                int64 inner_end) {
+        sum += inner_end - inner_begin;
+      });
+    }
+  });
+  EXPECT_EQ(16 * 1000, sum);
+}
+
+TEST(ExecutorTest, WorkStealingExecutorRunsScheduledTasks) {
+  std::atomic<int> tasks_run(0);
+  {
+    WorkStealingExecutor executor(3);
+    EXPECT_EQ(3, executor.Concurrency());
+    for (int i = 0; i < 1000; ++i) {
+      executor.Schedule([&tasks_run, &executor] {
+        // Tasks scheduled by tasks go to the queue of their thread.
+        executor.Schedule([&tasks_run] { ++tasks_run; });
+        ++tasks_run;
+      });
+    }
+    // The destructor runs the tasks still queued.
+  }
+  EXPECT_EQ(2000, tasks_run);
+  // One thread per hardware thread by default.
+  WorkStealingExecutor default_executor(0);
+  EXPECT_LE(1, default_executor.Concurrency());
+}
+
+TEST(ExecutorTest, ParseBatchWithExecutor) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  static const char* const kNumbers[] = {
+    "+1 650-253-0000", "invalid", "033316005 ext. 1", "+44 7912 345 678",
+    "+39 02 3661 8300", "tel:+64-3-331-6005", "0",
+  };
+  const int kNumNumbers = sizeof(kNumbers) / sizeof(kNumbers[0]);
+  std::vector<string> numbers_to_parse;
+  for (int i = 0; i < 2000; ++i) {
+    numbers_to_parse.push_back(kNumbers[i % kNumNumbers]);
+  }
+  google::protobuf::Arena arena;
+  std::vector<PhoneNumber*> numbers;
+  std::vector<PhoneNumberUtil::ErrorType> errors;
+  phone_util.ParseBatch(numbers_to_parse, RegionCode::NZ(), false, &arena,
+                        &numbers, &errors);
+  WorkStealingExecutor executor(4);
+  std::vector<PhoneNumber*> parallel_numbers;
+  std::vector<PhoneNumberUtil::ErrorType> parallel_errors;
+  phone_util.ParseBatch(numbers_to_parse, RegionCode::NZ(), false, &arena,
+                        &executor, &parallel_numbers, &parallel_errors);
+  ASSERT_EQ(numbers_to_parse.size(), parallel_numbers.size());
+  ASSERT_EQ(numbers_to_parse.size(), parallel_errors.size());
+  for (size_t i = 0; i < numbers_to_parse.size(); ++i) {
+    EXPECT_EQ(errors[i], parallel_errors[i]) << numbers_to_parse[i];
+    EXPECT_EQ(*numbers[i], *parallel_numbers[i]) << numbers_to_parse[i];
+    EXPECT_EQ(&arena, parallel_numbers[i]->GetArena());
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,63 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Types fuzzed text into an AsYouTypeFormatter, remembering the position of
+// some of the characters, and fails on the text formatted in more than linear
+// time.
+#include <string>
+
+#include "phonenumbers/asyoutypeformatter.h"
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/utf/unicodetext.h"
+#include "fuzz_timing.h"
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzedDataProvider fuzzed_data(data, size);
+
+    std::string region = fuzzed_data.ConsumeBytesAsString(2);
+    unsigned int remember_position_every =
+        fuzzed_data.ConsumeIntegralInRange<unsigned int>(1, 16);
+    std::string text = fuzzed_data.ConsumeRemainingBytesAsString();
+
+    i18n::phonenumbers::UnicodeText unicode_text;
+    unicode_text.PointToUTF8(text.data(), static_cast<int>(text.size()));
+    if (!unicode_text.UTF8WasValid()) {
+      return 0;
+    }
+    const i18n::phonenumbers::scoped_ptr<
+        i18n::phonenumbers::AsYouTypeFormatter> formatter(
+            i18n::phonenumbers::PhoneNumberUtil::GetInstance()
+                ->GetAsYouTypeFormatter(region));
+    std::string result;
+    const i18n::phonenumbers::LinearTimeAssertion assertion(
+        "AsYouTypeFormatter", text.size());
+    unsigned int typed = 0;
+    for (i18n::phonenumbers::UnicodeText::const_iterator it =
+             unicode_text.begin();
+         it != unicode_text.end(); ++it) {
+      if (++typed % remember_position_every == 0) {
+        formatter->InputDigitAndRememberPosition(*it, &result);
+        formatter->GetRememberedPosition();
+      } else {
+        formatter->InputDigit(*it, &result);
+      }
+    }
+    formatter->Clear();
+
+    return 0;
+}
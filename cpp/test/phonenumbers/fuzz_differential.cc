@@ -0,0 +1,42 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Runs the public PhoneNumberUtil API on fuzzed text with and without the fast
+// paths, and fails on the first result that differs. The corpus is replayed by
+// the unit tests, see differential_test.cc. The inputs are kept short since the
+// reference implementation is superlinear on some of them.
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "phonenumbers/differential_checker.h"
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzedDataProvider fuzzed_data(data, size);
+
+    std::string region = fuzzed_data.ConsumeBytesAsString(2);
+    std::string input = fuzzed_data.ConsumeRemainingBytesAsString();
+
+    static const i18n::phonenumbers::DifferentialChecker checker;
+    const std::string difference = checker.Check(input, region);
+    if (!difference.empty()) {
+      fprintf(stderr, "%s\n", difference.c_str());
+      abort();
+    }
+
+    return 0;
+}
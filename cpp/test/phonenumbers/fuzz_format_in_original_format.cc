@@ -0,0 +1,48 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Formats the numbers parsed from fuzzed text in their original format, and
+// fails on the text parsed and formatted in more than linear time.
+#include <string>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "fuzz_timing.h"
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzedDataProvider fuzzed_data(data, size);
+
+    std::string region = fuzzed_data.ConsumeBytesAsString(2);
+    std::string region_calling_from = fuzzed_data.ConsumeBytesAsString(2);
+    std::string input = fuzzed_data.ConsumeRemainingBytesAsString();
+
+    const i18n::phonenumbers::PhoneNumberUtil& phone_util =
+        *i18n::phonenumbers::PhoneNumberUtil::GetInstance();
+    const i18n::phonenumbers::LinearTimeAssertion assertion(
+        "FormatInOriginalFormat", input.size());
+    i18n::phonenumbers::PhoneNumber number;
+    if (phone_util.ParseAndKeepRawInput(input, region, &number) !=
+        i18n::phonenumbers::PhoneNumberUtil::NO_PARSING_ERROR) {
+      return 0;
+    }
+    std::string formatted;
+    phone_util.FormatInOriginalFormat(number, region_calling_from, &formatted);
+    phone_util.FormatOutOfCountryKeepingAlphaChars(number, region_calling_from,
+                                                   &formatted);
+
+    return 0;
+}
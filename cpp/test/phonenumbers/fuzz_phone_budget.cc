@@ -0,0 +1,74 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Performance fuzz target: crashes on the inputs for which parsing or matching
+// runs out of a budget growing linearly with their size, which legitimate input
+// fits in by far, so that the fuzzer reports them as findings.
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "phonenumbers/execution_budget.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumbermatch.h"
+#include "phonenumbers/phonenumbermatcher.h"
+#include "phonenumbers/phonenumberutil.h"
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+namespace {
+
+// Parsing evaluates a few dozen regular expressions, plus one per character
+// skipped before the number. Matching evaluates up to a few per character.
+const int kBaseSteps = 1000;
+const int kParseStepsPerByte = 2;
+const int kMatchStepsPerByte = 20;
+// Generous for sanitizer builds, but well beyond the p99 latency of a call.
+const std::chrono::microseconds kBaseTimeout(50000);
+const std::chrono::microseconds kTimeoutPerByte(100);
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzedDataProvider fuzzed_data(data, size);
+
+    std::string region = fuzzed_data.ConsumeBytesAsString(2);
+    std::string input = fuzzed_data.ConsumeRemainingBytesAsString();
+
+    i18n::phonenumbers::PhoneNumberUtil *phone_util = i18n::phonenumbers::PhoneNumberUtil::GetInstance();
+
+    i18n::phonenumbers::ExecutionBudget parse_budget;
+    parse_budget.set_timeout(kBaseTimeout + kTimeoutPerByte * input.size());
+    parse_budget.set_max_steps(kBaseSteps + kParseStepsPerByte * input.size());
+    i18n::phonenumbers::PhoneNumber parsed;
+    if (phone_util->ParseWithBudget(input, region, &parse_budget, &parsed) ==
+        i18n::phonenumbers::PhoneNumberUtil::DEADLINE_EXCEEDED) {
+      abort();
+    }
+
+    i18n::phonenumbers::ExecutionBudget match_budget;
+    match_budget.set_timeout(kBaseTimeout + kTimeoutPerByte * input.size());
+    match_budget.set_max_steps(kBaseSteps + kMatchStepsPerByte * input.size());
+    i18n::phonenumbers::PhoneNumberMatcher matcher(
+        *phone_util, input, region,
+        i18n::phonenumbers::PhoneNumberMatcher::VALID, 65535, &match_budget);
+    i18n::phonenumbers::PhoneNumberMatch match;
+    while (matcher.Next(&match)) {}
+    if (matcher.IsBudgetExhausted()) {
+      abort();
+    }
+
+    return 0;
+}
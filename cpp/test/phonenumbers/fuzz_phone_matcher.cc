@@ -0,0 +1,56 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Searches fuzzed text for phone numbers at every leniency, and fails on the
+// text searched in more than linear time.
+#include <string>
+
+#include "phonenumbers/phonenumbermatch.h"
+#include "phonenumbers/phonenumbermatcher.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "fuzz_timing.h"
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    using i18n::phonenumbers::PhoneNumberMatcher;
+
+    FuzzedDataProvider fuzzed_data(data, size);
+
+    std::string region = fuzzed_data.ConsumeBytesAsString(2);
+    int max_tries = fuzzed_data.ConsumeIntegralInRange<int>(0, 65535);
+    std::string text = fuzzed_data.ConsumeRemainingBytesAsString();
+
+    const i18n::phonenumbers::PhoneNumberUtil& phone_util =
+        *i18n::phonenumbers::PhoneNumberUtil::GetInstance();
+    const PhoneNumberMatcher::Leniency leniencies[] = {
+      PhoneNumberMatcher::POSSIBLE,
+      PhoneNumberMatcher::VALID,
+      PhoneNumberMatcher::STRICT_GROUPING,
+      PhoneNumberMatcher::EXACT_GROUPING,
+    };
+    for (size_t i = 0; i < sizeof(leniencies) / sizeof(leniencies[0]); ++i) {
+      const i18n::phonenumbers::LinearTimeAssertion assertion(
+          "PhoneNumberMatcher", text.size());
+      PhoneNumberMatcher matcher(phone_util, text, region, leniencies[i],
+                                 max_tries);
+      i18n::phonenumbers::PhoneNumberMatch match;
+      while (matcher.Next(&match)) {
+        match.ToString();
+      }
+    }
+
+    return 0;
+}
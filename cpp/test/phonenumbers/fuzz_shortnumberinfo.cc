@@ -0,0 +1,55 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Classifies the short numbers found in fuzzed text, and fails on the text
+// classified in more than linear time.
+#include <string>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/shortnumberinfo.h"
+#include "fuzz_timing.h"
+
+#include <fuzzer/FuzzedDataProvider.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    FuzzedDataProvider fuzzed_data(data, size);
+
+    std::string region = fuzzed_data.ConsumeBytesAsString(2);
+    std::string input = fuzzed_data.ConsumeRemainingBytesAsString();
+
+    static const i18n::phonenumbers::ShortNumberInfo short_info;
+    const i18n::phonenumbers::LinearTimeAssertion assertion(
+        "ShortNumberInfo", input.size());
+    short_info.IsEmergencyNumber(input, region);
+    short_info.ConnectsToEmergencyNumber(input, region);
+    i18n::phonenumbers::PhoneNumber number;
+    if (i18n::phonenumbers::PhoneNumberUtil::GetInstance()->Parse(
+            input, region, &number) !=
+        i18n::phonenumbers::PhoneNumberUtil::NO_PARSING_ERROR) {
+      return 0;
+    }
+    short_info.IsPossibleShortNumber(number);
+    short_info.IsPossibleShortNumberForRegion(number, region);
+    short_info.IsValidShortNumber(number);
+    short_info.IsValidShortNumberForRegion(number, region);
+    short_info.GetExpectedCost(number);
+    short_info.GetExpectedCostForRegion(number, region);
+    short_info.IsCarrierSpecific(number);
+    short_info.IsCarrierSpecificForRegion(number, region);
+    short_info.IsSmsServiceForRegion(number, region);
+
+    return 0;
+}
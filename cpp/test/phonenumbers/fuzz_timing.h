@@ -0,0 +1,77 @@
+/* Copyright 2026 Google Inc.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+// Per-input timing assertions for the performance fuzz targets. libFuzzer's
+// -report_slow_units only logs the slow inputs, whereas a failed assertion is
+// reported as a crash, so that the input is kept in the regression corpus.
+//
+// {
+//   const LinearTimeAssertion assertion("PhoneNumberMatcher", input.size());
+//   ... Code expected to run in linear time ...
+// }
+
+#ifndef I18N_PHONENUMBERS_FUZZ_TIMING_H_
+#define I18N_PHONENUMBERS_FUZZ_TIMING_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+namespace i18n {
+namespace phonenumbers {
+
+// Aborts on destruction if more time than a budget growing linearly with the
+// size of the input elapsed since construction. The budget is generous enough
+// for sanitizer builds and busy fuzzing machines, while super-linear behavior
+// exceeds it by far on the inputs of a few kilobytes that the fuzzers produce.
+class LinearTimeAssertion {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  LinearTimeAssertion(const char* operation, size_t input_size)
+      : operation_(operation),
+        budget_(kBaseBudget + kBudgetPerByte * input_size),
+        start_(Clock::now()) {}
+
+  ~LinearTimeAssertion() {
+    const Clock::duration elapsed = Clock::now() - start_;
+    if (elapsed > budget_) {
+      fprintf(stderr, "%s took %lld us, more than its budget of %lld us.\n",
+              operation_,
+              static_cast<long long>(std::chrono::duration_cast<
+                  std::chrono::microseconds>(elapsed).count()),
+              static_cast<long long>(std::chrono::duration_cast<
+                  std::chrono::microseconds>(budget_).count()));
+      abort();
+    }
+  }
+
+  // This type is neither copyable nor movable.
+  LinearTimeAssertion(const LinearTimeAssertion&) = delete;
+  LinearTimeAssertion& operator=(const LinearTimeAssertion&) = delete;
+
+ private:
+  static constexpr std::chrono::microseconds kBaseBudget{50000};
+  static constexpr std::chrono::microseconds kBudgetPerByte{100};
+
+  const char* const operation_;
+  const Clock::duration budget_;
+  const Clock::time_point start_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_FUZZ_TIMING_H_
@@ -0,0 +1,104 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unicode/locid.h>
+
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/concurrency_test_util.h"
+#include "phonenumbers/geocoding/geocoding_test_data.h"
+#include "phonenumbers/geocoding/phonenumber_offline_geocoder.h"
+#include "phonenumbers/phonenumber.pb.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using icu::Locale;
+using std::string;
+using std::vector;
+
+namespace {
+
+PhoneNumber MakeNumber(int32 country_code, uint64 national_number) {
+  PhoneNumber n;
+  n.set_country_code(country_code);
+  n.set_national_number(national_number);
+  return n;
+}
+
+// Looks up descriptions for numbers and locales spread over the test data so
+// that threads concurrently load different prefix description maps.
+void GetDescriptions(const PhoneNumberOfflineGeocoder& geocoder,
+                     vector<string>* results) {
+  const PhoneNumber kNumbers[] = {
+    MakeNumber(82, 22123456UL),
+    MakeNumber(82, 322123456UL),
+    MakeNumber(82, uint64{6421234567}),
+    MakeNumber(1, uint64{6502530000}),
+    MakeNumber(1, 2128120000UL),
+    MakeNumber(1, 2423651234UL),
+    MakeNumber(61, 236618300UL),
+    MakeNumber(800, 12345678UL),
+  };
+  const Locale kLocales[] = {
+    Locale("en", "GB"),
+    Locale("fr", "FR"),
+    Locale("de", "DE"),
+    Locale("ko", "KR"),
+    Locale("zh", "CN"),
+  };
+  for (const Locale& locale : kLocales) {
+    for (const PhoneNumber& number : kNumbers) {
+      results->push_back(geocoder.GetDescriptionForNumber(number, locale));
+      results->push_back(
+          geocoder.GetDescriptionForNumber(number, locale, "US"));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(GeocoderConcurrencyTest, GetDescriptionForNumber) {
+  const scoped_ptr<PhoneNumberOfflineGeocoder> geocoder(
+      new PhoneNumberOfflineGeocoder(
+          get_test_country_calling_codes(),
+          get_test_country_calling_codes_size(),
+          get_test_country_languages,
+          get_test_prefix_language_code_pairs(),
+          get_test_prefix_language_code_pairs_size(),
+          get_test_prefix_descriptions));
+
+  // The geocoder loads its mappings lazily, so the threads race on filling the
+  // same caches.
+  vector<vector<string> > thread_results(kNumTestThreads);
+  RunConcurrently(kNumTestThreads, [&](int thread_index) {
+    for (int i = 0; i < kNumTestIterations; ++i) {
+      GetDescriptions(*geocoder, &thread_results[thread_index]);
+    }
+  });
+
+  vector<string> expected_results;
+  for (int i = 0; i < kNumTestIterations; ++i) {
+    GetDescriptions(*geocoder, &expected_results);
+  }
+  for (int i = 0; i < kNumTestThreads; ++i) {
+    EXPECT_EQ(expected_results, thread_results[i]) << "Thread " << i;
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
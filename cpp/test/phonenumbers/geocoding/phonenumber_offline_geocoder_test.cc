@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 #include <unicode/locid.h>
 
+#include "phonenumbers/allocation_counter.h"
 #include "phonenumbers/geocoding/geocoding_test_data.h"
 #include "phonenumbers/phonenumber.h"
 #include "phonenumbers/phonenumber.pb.h"
@@ -210,5 +211,16 @@ TEST_F(PhoneNumberOfflineGeocoderTest,
   EXPECT_EQ("South Korea",
             geocoder_->GetDescriptionForNumber(KO_MOBILE, kEnglishLocale));
 }
+
+TEST_F(PhoneNumberOfflineGeocoderTest, TestGetDescriptionForNumberAllocations) {
+  // The first lookup loads the mappings for the number's prefix and language.
+  EXPECT_EQ("Seoul",
+            geocoder_->GetDescriptionForNumber(KO_NUMBER1, kEnglishLocale));
+  ScopedAllocationCounter counter;
+  EXPECT_EQ("Seoul",
+            geocoder_->GetDescriptionForNumber(KO_NUMBER1, kEnglishLocale));
+  // Later lookups should not load or copy any mapping.
+  EXPECT_LE(counter.allocations(), 4);
+}
 }  // namespace phonenumbers
 }  // namespace i18n
@@ -0,0 +1,171 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/hot_metadata.h"
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/pattern_pool.h"
+#include "phonenumbers/phonemetadata.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/regexp_factory.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+void SetPossibleLengths(PhoneNumberDesc* desc, int min_length, int max_length) {
+  for (int length = min_length; length <= max_length; ++length) {
+    desc->add_possible_length(length);
+  }
+}
+
+}  // namespace
+
+class HotMetadataTest : public testing::Test {
+ protected:
+  HotMetadataTest() : pattern_pool_(regexp_factory_) {
+    metadata_.set_id("XY");
+    metadata_.set_country_code(999);
+    SetPossibleLengths(metadata_.mutable_general_desc(), 7, 10);
+    SetPossibleLengths(metadata_.mutable_general_desc(), 12, 12);
+    metadata_.mutable_general_desc()->add_possible_length_local_only(5);
+    // The fixed-line numbers have the possible lengths of the general
+    // description.
+    metadata_.mutable_fixed_line()->add_possible_length_local_only(6);
+    SetPossibleLengths(metadata_.mutable_mobile(), 9, 10);
+    metadata_.mutable_toll_free()->add_possible_length(-1);
+    metadata_.mutable_premium_rate()->add_possible_length(8);
+    metadata_.mutable_premium_rate()->add_possible_length(10);
+  }
+
+  const RegExpFactory regexp_factory_;
+  PatternPool pattern_pool_;
+  PhoneMetadata metadata_;
+};
+
+TEST_F(HotMetadataTest, Fields) {
+  metadata_.set_same_mobile_and_fixed_line_pattern(true);
+  const HotMetadata hot_metadata(metadata_, NULL, &pattern_pool_);
+  EXPECT_EQ(&metadata_, &hot_metadata.metadata());
+  EXPECT_EQ(999, hot_metadata.country_code());
+  EXPECT_TRUE(hot_metadata.same_mobile_and_fixed_line_pattern());
+  EXPECT_EQ(NULL, hot_metadata.leading_digits());
+  EXPECT_GE(128U, sizeof(hot_metadata));
+}
+
+TEST_F(HotMetadataTest, PatternIds) {
+  metadata_.mutable_general_desc()->set_national_number_pattern("\\d{7,12}");
+  metadata_.mutable_fixed_line()->set_national_number_pattern("[2-6]\\d{6,9}");
+  metadata_.mutable_mobile()->set_national_number_pattern("[2-6]\\d{6,9}");
+  const HotMetadata hot_metadata(metadata_, NULL, &pattern_pool_);
+  EXPECT_EQ("\\d{7,12}", pattern_pool_.pattern(
+      hot_metadata.pattern_id(PhoneNumberUtil::UNKNOWN)));
+  EXPECT_EQ("[2-6]\\d{6,9}", pattern_pool_.pattern(
+      hot_metadata.pattern_id(PhoneNumberUtil::FIXED_LINE)));
+  // The fixed-line and mobile descriptions share their pattern.
+  EXPECT_EQ(hot_metadata.pattern_id(PhoneNumberUtil::FIXED_LINE),
+            hot_metadata.pattern_id(PhoneNumberUtil::MOBILE));
+  EXPECT_EQ(hot_metadata.pattern_id(PhoneNumberUtil::FIXED_LINE),
+            hot_metadata.pattern_id(PhoneNumberUtil::FIXED_LINE_OR_MOBILE));
+  EXPECT_EQ(PatternPool::kNoPattern,
+            hot_metadata.pattern_id(PhoneNumberUtil::TOLL_FREE));
+  EXPECT_EQ(2, pattern_pool_.size());
+}
+
+TEST_F(HotMetadataTest, IsPossibleLengthForDesc) {
+  const HotMetadata hot_metadata(metadata_, NULL, &pattern_pool_);
+  EXPECT_TRUE(hot_metadata.IsPossibleLengthForDesc(7, PhoneNumberUtil::UNKNOWN));
+  EXPECT_FALSE(
+      hot_metadata.IsPossibleLengthForDesc(11, PhoneNumberUtil::UNKNOWN));
+  // Descriptions without possible lengths of their own don't check them.
+  EXPECT_TRUE(
+      hot_metadata.IsPossibleLengthForDesc(3, PhoneNumberUtil::FIXED_LINE));
+  EXPECT_TRUE(hot_metadata.IsPossibleLengthForDesc(
+      3, PhoneNumberUtil::FIXED_LINE_OR_MOBILE));
+  EXPECT_FALSE(hot_metadata.IsPossibleLengthForDesc(8, PhoneNumberUtil::MOBILE));
+  EXPECT_TRUE(hot_metadata.IsPossibleLengthForDesc(9, PhoneNumberUtil::MOBILE));
+  EXPECT_FALSE(
+      hot_metadata.IsPossibleLengthForDesc(9, PhoneNumberUtil::TOLL_FREE));
+  EXPECT_FALSE(
+      hot_metadata.IsPossibleLengthForDesc(40, PhoneNumberUtil::UNKNOWN));
+}
+
+TEST_F(HotMetadataTest, TestNumberLength) {
+  const HotMetadata hot_metadata(metadata_, NULL, &pattern_pool_);
+  EXPECT_EQ(PhoneNumberUtil::TOO_SHORT,
+            hot_metadata.TestNumberLength(0, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::TOO_SHORT,
+            hot_metadata.TestNumberLength(6, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE_LOCAL_ONLY,
+            hot_metadata.TestNumberLength(5, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE,
+            hot_metadata.TestNumberLength(7, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::INVALID_LENGTH,
+            hot_metadata.TestNumberLength(11, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE,
+            hot_metadata.TestNumberLength(12, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::TOO_LONG,
+            hot_metadata.TestNumberLength(13, PhoneNumberUtil::UNKNOWN));
+  EXPECT_EQ(PhoneNumberUtil::TOO_LONG,
+            hot_metadata.TestNumberLength(40, PhoneNumberUtil::UNKNOWN));
+
+  // The fixed-line numbers fall back to the possible lengths of the general
+  // description, but not to its local-only ones.
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE,
+            hot_metadata.TestNumberLength(8, PhoneNumberUtil::FIXED_LINE));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE_LOCAL_ONLY,
+            hot_metadata.TestNumberLength(6, PhoneNumberUtil::FIXED_LINE));
+  EXPECT_EQ(PhoneNumberUtil::TOO_SHORT,
+            hot_metadata.TestNumberLength(5, PhoneNumberUtil::FIXED_LINE));
+
+  EXPECT_EQ(PhoneNumberUtil::TOO_SHORT,
+            hot_metadata.TestNumberLength(8, PhoneNumberUtil::MOBILE));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE,
+            hot_metadata.TestNumberLength(10, PhoneNumberUtil::MOBILE));
+  EXPECT_EQ(PhoneNumberUtil::TOO_LONG,
+            hot_metadata.TestNumberLength(12, PhoneNumberUtil::MOBILE));
+  EXPECT_EQ(PhoneNumberUtil::INVALID_LENGTH,
+            hot_metadata.TestNumberLength(9, PhoneNumberUtil::PREMIUM_RATE));
+  // There is no toll-free number.
+  EXPECT_EQ(PhoneNumberUtil::INVALID_LENGTH,
+            hot_metadata.TestNumberLength(8, PhoneNumberUtil::TOLL_FREE));
+
+  // The possible lengths of the fixed-line and mobile numbers are merged.
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE,
+            hot_metadata.TestNumberLength(
+                12, PhoneNumberUtil::FIXED_LINE_OR_MOBILE));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE_LOCAL_ONLY,
+            hot_metadata.TestNumberLength(
+                6, PhoneNumberUtil::FIXED_LINE_OR_MOBILE));
+}
+
+TEST_F(HotMetadataTest, TestNumberLengthWithoutFixedLineNumbers) {
+  metadata_.mutable_fixed_line()->Clear();
+  metadata_.mutable_fixed_line()->add_possible_length(-1);
+  const HotMetadata hot_metadata(metadata_, NULL, &pattern_pool_);
+  EXPECT_EQ(PhoneNumberUtil::INVALID_LENGTH,
+            hot_metadata.TestNumberLength(8, PhoneNumberUtil::FIXED_LINE));
+  // Only the mobile numbers are checked.
+  EXPECT_EQ(PhoneNumberUtil::TOO_SHORT,
+            hot_metadata.TestNumberLength(
+                8, PhoneNumberUtil::FIXED_LINE_OR_MOBILE));
+  EXPECT_EQ(PhoneNumberUtil::IS_POSSIBLE,
+            hot_metadata.TestNumberLength(
+                9, PhoneNumberUtil::FIXED_LINE_OR_MOBILE));
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
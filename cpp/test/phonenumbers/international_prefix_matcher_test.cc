@@ -0,0 +1,147 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/international_prefix_matcher.h"
+
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+class InternationalPrefixMatcherTest : public testing::Test {
+ protected:
+  // Returns the end of the match of pattern at the start of number, or -1 if
+  // it doesn't match.
+  int Consume(const string& pattern, const string& number) const {
+    const InternationalPrefixMatcher matcher(pattern, regexp_factory_);
+    size_t end;
+    return matcher.Consume(number, &end) ? static_cast<int>(end) : -1;
+  }
+
+  RegExpFactory regexp_factory_;
+};
+
+TEST_F(InternationalPrefixMatcherTest, CompilesInternationalPrefixes) {
+  EXPECT_TRUE(InternationalPrefixMatcher("00", regexp_factory_).IsCompiled());
+  EXPECT_TRUE(InternationalPrefixMatcher("0[0-3]\\d", regexp_factory_)
+                  .IsCompiled());
+  EXPECT_TRUE(InternationalPrefixMatcher("00(?:30|5[09]|[126-9]?)",
+                                         regexp_factory_).IsCompiled());
+  EXPECT_TRUE(InternationalPrefixMatcher("00(?:[124-68]|[37]\\d{2})",
+                                         regexp_factory_).IsCompiled());
+  EXPECT_TRUE(InternationalPrefixMatcher("00(?:1\\d)?", regexp_factory_)
+                  .IsCompiled());
+  EXPECT_TRUE(InternationalPrefixMatcher(
+      "(?:0|1(?:1[0-69]|2[02-5]|5[13-58]|69|7[0167]|8[018]))0",
+      regexp_factory_).IsCompiled());
+}
+
+TEST_F(InternationalPrefixMatcherTest, FallsBackToRegExp) {
+  EXPECT_FALSE(InternationalPrefixMatcher("NonMatch", regexp_factory_)
+                   .IsCompiled());
+  EXPECT_FALSE(InternationalPrefixMatcher("0(0)", regexp_factory_)
+                   .IsCompiled());
+  EXPECT_FALSE(InternationalPrefixMatcher("0+", regexp_factory_).IsCompiled());
+  EXPECT_FALSE(InternationalPrefixMatcher("0[^1]", regexp_factory_)
+                   .IsCompiled());
+
+  EXPECT_EQ(-1, Consume("NonMatch", "0041446681800"));
+  EXPECT_EQ(2, Consume("0(0)", "0041446681800"));
+}
+
+TEST_F(InternationalPrefixMatcherTest, Consume) {
+  EXPECT_EQ(2, Consume("00", "0041446681800"));
+  EXPECT_EQ(-1, Consume("00", "041446681800"));
+  EXPECT_EQ(-1, Consume("00", "0"));
+  EXPECT_EQ(3, Consume("0[0-3]\\d", "0291234"));
+  EXPECT_EQ(-1, Consume("0[0-3]\\d", "0491234"));
+  // The first alternative matching is used, even if a later one is longer.
+  EXPECT_EQ(2, Consume("00|001", "0011234"));
+  EXPECT_EQ(3, Consume("001|00", "0011234"));
+  // Optional digits are matched greedily.
+  EXPECT_EQ(3, Consume("00[126-9]?", "0011234"));
+  EXPECT_EQ(2, Consume("00[126-9]?", "0031234"));
+  EXPECT_EQ(4, Consume("00(?:1\\d)?", "0012345"));
+  EXPECT_EQ(2, Consume("00(?:1\\d)?", "001"));
+  // Backtracks into an alternative when the rest of the pattern doesn't match.
+  EXPECT_EQ(4, Consume("0(?:0|00)1", "00012"));
+  EXPECT_EQ(5, Consume("0\\d{1,3}9", "00009"));
+  EXPECT_EQ(3, Consume("0\\d{1,3}9", "009009"));
+  EXPECT_EQ(8, Consume("14(?:1[14]|34|4[17]|[56]6|7[47]|88)0011",
+                       "14880011441234"));
+}
+
+TEST_F(InternationalPrefixMatcherTest, MatchesLikeRegExp) {
+  // International prefixes of the production metadata.
+  static const char* const kPatterns[] = {
+    "00",
+    "011",
+    "0[01]",
+    "0[0-3]\\d",
+    "010|0[0-2]",
+    "00|1(?:[12]\\d|79)\\d\\d00",
+    "00|1(?:0(?:01|[12]0)|100)",
+    "00(?:[125689]|3(?:[46]5|91)|7(?:00|27|3|55|6[126]))",
+    "00(?:30|5[09]|[126-9]?)",
+    "00(?:1\\d)?",
+    "0(?:0|1[3-9]\\d)",
+    "001[14-689]|14(?:1[14]|34|4[17]|[56]6|7[47]|88)0011",
+    "00|99(?:[01469]|5(?:[14]1|3[23]|5[59]|77|88|9[09]))",
+    "(?:0|1(?:1[0-69]|2[02-5]|5[13-58]|69|7[0167]|8[018]))0",
+  };
+  for (size_t i = 0; i < sizeof(kPatterns) / sizeof(kPatterns[0]); ++i) {
+    const string pattern(kPatterns[i]);
+    const InternationalPrefixMatcher matcher(pattern, regexp_factory_);
+    ASSERT_TRUE(matcher.IsCompiled()) << pattern;
+    const scoped_ptr<const RegExp> regexp(
+        regexp_factory_.CreateRegExp(pattern));
+    // Tries pseudo-random numbers made of the digits found in the pattern,
+    // which are the most likely to match it.
+    string digits;
+    for (size_t j = 0; j < pattern.length(); ++j) {
+      if (pattern[j] >= '0' && pattern[j] <= '9' &&
+          digits.find(pattern[j]) == string::npos) {
+        digits.push_back(pattern[j]);
+      }
+    }
+    unsigned int random = 1;
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+      string number;
+      while (number.length() < 12) {
+        random = random * 1103515245 + 12345;
+        number.push_back(digits[(random >> 16) % digits.length()]);
+      }
+      size_t expected_end = 0;
+      const bool expected = regexp->Consume(number, &expected_end);
+      size_t end = 0;
+      ASSERT_EQ(expected, matcher.Consume(number, &end))
+          << pattern << " " << number;
+      if (expected) {
+        EXPECT_EQ(expected_end, end) << pattern << " " << number;
+      }
+    }
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,147 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Note that these tests use the test metadata, not the normal metadata file.
+
+#include "phonenumbers/parse_cache.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/test_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+class ParseCacheTest : public testing::Test {
+ protected:
+  ParseCacheTest() : phone_util_(*PhoneNumberUtil::GetInstance()) {}
+
+  const PhoneNumberUtil& phone_util_;
+};
+
+TEST_F(ParseCacheTest, ResultsMatchPhoneNumberUtil) {
+  static const char* const kNumbers[] = {
+    "+1 650-253-0000", "(650) 253-0000 ext. 1234", "1-800-SIX-FLAG",
+    "011 44 20 8738 9353", "+44 7912 345 678", "02 3661 8300", "0000",
+    "tel:331-6005;phone-context=+64-3", "03-331 6005", "64 3 331 6005",
+    "+800 1234 5678", "0 15 1234 5678", "08122123456", "not a number", "+",
+    "",
+  };
+  static const char* const kRegions[] = { "US", "IT", "NZ", "AR", "KR", "ZZ" };
+  ParseCache cache(phone_util_, 1000);
+  int64 num_calls = 0;
+  // Each number is parsed twice, the second time from the cache.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const char* text : kNumbers) {
+      for (const char* region : kRegions) {
+        PhoneNumber expected;
+        PhoneNumber number;
+        EXPECT_EQ(phone_util_.Parse(text, region, &expected),
+                  cache.Parse(text, region, &number)) << text << " " << region;
+        EXPECT_EQ(expected, number) << text << " " << region;
+        EXPECT_EQ(phone_util_.ParseAndKeepRawInput(text, region, &expected),
+                  cache.ParseAndKeepRawInput(text, region, &number))
+            << text << " " << region;
+        EXPECT_EQ(expected, number) << text << " " << region;
+        num_calls += 2;
+      }
+    }
+    EXPECT_EQ(num_calls / (pass + 1), cache.misses());
+  }
+  EXPECT_EQ(num_calls / 2, cache.hits());
+  EXPECT_EQ(static_cast<size_t>(num_calls / 2), cache.size());
+  // The preferred domestic carrier code is kept too.
+  PhoneNumber number;
+  cache.ParseAndKeepRawInput("08122123456", RegionCode::KR(), &number);
+  EXPECT_EQ("81", number.preferred_domestic_carrier_code());
+
+  cache.Clear();
+  EXPECT_EQ(0U, cache.size());
+  EXPECT_EQ(num_calls / 2 + 1, cache.hits());
+}
+
+TEST_F(ParseCacheTest, ErrorsLeaveNumberUnchanged) {
+  // Each shard holds three entries, so that the errors are cached whichever
+  // shards they hash to.
+  ParseCache cache(phone_util_, 48);
+  PhoneNumber number;
+  number.set_country_code(41);
+  number.set_national_number(446681800);
+  const PhoneNumber expected(number);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER,
+              cache.Parse("not a number", RegionCode::US(), &number));
+    EXPECT_EQ(expected, number);
+    EXPECT_EQ(PhoneNumberUtil::INVALID_COUNTRY_CODE_ERROR,
+              cache.Parse("650 253 0000", RegionCode::ZZ(), &number));
+    EXPECT_EQ(expected, number);
+  }
+  EXPECT_EQ(2, cache.hits());
+  EXPECT_EQ(2, cache.misses());
+}
+
+TEST_F(ParseCacheTest, KeysIncludeRegionAndRawInput) {
+  // Each shard holds three entries, so that none of the entries is evicted
+  // whichever shards they hash to.
+  ParseCache cache(phone_util_, 48);
+  PhoneNumber number;
+  ASSERT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+            cache.Parse("0236618300", RegionCode::IT(), &number));
+  EXPECT_EQ(39, number.country_code());
+  ASSERT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+            cache.Parse("0236618300", RegionCode::AU(), &number));
+  EXPECT_EQ(61, number.country_code());
+  ASSERT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+            cache.ParseAndKeepRawInput("0236618300", RegionCode::IT(),
+                                       &number));
+  EXPECT_EQ("0236618300", number.raw_input());
+  EXPECT_EQ(0, cache.hits());
+  EXPECT_EQ(3U, cache.size());
+}
+
+TEST_F(ParseCacheTest, EvictsLeastRecentlyUsedEntries) {
+  // A single shard holds the only entry of the cache.
+  ParseCache cache(phone_util_, 1);
+  PhoneNumber number;
+  cache.Parse("+1 650-253-0000", RegionCode::US(), &number);
+  cache.Parse("+1 650-253-0000", RegionCode::US(), &number);
+  EXPECT_EQ(1, cache.hits());
+  cache.Parse("+44 7912 345 678", RegionCode::US(), &number);
+  EXPECT_EQ(1U, cache.size());
+  cache.Parse("+1 650-253-0000", RegionCode::US(), &number);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(3, cache.misses());
+  EXPECT_EQ(uint64{6502530000}, number.national_number());
+
+  // Long inputs and caches without capacity don't keep anything.
+  const string long_input = "+1 650-253-0000" + string(200, ' ');
+  cache.Parse(long_input, RegionCode::US(), &number);
+  cache.Parse(long_input, RegionCode::US(), &number);
+  EXPECT_EQ(1, cache.hits());
+  ParseCache empty_cache(phone_util_, 0);
+  empty_cache.Parse("+1 650-253-0000", RegionCode::US(), &number);
+  empty_cache.Parse("+1 650-253-0000", RegionCode::US(), &number);
+  EXPECT_EQ(0, empty_cache.hits());
+  EXPECT_EQ(0U, empty_cache.size());
+  EXPECT_EQ(uint64{6502530000}, number.national_number());
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
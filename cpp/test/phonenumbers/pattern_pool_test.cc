@@ -0,0 +1,76 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/pattern_pool.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+class PatternPoolTest : public testing::Test {
+ protected:
+  PatternPoolTest() : pattern_pool_(regexp_factory_) {}
+
+  const RegExpFactory regexp_factory_;
+  PatternPool pattern_pool_;
+};
+
+TEST_F(PatternPoolTest, InternsEachPatternOnce) {
+  const int fixed_line_id = pattern_pool_.Intern("[2-9]\\d{6}");
+  const int mobile_id = pattern_pool_.Intern("7\\d{9}");
+  EXPECT_NE(fixed_line_id, mobile_id);
+  EXPECT_EQ(fixed_line_id, pattern_pool_.Intern(string("[2-9]\\d{6}")));
+  EXPECT_EQ(mobile_id, pattern_pool_.Intern("7\\d{9}"));
+  EXPECT_EQ(PatternPool::kNoPattern, pattern_pool_.Intern(""));
+  EXPECT_EQ("[2-9]\\d{6}", pattern_pool_.pattern(fixed_line_id));
+  EXPECT_EQ("7\\d{9}", pattern_pool_.pattern(mobile_id));
+
+  EXPECT_EQ(2, pattern_pool_.size());
+  EXPECT_EQ(4, pattern_pool_.num_references());
+  EXPECT_EQ(32, pattern_pool_.referenced_bytes());
+  EXPECT_EQ(16, pattern_pool_.pattern_bytes());
+}
+
+TEST_F(PatternPoolTest, CompilesPatternsOnceOnFirstUse) {
+  const int fixed_line_id = pattern_pool_.Intern("[2-9]\\d{6}");
+  const int mobile_id = pattern_pool_.Intern("7\\d{9}");
+  EXPECT_EQ(0, pattern_pool_.num_compiled());
+
+  const RegExp& regexp = pattern_pool_.GetRegExp(fixed_line_id);
+  EXPECT_EQ(&regexp, &pattern_pool_.GetRegExp(fixed_line_id));
+  EXPECT_EQ(1, pattern_pool_.num_compiled());
+
+  EXPECT_TRUE(pattern_pool_.FullMatch(fixed_line_id, "2345678"));
+  // Only whole numbers match.
+  EXPECT_FALSE(pattern_pool_.FullMatch(fixed_line_id, "23456789"));
+  EXPECT_FALSE(pattern_pool_.FullMatch(fixed_line_id, "1234567"));
+  EXPECT_TRUE(pattern_pool_.FullMatch(mobile_id, "7912345678"));
+  EXPECT_EQ(2, pattern_pool_.num_compiled());
+
+  // The empty pattern matches nothing and isn't compiled.
+  EXPECT_FALSE(pattern_pool_.FullMatch(PatternPool::kNoPattern, ""));
+  EXPECT_FALSE(pattern_pool_.FullMatch(PatternPool::kNoPattern, "2345678"));
+  EXPECT_EQ(2, pattern_pool_.num_compiled());
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,200 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Note that these tests use the test metadata, not the normal metadata file.
+
+#include "phonenumber_generator.h"
+
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/test_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::set;
+using std::string;
+
+namespace {
+
+const int kNumbersPerType = 20;
+
+}  // namespace
+
+TEST(PhoneNumberGeneratorTest, GeneratesValidNumbersOfEachType) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumberGenerator generator(phone_util, 1);
+  set<string> regions;
+  phone_util.GetSupportedRegions(&regions);
+  PhoneNumber number;
+  string region_of_number;
+  for (set<string>::const_iterator region = regions.begin();
+       region != regions.end(); ++region) {
+    set<PhoneNumberUtil::PhoneNumberType> types;
+    phone_util.GetSupportedTypesForRegion(*region, &types);
+    for (set<PhoneNumberUtil::PhoneNumberType>::const_iterator type =
+             types.begin(); type != types.end(); ++type) {
+      if (!generator.Generate(*region, *type, &number)) {
+        // Some types of the test metadata have an example number but no
+        // pattern, and no valid numbers.
+        PhoneNumber example_number;
+        ASSERT_TRUE(phone_util.GetExampleNumberForType(*region, *type,
+                                                       &example_number));
+        EXPECT_NE(*type, phone_util.GetNumberType(example_number))
+            << *region << " " << *type;
+        continue;
+      }
+      set<uint64> national_numbers;
+      for (int i = 0; i < kNumbersPerType; ++i) {
+        ASSERT_TRUE(generator.Generate(*region, *type, &number));
+        EXPECT_TRUE(phone_util.IsValidNumberForRegion(number, *region))
+            << number;
+        EXPECT_FALSE(number.has_extension());
+        national_numbers.insert(number.national_number());
+        // The type is checked against the metadata of the region the number
+        // belongs to, which may be another region sharing the calling code.
+        phone_util.GetRegionCodeForNumber(number, &region_of_number);
+        if (region_of_number == *region) {
+          const PhoneNumberUtil::PhoneNumberType generated_type =
+              phone_util.GetNumberType(number);
+          EXPECT_TRUE(generated_type == *type ||
+                      generated_type == PhoneNumberUtil::FIXED_LINE_OR_MOBILE)
+              << number << " " << generated_type;
+        }
+      }
+      // The numbers vary, unless the type has very few numbers.
+      EXPECT_LT(1U, national_numbers.size()) << *region << " " << *type;
+    }
+  }
+}
+
+TEST(PhoneNumberGeneratorTest, UnsupportedRegionsAndTypes) {
+  PhoneNumberGenerator generator(*PhoneNumberUtil::GetInstance(), 1);
+  PhoneNumber number;
+  EXPECT_FALSE(generator.Generate(RegionCode::ZZ(), PhoneNumberUtil::MOBILE,
+                                  &number));
+  EXPECT_FALSE(generator.Generate(RegionCode::US(), PhoneNumberUtil::UNKNOWN,
+                                  &number));
+  // The test metadata has no voicemail numbers for the US.
+  EXPECT_FALSE(generator.Generate(RegionCode::US(), PhoneNumberUtil::VOICEMAIL,
+                                  &number));
+}
+
+TEST(PhoneNumberGeneratorTest, LeadingZeros) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumberGenerator generator(phone_util, 1);
+  PhoneNumber number;
+  string national_significant_number;
+  for (int i = 0; i < kNumbersPerType; ++i) {
+    // Italian fixed-line numbers start with 0.
+    ASSERT_TRUE(generator.Generate(RegionCode::IT(),
+                                   PhoneNumberUtil::FIXED_LINE, &number));
+    EXPECT_TRUE(number.italian_leading_zero());
+    phone_util.GetNationalSignificantNumber(number,
+                                            &national_significant_number);
+    EXPECT_EQ('0', national_significant_number[0]);
+  }
+}
+
+TEST(PhoneNumberGeneratorTest, SameSeedGeneratesSameNumbers) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumberGenerator generator(phone_util, 42);
+  PhoneNumberGenerator same_seed_generator(phone_util, 42);
+  PhoneNumberGenerator other_seed_generator(phone_util, 43);
+  generator.set_extension_percentage(50);
+  same_seed_generator.set_extension_percentage(50);
+  other_seed_generator.set_extension_percentage(50);
+  PhoneNumber number;
+  PhoneNumber same_seed_number;
+  PhoneNumber other_seed_number;
+  string formatted;
+  string same_seed_formatted;
+  int differences = 0;
+  for (int i = 0; i < kNumbersPerType; ++i) {
+    ASSERT_TRUE(generator.Generate(RegionCode::DE(), PhoneNumberUtil::MOBILE,
+                                   &number));
+    ASSERT_TRUE(same_seed_generator.Generate(
+        RegionCode::DE(), PhoneNumberUtil::MOBILE, &same_seed_number));
+    ASSERT_TRUE(other_seed_generator.Generate(
+        RegionCode::DE(), PhoneNumberUtil::MOBILE, &other_seed_number));
+    EXPECT_EQ(number, same_seed_number);
+    if (!(number == other_seed_number)) {
+      ++differences;
+    }
+    generator.FormatMessy(number, RegionCode::DE(), &formatted);
+    same_seed_generator.FormatMessy(number, RegionCode::DE(),
+                                    &same_seed_formatted);
+    EXPECT_EQ(formatted, same_seed_formatted);
+  }
+  EXPECT_LT(0, differences);
+}
+
+TEST(PhoneNumberGeneratorTest, MessyFormatParsesBack) {
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  PhoneNumberGenerator generator(phone_util, 7);
+  generator.set_extension_percentage(50);
+  // Regions whose test metadata formats and parses numbers consistently, unlike
+  // e.g. GG which lacks the national prefix of the GB formats, or IT whose
+  // test patterns allow national numbers starting with its international
+  // prefix.
+  static const char* const kRegions[] = {
+    RegionCode::AU(), RegionCode::BR(), RegionCode::DE(), RegionCode::GB(),
+    RegionCode::MX(), RegionCode::NZ(), RegionCode::PL(), RegionCode::US(),
+  };
+  PhoneNumber number;
+  PhoneNumber parsed_number;
+  string formatted;
+  set<string> formats;
+  for (size_t region = 0; region < sizeof(kRegions) / sizeof(kRegions[0]);
+       ++region) {
+    set<PhoneNumberUtil::PhoneNumberType> types;
+    phone_util.GetSupportedTypesForRegion(kRegions[region], &types);
+    for (set<PhoneNumberUtil::PhoneNumberType>::const_iterator type =
+             types.begin(); type != types.end(); ++type) {
+      for (int i = 0; i < kNumbersPerType; ++i) {
+        if (!generator.Generate(kRegions[region], *type, &number)) {
+          // See GeneratesValidNumbersOfEachType.
+          break;
+        }
+        generator.FormatMessy(number, kRegions[region], &formatted);
+        formats.insert(formatted);
+        EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+                  phone_util.Parse(formatted, kRegions[region],
+                                   &parsed_number))
+            << formatted;
+        EXPECT_EQ(number, parsed_number)
+            << formatted << " " << kRegions[region];
+      }
+    }
+  }
+  // The numbers are written in many ways, with full-width digits and
+  // extensions among them.
+  bool has_full_width_digits = false;
+  bool has_extension = false;
+  for (set<string>::const_iterator it = formats.begin(); it != formats.end();
+       ++it) {
+    has_full_width_digits |= it->find("\xEF\xBC") != string::npos;
+    has_extension |= it->find("x") != string::npos;
+  }
+  EXPECT_TRUE(has_full_width_digits);
+  EXPECT_TRUE(has_extension);
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -24,6 +24,7 @@
 #include "phonenumbers/base/memory/scoped_ptr.h"
 #include "phonenumbers/base/memory/singleton.h"
 #include "phonenumbers/default_logger.h"
+#include "phonenumbers/execution_budget.h"
 #include "phonenumbers/phonenumber.h"
 #include "phonenumbers/phonenumber.pb.h"
 #include "phonenumbers/phonenumbermatch.h"
@@ -89,7 +90,15 @@ class PhoneNumberMatcherTest : public testing::Test {
   }
 
   bool ExtractMatch(const string& text, PhoneNumberMatch* match) {
-    return matcher_.ExtractMatch(text, offset_, match);
+    PhoneNumberMatcher::MatchSpan span;
+    PhoneNumber number;
+    if (!matcher_.ExtractMatch(text, offset_, &span, &number)) {
+      return false;
+    }
+    match->set_start(span.start);
+    match->set_raw_string(text.substr(span.start - offset_, span.length));
+    match->set_number(number);
+    return true;
   }
 
   PhoneNumberMatcher* GetMatcherWithLeniency(
@@ -1181,6 +1190,48 @@ TEST_F(PhoneNumberMatcherTest, MaxMatchesMixed) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST_F(PhoneNumberMatcherTest, BudgetExhausted) {
+  string numbers;
+  for (int i = 0; i < 100; ++i) {
+    numbers.append("My info: 415-666-7777,");
+  }
+
+  ExecutionBudget unlimited_budget;
+  PhoneNumberMatcher unlimited_matcher(phone_util_, numbers, RegionCode::US(),
+                                       PhoneNumberMatcher::VALID, 10,
+                                       &unlimited_budget);
+  int matches = 0;
+  PhoneNumberMatch match;
+  while (unlimited_matcher.Next(&match)) {
+    ++matches;
+  }
+  EXPECT_EQ(100, matches);
+  EXPECT_FALSE(unlimited_matcher.IsBudgetExhausted());
+
+  // The search stops early, once the steps needed for a few numbers are spent.
+  const int64 steps_per_number = unlimited_budget.steps() / 100;
+  ExecutionBudget budget;
+  budget.set_max_steps(steps_per_number * 5 / 2);
+  PhoneNumberMatcher matcher(phone_util_, numbers, RegionCode::US(),
+                             PhoneNumberMatcher::VALID, 10, &budget);
+  matches = 0;
+  while (matcher.Next(&match)) {
+    EXPECT_EQ("415-666-7777", match.raw_string());
+    ++matches;
+  }
+  EXPECT_EQ(2, matches);
+  EXPECT_TRUE(matcher.IsBudgetExhausted());
+
+  // An expired deadline stops the search before any match.
+  ExecutionBudget expired_budget;
+  expired_budget.set_timeout(ExecutionBudget::Clock::duration::zero());
+  PhoneNumberMatcher expired_matcher(phone_util_, numbers, RegionCode::US(),
+                                     PhoneNumberMatcher::VALID, 10,
+                                     &expired_budget);
+  EXPECT_FALSE(expired_matcher.HasNext());
+  EXPECT_TRUE(expired_matcher.IsBudgetExhausted());
+}
+
 TEST_F(PhoneNumberMatcherTest, NonPlusPrefixedNumbersNotFoundForInvalidRegion) {
   PhoneNumberMatch match;
   scoped_ptr<PhoneNumberMatcher> matcher(
@@ -1226,6 +1277,114 @@ TEST_F(PhoneNumberMatcherTest, SingleIteration_WithNextOnly) {
   EXPECT_FALSE(matcher->Next(&match));
 }
 
+TEST_F(PhoneNumberMatcherTest, AppendRemainingSpans) {
+  const string text("Call +41 44 668 1800 or 650-253-0000, not 12-34-5678 "
+                    "nor +1 650 253 0000x");
+  for (int leniency = PhoneNumberMatcher::POSSIBLE;
+       leniency <= PhoneNumberMatcher::EXACT_GROUPING; ++leniency) {
+    scoped_ptr<PhoneNumberMatcher> matcher(GetMatcherWithLeniency(
+        text, RegionCode::US(),
+        static_cast<PhoneNumberMatcher::Leniency>(leniency)));
+    std::vector<PhoneNumberMatcher::MatchSpan> expected_spans;
+    PhoneNumberMatch match;
+    while (matcher->Next(&match)) {
+      PhoneNumberMatcher::MatchSpan span;
+      span.start = match.start();
+      span.length = match.length();
+      span.country_code = match.number().country_code();
+      expected_spans.push_back(span);
+    }
+
+    // The spans are appended to those already present, including the match
+    // that HasNext() found beforehand.
+    matcher.reset(GetMatcherWithLeniency(
+        text, RegionCode::US(),
+        static_cast<PhoneNumberMatcher::Leniency>(leniency)));
+    std::vector<PhoneNumberMatcher::MatchSpan> spans(1);
+    EXPECT_TRUE(matcher->HasNext());
+    EXPECT_EQ(static_cast<int>(expected_spans.size()),
+              matcher->AppendRemainingSpans(&spans));
+    ASSERT_EQ(expected_spans.size() + 1, spans.size());
+    for (size_t i = 0; i < expected_spans.size(); ++i) {
+      EXPECT_EQ(expected_spans[i].start, spans[i + 1].start);
+      EXPECT_EQ(expected_spans[i].length, spans[i + 1].length);
+      EXPECT_EQ(expected_spans[i].country_code, spans[i + 1].country_code);
+    }
+    EXPECT_FALSE(matcher->HasNext());
+    EXPECT_EQ(0, matcher->AppendRemainingSpans(&spans));
+  }
+}
+
+TEST_F(PhoneNumberMatcherTest, MultipleRegions) {
+  const string text("NZ office: 03-331 6005, US office: 650-253-0000, "
+                    "HQ: +44 2034567890.");
+  std::vector<string> regions;
+  regions.push_back(RegionCode::US());
+  regions.push_back(RegionCode::NZ());
+
+  PhoneNumberMatcher matcher(phone_util_, text, regions,
+                             PhoneNumberMatcher::VALID, 100);
+  PhoneNumberMatch match;
+  string region;
+  ASSERT_TRUE(matcher.Next(&match, &region));
+  EXPECT_EQ("03-331 6005", match.raw_string());
+  EXPECT_EQ(64, match.number().country_code());
+  EXPECT_EQ(RegionCode::NZ(), region);
+  ASSERT_TRUE(matcher.Next(&match, &region));
+  EXPECT_EQ("650-253-0000", match.raw_string());
+  EXPECT_EQ(1, match.number().country_code());
+  EXPECT_EQ(RegionCode::US(), region);
+  // Numbers in international format are parsed under the first region, but
+  // belong to the region of their country calling code.
+  ASSERT_TRUE(matcher.Next(&match, &region));
+  EXPECT_EQ("+44 2034567890", match.raw_string());
+  EXPECT_EQ(44, match.number().country_code());
+  EXPECT_EQ(RegionCode::GB(), region);
+  EXPECT_FALSE(matcher.Next(&match, &region));
+
+  // Spans report the index of the region.
+  PhoneNumberMatcher span_matcher(phone_util_, text, regions,
+                                  PhoneNumberMatcher::VALID, 100);
+  std::vector<PhoneNumberMatcher::MatchSpan> spans;
+  ASSERT_EQ(3, span_matcher.AppendRemainingSpans(&spans));
+  EXPECT_EQ(1, spans[0].region_index);
+  EXPECT_EQ(0, spans[1].region_index);
+  EXPECT_EQ(0, spans[2].region_index);
+
+  // The earlier regions take precedence.
+  regions.clear();
+  regions.push_back(RegionCode::NZ());
+  regions.push_back(RegionCode::US());
+  PhoneNumberMatcher reversed_matcher(phone_util_, "Call 03-331 6005.",
+                                      regions, PhoneNumberMatcher::VALID, 100);
+  ASSERT_TRUE(reversed_matcher.Next(&match, &region));
+  EXPECT_EQ(RegionCode::NZ(), region);
+
+  // A single region behaves like the single-region constructor.
+  regions.resize(1);
+  PhoneNumberMatcher single_region_matcher(phone_util_, text, regions,
+                                           PhoneNumberMatcher::VALID, 100);
+  PhoneNumberMatcher nz_matcher(phone_util_, text, RegionCode::NZ(),
+                                PhoneNumberMatcher::VALID, 100);
+  PhoneNumberMatch nz_match;
+  while (nz_matcher.Next(&nz_match)) {
+    ASSERT_TRUE(single_region_matcher.Next(&match, &region));
+    EXPECT_TRUE(match.Equals(nz_match));
+    string expected_region;
+    phone_util_.GetRegionCodeForNumber(nz_match.number(), &expected_region);
+    EXPECT_EQ(expected_region, region);
+  }
+  EXPECT_FALSE(single_region_matcher.HasNext());
+
+  // Numbers which belong to no region get the region they were parsed with.
+  PhoneNumberMatcher possible_matcher(phone_util_, "Call 650 253 000.",
+                                      regions, PhoneNumberMatcher::POSSIBLE,
+                                      100);
+  ASSERT_TRUE(possible_matcher.Next(&match, &region));
+  EXPECT_FALSE(phone_util_.IsValidNumber(match.number()));
+  EXPECT_EQ(RegionCode::NZ(), region);
+}
+
 TEST_F(PhoneNumberMatcherTest, DoubleIteration) {
   PhoneNumberMatch match;
   scoped_ptr<PhoneNumberMatcher> matcher(
@@ -0,0 +1,156 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/phonenumberredactor.h"
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/stringutil.h"
+#include "phonenumbers/test_util.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+namespace {
+
+string Redact(const string& text, const MaskPolicy& mask_policy) {
+  string redacted;
+  StringRedactionSink sink(&redacted);
+  RedactPhoneNumbers(text, RegionCode::US(), PhoneNumberMatcher::VALID,
+                     mask_policy, &sink);
+  return redacted;
+}
+
+}  // namespace
+
+TEST(PhoneNumberRedactorTest, MaskAllDigits) {
+  EXPECT_EQ("Call ***-***-**** or (***) ***-****, not 12-34.",
+            Redact("Call 650-253-0000 or (650) 253-0000, not 12-34.",
+                   MaskPolicy::MaskAllDigits()));
+  EXPECT_EQ("No number here.",
+            Redact("No number here.", MaskPolicy::MaskAllDigits()));
+  EXPECT_EQ("", Redact("", MaskPolicy::MaskAllDigits()));
+
+  // Every digit is replaced by a single mask character, whatever its encoding.
+  MaskPolicy policy = MaskPolicy::MaskAllDigits();
+  policy.mask_char = 'X';
+  EXPECT_EQ("Tel: XXXXXXXXXX",
+            Redact("Tel: \xEF\xBC\x96" "502530000" /* "６502530000" */,
+                   policy));
+}
+
+TEST(PhoneNumberRedactorTest, KeepLastDigits) {
+  EXPECT_EQ("Call ***-***-0000.",
+            Redact("Call 650-253-0000.", MaskPolicy::KeepLastDigits(4)));
+  EXPECT_EQ("Call 650-253-0000.",
+            Redact("Call 650-253-0000.", MaskPolicy::KeepLastDigits(20)));
+  EXPECT_EQ("Call ***-***-****.",
+            Redact("Call 650-253-0000.", MaskPolicy::KeepLastDigits(0)));
+}
+
+TEST(PhoneNumberRedactorTest, HashE164) {
+  const string redacted = Redact("Call 650-253-0000 or +1 650 253 0000.",
+                                 MaskPolicy::HashE164("salt"));
+  // Both spellings of the number are replaced by the same hash.
+  ASSERT_EQ(string("Call # or #.").size() + 2 * 16, redacted.size());
+  EXPECT_EQ("Call #", redacted.substr(0, 6));
+  const string hash = redacted.substr(5, 17);
+  EXPECT_EQ(string::npos, hash.find_first_not_of("#0123456789abcdef"));
+  EXPECT_EQ(StrCat("Call ", hash, " or ", hash, "."), redacted);
+
+  EXPECT_NE(redacted, Redact("Call 650-253-0000 or +1 650 253 0000.",
+                             MaskPolicy::HashE164("pepper")));
+}
+
+TEST(PhoneNumberRedactorTest, Chunks) {
+  const string text("Call \xEF\xBC\x96" "50-253-0000\n" /* "６50-253-0000" */
+                    "or 650 253 0001 tomorrow.\n"
+                    "Not 650253000 ext\n(650) 253-0002");
+  const string expected = Redact(text, MaskPolicy::KeepLastDigits(2));
+  EXPECT_EQ("Call ***-***-**00\nor *** *** **01 tomorrow.\n"
+            "Not 650253000 ext\n(***) ***-**02", expected);
+
+  // The text is redacted the same way wherever it is split, including inside
+  // numbers and UTF-8 characters.
+  for (size_t split = 0; split <= text.size(); ++split) {
+    string redacted;
+    StringRedactionSink sink(&redacted);
+    PhoneNumberRedactor redactor(*PhoneNumberUtil::GetInstance(),
+                                 RegionCode::US(), PhoneNumberMatcher::VALID,
+                                 MaskPolicy::KeepLastDigits(2), &sink);
+    redactor.Write(absl::string_view(text).substr(0, split));
+    redactor.Write(absl::string_view(text).substr(split));
+    redactor.Finish();
+    EXPECT_EQ(expected, redacted) << split;
+
+    const RedactionStats& stats = redactor.stats();
+    EXPECT_EQ(static_cast<int64>(text.size()), stats.bytes_read);
+    EXPECT_EQ(static_cast<int64>(expected.size()), stats.bytes_written);
+    EXPECT_EQ(3, stats.numbers_redacted);
+    EXPECT_GE(stats.BytesPerSecond(), 0);
+  }
+}
+
+TEST(PhoneNumberRedactorTest, InvalidUtf8LineOnlyAffectsItself) {
+  const string text("Call 650-253-0000\n"
+                    "Bad \xC3 650-253-0001\n"
+                    "or 650-253-0002.");
+  const string expected("Call ***-***-**00\n"
+                        "Bad \xC3 650-253-0001\n"
+                        "or ***-***-**02.");
+  EXPECT_EQ(expected, Redact(text, MaskPolicy::KeepLastDigits(2)));
+
+  // Wherever the chunks are split.
+  for (size_t split = 0; split <= text.size(); ++split) {
+    string redacted;
+    StringRedactionSink sink(&redacted);
+    PhoneNumberRedactor redactor(*PhoneNumberUtil::GetInstance(),
+                                 RegionCode::US(), PhoneNumberMatcher::VALID,
+                                 MaskPolicy::KeepLastDigits(2), &sink);
+    redactor.Write(absl::string_view(text).substr(0, split));
+    redactor.Write(absl::string_view(text).substr(split));
+    redactor.Finish();
+    EXPECT_EQ(expected, redacted) << split;
+    EXPECT_EQ(2, redactor.stats().numbers_redacted);
+  }
+}
+
+TEST(PhoneNumberRedactorTest, LongLines) {
+  // A line of about 200 KiB with no line break.
+  string text;
+  string expected;
+  while (text.size() < 200000) {
+    text.append("Call 650 253 0000 now. ");
+    expected.append("Call *** *** **00 now. ");
+  }
+  string redacted;
+  StringRedactionSink sink(&redacted);
+  PhoneNumberRedactor redactor(*PhoneNumberUtil::GetInstance(),
+                               RegionCode::US(), PhoneNumberMatcher::VALID,
+                               MaskPolicy::KeepLastDigits(2), &sink);
+  for (size_t i = 0; i < text.size(); i += 1000) {
+    redactor.Write(absl::string_view(text).substr(i, 1000));
+    // At most 64 KiB of the line and a chunk wait to be searched.
+    EXPECT_LE(std::min(text.size(), i + 1000) - redacted.size(), 66000U);
+  }
+  redactor.Finish();
+  EXPECT_EQ(expected, redacted);
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
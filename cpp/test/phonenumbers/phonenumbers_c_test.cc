@@ -0,0 +1,261 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Note that these tests use the test metadata, not the normal metadata file.
+
+#include "phonenumbers/phonenumbers_c.h"
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/test_util.h"
+
+extern "C" int pn_test_parse_and_format(const char* number,
+                                        const char* default_region,
+                                        char* formatted, size_t capacity);
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+class PhoneNumbersCTest : public testing::Test {
+ protected:
+  PhoneNumbersCTest() : util_(pn_util_create()) {}
+
+  ~PhoneNumbersCTest() {
+    pn_util_destroy(util_);
+  }
+
+  // Lays out strings like pn_parse_batch() expects them.
+  static void MakeBatch(const vector<string>& strings, string* data,
+                        vector<int32_t>* offsets) {
+    data->clear();
+    offsets->assign(1, 0);
+    for (vector<string>::const_iterator it = strings.begin();
+         it != strings.end(); ++it) {
+      data->append(*it);
+      offsets->push_back(static_cast<int32_t>(data->size()));
+    }
+  }
+
+  pn_util* const util_;
+};
+
+TEST_F(PhoneNumbersCTest, ParseBatch) {
+  vector<string> strings;
+  strings.push_back("+1 650-253-0000");
+  strings.push_back("invalid");
+  strings.push_back("033316005 ext. 1");
+  strings.push_back("+39 02 3661 8300");
+  string data;
+  vector<int32_t> offsets;
+  MakeBatch(strings, &data, &offsets);
+
+  pn_number numbers[4];
+  int32_t errors[4];
+  ASSERT_EQ(PN_OK, pn_parse_batch(util_, data.data(), &offsets[0], 4,
+                                  RegionCode::NZ(), numbers, errors));
+  EXPECT_EQ(PN_NO_PARSING_ERROR, errors[0]);
+  EXPECT_EQ(1, numbers[0].country_code);
+  EXPECT_EQ(uint64_t{6502530000}, numbers[0].national_number);
+  EXPECT_EQ(0, numbers[0].leading_zeros);
+  EXPECT_STREQ("", numbers[0].extension);
+
+  EXPECT_EQ(PN_NOT_A_NUMBER, errors[1]);
+  EXPECT_EQ(0, numbers[1].country_code);
+  EXPECT_EQ(uint64_t{0}, numbers[1].national_number);
+
+  EXPECT_EQ(PN_NO_PARSING_ERROR, errors[2]);
+  EXPECT_EQ(64, numbers[2].country_code);
+  EXPECT_EQ(uint64_t{33316005}, numbers[2].national_number);
+  EXPECT_STREQ("1", numbers[2].extension);
+
+  EXPECT_EQ(PN_NO_PARSING_ERROR, errors[3]);
+  EXPECT_EQ(39, numbers[3].country_code);
+  EXPECT_EQ(uint64_t{236618300}, numbers[3].national_number);
+  EXPECT_EQ(1, numbers[3].leading_zeros);
+
+  // Empty batches need no buffers.
+  EXPECT_EQ(PN_OK, pn_parse_batch(util_, NULL, NULL, 0, RegionCode::NZ(), NULL,
+                                  NULL));
+  EXPECT_EQ(PN_INVALID_ARGUMENT,
+            pn_parse_batch(util_, data.data(), &offsets[0], 4, NULL, numbers,
+                           errors));
+}
+
+TEST_F(PhoneNumbersCTest, FormatBatch) {
+  pn_number numbers[3];
+  memset(numbers, 0, sizeof(numbers));
+  numbers[0].country_code = 1;
+  numbers[0].national_number = 6502530000ULL;
+  numbers[1].country_code = 39;
+  numbers[1].national_number = 236618300ULL;
+  numbers[1].leading_zeros = 1;
+  numbers[2].country_code = 64;
+  numbers[2].national_number = 33316005ULL;
+  strcpy(numbers[2].extension, "1234");
+
+  char data[64];
+  int32_t offsets[4];
+  size_t size;
+  ASSERT_EQ(PN_OK, pn_format_batch(util_, numbers, 3, PN_FORMAT_E164, data,
+                                   sizeof(data), offsets, &size));
+  EXPECT_EQ("+16502530000+390236618300+6433316005", string(data, size));
+  EXPECT_EQ(0, offsets[0]);
+  EXPECT_EQ(12, offsets[1]);
+  EXPECT_EQ(25, offsets[2]);
+  EXPECT_EQ(36, offsets[3]);
+
+  ASSERT_EQ(PN_OK, pn_format_batch(util_, &numbers[2], 1,
+                                   PN_FORMAT_INTERNATIONAL, data, sizeof(data),
+                                   offsets, &size));
+  EXPECT_EQ("+64 3-331 6005 ext. 1234", string(data, size));
+
+  // The size needed is returned when the buffer is too small.
+  EXPECT_EQ(PN_BUFFER_TOO_SMALL,
+            pn_format_batch(util_, numbers, 3, PN_FORMAT_E164, data, 20,
+                            offsets, &size));
+  EXPECT_EQ(36U, size);
+  EXPECT_EQ(PN_BUFFER_TOO_SMALL,
+            pn_format_batch(util_, numbers, 3, PN_FORMAT_E164, NULL, 0,
+                            offsets, &size));
+  EXPECT_EQ(36U, size);
+
+  EXPECT_EQ(PN_INVALID_ARGUMENT,
+            pn_format_batch(util_, numbers, 3, static_cast<pn_format>(4), data,
+                            sizeof(data), offsets, &size));
+}
+
+TEST_F(PhoneNumbersCTest, ValidateBatch) {
+  vector<string> strings;
+  strings.push_back("+1 650-253-0000");
+  strings.push_back("+1 253 0000");
+  strings.push_back("+44 7912 345 678");
+  string data;
+  vector<int32_t> offsets;
+  MakeBatch(strings, &data, &offsets);
+  pn_number numbers[3];
+  int32_t errors[3];
+  ASSERT_EQ(PN_OK, pn_parse_batch(util_, data.data(), &offsets[0], 3,
+                                  RegionCode::ZZ(), numbers, errors));
+
+  uint8_t valid[3];
+  int8_t types[3];
+  ASSERT_EQ(PN_OK, pn_validate_batch(util_, numbers, 3, valid, types));
+  EXPECT_EQ(1, valid[0]);
+  EXPECT_EQ(PN_TYPE_FIXED_LINE_OR_MOBILE, types[0]);
+  EXPECT_EQ(0, valid[1]);
+  EXPECT_EQ(PN_TYPE_UNKNOWN, types[1]);
+  EXPECT_EQ(1, valid[2]);
+  EXPECT_EQ(PN_TYPE_MOBILE, types[2]);
+
+  // The types are optional.
+  memset(valid, 2, sizeof(valid));
+  ASSERT_EQ(PN_OK, pn_validate_batch(util_, numbers, 3, valid, NULL));
+  EXPECT_EQ(1, valid[0]);
+  EXPECT_EQ(0, valid[1]);
+  EXPECT_EQ(1, valid[2]);
+}
+
+#ifdef I18N_PHONENUMBERS_USE_ICU_REGEXP
+TEST_F(PhoneNumbersCTest, MatchText) {
+  const string text = "Call 650 253 0000 or +44 7912 345 678 today.";
+  pn_match matches[2];
+  size_t num_matches;
+  ASSERT_EQ(PN_OK, pn_match_text(util_, text.data(), text.size(),
+                                 RegionCode::US(), PN_LENIENCY_VALID, matches,
+                                 2, &num_matches));
+  ASSERT_EQ(2U, num_matches);
+  EXPECT_EQ(5, matches[0].start);
+  EXPECT_EQ(12, matches[0].length);
+  EXPECT_EQ(1, matches[0].number.country_code);
+  EXPECT_EQ(uint64_t{6502530000}, matches[0].number.national_number);
+  EXPECT_EQ("+44 7912 345 678",
+            text.substr(matches[1].start, matches[1].length));
+  EXPECT_EQ(44, matches[1].number.country_code);
+
+  // The number of matches is returned when the buffer is too small.
+  ASSERT_EQ(PN_BUFFER_TOO_SMALL,
+            pn_match_text(util_, text.data(), text.size(), RegionCode::US(),
+                          PN_LENIENCY_VALID, matches, 1, &num_matches));
+  EXPECT_EQ(2U, num_matches);
+  EXPECT_EQ(5, matches[0].start);
+
+  ASSERT_EQ(PN_OK, pn_match_text(util_, NULL, 0, RegionCode::US(),
+                                 PN_LENIENCY_VALID, NULL, 0, &num_matches));
+  EXPECT_EQ(0U, num_matches);
+}
+#endif  // I18N_PHONENUMBERS_USE_ICU_REGEXP
+
+TEST_F(PhoneNumbersCTest, BatchesOnSeveralThreads) {
+  vector<string> strings;
+  for (int i = 0; i < 5000; ++i) {
+    strings.push_back(i % 3 == 0 ? "invalid" : "+1 650 253 " +
+                      std::to_string(1000 + i));
+  }
+  string data;
+  vector<int32_t> offsets;
+  MakeBatch(strings, &data, &offsets);
+  vector<pn_number> numbers(strings.size());
+  vector<int32_t> errors(strings.size());
+  vector<uint8_t> valid(strings.size());
+  vector<char> formatted(strings.size() * 16);
+  vector<int32_t> formatted_offsets(strings.size() + 1);
+  size_t size;
+  ASSERT_EQ(PN_OK, pn_util_set_num_threads(util_, 4));
+  ASSERT_EQ(PN_OK, pn_parse_batch(util_, data.data(), &offsets[0],
+                                  strings.size(), RegionCode::US(),
+                                  &numbers[0], &errors[0]));
+  ASSERT_EQ(PN_OK, pn_validate_batch(util_, &numbers[0], numbers.size(),
+                                     &valid[0], NULL));
+  ASSERT_EQ(PN_OK, pn_format_batch(util_, &numbers[0], numbers.size(),
+                                   PN_FORMAT_E164, &formatted[0],
+                                   formatted.size(), &formatted_offsets[0],
+                                   &size));
+  // The results are in the order of the numbers.
+  for (size_t i = 0; i < strings.size(); ++i) {
+    if (i % 3 == 0) {
+      EXPECT_EQ(PN_NOT_A_NUMBER, errors[i]);
+      continue;
+    }
+    EXPECT_EQ(PN_NO_PARSING_ERROR, errors[i]);
+    EXPECT_EQ(6502530000ULL + 1000 + i, numbers[i].national_number);
+    EXPECT_EQ(1, valid[i]);
+    EXPECT_EQ("+1" + std::to_string(6502530000ULL + 1000 + i),
+              string(&formatted[formatted_offsets[i]],
+                     formatted_offsets[i + 1] - formatted_offsets[i]));
+  }
+  EXPECT_EQ(PN_OK, pn_util_set_num_threads(util_, 1));
+  EXPECT_EQ(PN_INVALID_ARGUMENT, pn_util_set_num_threads(util_, -1));
+}
+
+TEST_F(PhoneNumbersCTest, UsableFromC) {
+  char formatted[32];
+  EXPECT_EQ(PN_NO_PARSING_ERROR,
+            pn_test_parse_and_format("033316005", RegionCode::NZ(), formatted,
+                                     sizeof(formatted)));
+  EXPECT_STREQ("+6433316005", formatted);
+  EXPECT_EQ(PN_NOT_A_NUMBER,
+            pn_test_parse_and_format("invalid", RegionCode::NZ(), formatted,
+                                     sizeof(formatted)));
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2026 The Libphonenumber Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compiled as C, to check that phonenumbers_c.h is valid C and usable from it.
+ */
+
+#include <string.h>
+
+#include "phonenumbers/phonenumbers_c.h"
+
+/* Parses number with default_region, and formats it in E164 format into
+ * formatted, which has room for capacity bytes. Returns the pn_parse_error of
+ * parsing it, or the failed pn_status. */
+int pn_test_parse_and_format(const char* number, const char* default_region,
+                             char* formatted, size_t capacity) {
+  pn_util* const util = pn_util_create();
+  const int32_t offsets[2] = {0, (int32_t) strlen(number)};
+  pn_number parsed;
+  int32_t error;
+  int32_t formatted_offsets[2];
+  size_t size;
+  pn_status status = pn_parse_batch(util, number, offsets, 1, default_region,
+                                    &parsed, &error);
+  if (status == PN_OK && error == PN_NO_PARSING_ERROR) {
+    status = pn_format_batch(util, &parsed, 1, PN_FORMAT_E164, formatted,
+                             capacity - 1, formatted_offsets, &size);
+    if (status == PN_OK) {
+      formatted[size] = '\0';
+    }
+  }
+  pn_util_destroy(util);
+  return status == PN_OK ? error : status;
+}
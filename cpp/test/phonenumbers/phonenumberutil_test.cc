@@ -31,11 +31,16 @@
 #include <gtest/gtest.h>
 #include <unicode/uchar.h>
 
+#include "phonenumbers/base/memory/scoped_ptr.h"
 #include "phonenumbers/default_logger.h"
+#include "phonenumbers/execution_budget.h"
 #include "phonenumbers/normalize_utf8.h"
+#include "phonenumbers/pattern_pool.h"
 #include "phonenumbers/phonemetadata.pb.h"
 #include "phonenumbers/phonenumber.h"
 #include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
 #include "phonenumbers/test_util.h"
 
 namespace i18n {
@@ -69,17 +74,37 @@ class PhoneNumberUtilTest : public testing::Test {
     return phone_util_.GetMetadataForNonGeographicalRegion(country_code);
   }
 
+  const PatternPool& GetPatternPool() const {
+    return *phone_util_.pattern_pool_;
+  }
+
   void ExtractPossibleNumber(const string& number,
                              string* extracted_number) const {
     phone_util_.ExtractPossibleNumber(number, extracted_number);
   }
 
+  static bool MaybeStripSecondNumber(string* number) {
+    return PhoneNumberUtil::MaybeStripSecondNumber(number);
+  }
+
+  static const char* CaptureUpToSecondNumberStart() {
+    return PhoneNumberUtil::kCaptureUpToSecondNumberStart;
+  }
+
+  static bool ContainsAlphaPhoneLetters(const string& number) {
+    return PhoneNumberUtil::ContainsAlphaPhoneLetters(number);
+  }
+
+  static bool FullyMatchesAlphaPhoneLetters(const string& number) {
+    return PhoneNumberUtil::FullyMatchesAlphaPhoneLetters(number);
+  }
+
   bool IsViablePhoneNumber(const string& number) const {
     return phone_util_.IsViablePhoneNumber(number);
   }
 
   void Normalize(string* number) const {
-    phone_util_.Normalize(number);
+    phone_util_.Normalize(false, number);
   }
 
   PhoneNumber::CountryCodeSource MaybeStripInternationalPrefixAndNormalize(
@@ -87,6 +112,7 @@ class PhoneNumberUtilTest : public testing::Test {
       string* number) const {
     return phone_util_.MaybeStripInternationalPrefixAndNormalize(
         possible_idd_prefix,
+        false,
         number);
   }
 
@@ -108,6 +134,7 @@ class PhoneNumberUtilTest : public testing::Test {
       PhoneNumber* phone_number) const {
     return phone_util_.MaybeExtractCountryCode(default_region_metadata,
                                                keep_raw_input,
+                                               false,
                                                national_number,
                                                phone_number);
   }
@@ -352,6 +379,26 @@ TEST_F(PhoneNumberUtilTest, GetInstanceLoadInternationalTollFreeMetadata) {
   EXPECT_EQ("12345678", metadata->toll_free().example_number());
 }
 
+TEST_F(PhoneNumberUtilTest, NationalNumberPatternsAreShared) {
+  const PatternPool& pattern_pool = GetPatternPool();
+  // The twelve number descriptions of each entity reference a pattern, unless
+  // there is no number of their type, and the descriptions of fixed-line
+  // numbers are also used for FIXED_LINE_OR_MOBILE.
+  EXPECT_LT(pattern_pool.size(), pattern_pool.num_references());
+  EXPECT_LT(pattern_pool.pattern_bytes(), pattern_pool.referenced_bytes());
+
+  PhoneNumber number;
+  number.set_country_code(1);
+  number.set_national_number(uint64{6502530000});
+  EXPECT_TRUE(phone_util_.IsValidNumber(number));
+  const int num_compiled = pattern_pool.num_compiled();
+  EXPECT_LT(0, num_compiled);
+  EXPECT_GE(pattern_pool.size(), num_compiled);
+  // The patterns are compiled once.
+  EXPECT_TRUE(phone_util_.IsValidNumber(number));
+  EXPECT_EQ(num_compiled, pattern_pool.num_compiled());
+}
+
 TEST_F(PhoneNumberUtilTest, GetNationalSignificantNumber) {
   PhoneNumber number;
   number.set_country_code(1);
@@ -1584,6 +1631,73 @@ TEST_F(PhoneNumberUtilTest, GetLengthOfNationalDestinationCode) {
   EXPECT_EQ(3, phone_util_.GetLengthOfNationalDestinationCode(cn_mobile));
 }
 
+TEST_F(PhoneNumberUtilTest, Decompose) {
+  PhoneNumber number;
+  PhoneNumberUtil::NumberDecomposition decomposition;
+
+  // US number.
+  number.set_country_code(1);
+  number.set_national_number(uint64{6502530000});
+  phone_util_.Decompose(number, &decomposition);
+  EXPECT_EQ(1, decomposition.country_calling_code);
+  EXPECT_EQ("6502530000", decomposition.national_significant_number);
+  EXPECT_EQ(PhoneNumberUtil::FIXED_LINE_OR_MOBILE, decomposition.number_type);
+  EXPECT_EQ(0, decomposition.national_destination_code.start);
+  EXPECT_EQ(3, decomposition.national_destination_code.length);
+  ASSERT_EQ(2U, decomposition.subscriber_number_groups.size());
+  EXPECT_EQ(3, decomposition.subscriber_number_groups[0].start);
+  EXPECT_EQ(3, decomposition.subscriber_number_groups[0].length);
+  EXPECT_EQ(6, decomposition.subscriber_number_groups[1].start);
+  EXPECT_EQ(4, decomposition.subscriber_number_groups[1].length);
+
+  // Argentinian mobile number: the NDC includes the mobile token.
+  number.set_country_code(54);
+  number.set_national_number(uint64{91187654321});
+  phone_util_.Decompose(number, &decomposition);
+  EXPECT_EQ(54, decomposition.country_calling_code);
+  EXPECT_EQ(PhoneNumberUtil::MOBILE, decomposition.number_type);
+  EXPECT_EQ(0, decomposition.national_destination_code.start);
+  EXPECT_EQ(3, decomposition.national_destination_code.length);
+  ASSERT_EQ(2U, decomposition.subscriber_number_groups.size());
+  EXPECT_EQ(3, decomposition.subscriber_number_groups[0].start);
+  EXPECT_EQ(4, decomposition.subscriber_number_groups[0].length);
+  EXPECT_EQ(7, decomposition.subscriber_number_groups[1].start);
+  EXPECT_EQ(4, decomposition.subscriber_number_groups[1].length);
+
+  // Italian leading zeros are part of the national significant number.
+  number.Clear();
+  number.set_country_code(39);
+  number.set_national_number(uint64{236618300});
+  number.set_italian_leading_zero(true);
+  phone_util_.Decompose(number, &decomposition);
+  EXPECT_EQ("0236618300", decomposition.national_significant_number);
+  EXPECT_EQ(0, decomposition.national_destination_code.start);
+  EXPECT_EQ(2, decomposition.national_destination_code.length);
+
+  // A number with an extension: the extension is not a group.
+  number.Clear();
+  number.set_country_code(376);
+  number.set_national_number(uint64{12345});
+  number.set_extension("321");
+  phone_util_.Decompose(number, &decomposition);
+  EXPECT_EQ(0, decomposition.national_destination_code.length);
+  ASSERT_EQ(1U, decomposition.subscriber_number_groups.size());
+  EXPECT_EQ(0, decomposition.subscriber_number_groups[0].start);
+  EXPECT_EQ(5, decomposition.subscriber_number_groups[0].length);
+
+  // Invalid country calling code: the number is kept whole.
+  number.Clear();
+  number.set_country_code(123);
+  number.set_national_number(uint64{650253000});
+  phone_util_.Decompose(number, &decomposition);
+  EXPECT_EQ(123, decomposition.country_calling_code);
+  EXPECT_EQ(PhoneNumberUtil::UNKNOWN, decomposition.number_type);
+  EXPECT_EQ(0, decomposition.national_destination_code.length);
+  ASSERT_EQ(1U, decomposition.subscriber_number_groups.size());
+  EXPECT_EQ(0, decomposition.subscriber_number_groups[0].start);
+  EXPECT_EQ(9, decomposition.subscriber_number_groups[0].length);
+}
+
 TEST_F(PhoneNumberUtilTest, GetCountryMobileToken) {
   int country_calling_code;
   string mobile_token;
@@ -1636,6 +1750,93 @@ TEST_F(PhoneNumberUtilTest, ExtractPossibleNumber) {
   ExtractPossibleNumber("(650) 253-0000\xE2\x80\x8F"
                         /* "(650) 253-0000‏" */, &extracted_number);
   EXPECT_EQ("650) 253-0000", extracted_number);
+
+  // Removes a second number, in linear time.
+  ExtractPossibleNumber("(530) 583-6985 x302/x2303", &extracted_number);
+  EXPECT_EQ("530) 583-6985 x302", extracted_number);
+  string long_number;
+  for (int i = 0; i < 100000; ++i) {
+    long_number.append("1-");
+  }
+  ExtractPossibleNumber(long_number, &extracted_number);
+  EXPECT_EQ(long_number.substr(0, long_number.length() - 1), extracted_number);
+}
+
+TEST_F(PhoneNumberUtilTest, MaybeStripSecondNumber) {
+  string number("(530) 583-6985 x302 / x2303");
+  EXPECT_TRUE(MaybeStripSecondNumber(&number));
+  EXPECT_EQ("(530) 583-6985 x302 ", number);
+  number = "a\\x/x/ y";
+  EXPECT_TRUE(MaybeStripSecondNumber(&number));
+  EXPECT_EQ("a\\x", number);
+  number = "1/2\n3/x4/x";
+  EXPECT_TRUE(MaybeStripSecondNumber(&number));
+  EXPECT_EQ("3/x4", number);
+  number = "650 253 0000/ y";
+  EXPECT_FALSE(MaybeStripSecondNumber(&number));
+  EXPECT_EQ("650 253 0000/ y", number);
+
+  // Agrees with the regular expression it replaces, including on the line
+  // terminators that "." doesn't match.
+  static const char* const kAlphabet[] = {
+    "1", " ", "/", "\\", "x", "X", "\n", "\r", "\xC2\x85" /* U+0085 */,
+    "\xE2\x80\xA8" /* U+2028 */, "\xE2\x80\x8B" /* U+200B */,
+  };
+  const int alphabet_size = sizeof(kAlphabet) / sizeof(kAlphabet[0]);
+  const RegExpFactory regexp_factory;
+  const scoped_ptr<const RegExp> regexp(
+      regexp_factory.CreateRegExp(CaptureUpToSecondNumberStart()));
+  unsigned int random = 1;
+  for (int iteration = 0; iteration < 20000; ++iteration) {
+    random = random * 1103515245 + 12345;
+    const int length = (random >> 16) % 12;
+    string input;
+    for (int i = 0; i < length; ++i) {
+      random = random * 1103515245 + 12345;
+      input.append(kAlphabet[(random >> 16) % alphabet_size]);
+    }
+    string expected(input);
+    const bool expected_match = regexp->PartialMatch(input, &expected);
+    string actual(input);
+    ASSERT_EQ(expected_match, MaybeStripSecondNumber(&actual)) << input;
+    EXPECT_EQ(expected, actual) << input;
+  }
+}
+
+TEST_F(PhoneNumberUtilTest, ContainsAlphaPhoneLetters) {
+  EXPECT_TRUE(ContainsAlphaPhoneLetters("1-800-MICROSOFT"));
+  EXPECT_TRUE(ContainsAlphaPhoneLetters("a1b2c"));
+  EXPECT_FALSE(ContainsAlphaPhoneLetters("1-800-MI"));
+  EXPECT_FALSE(ContainsAlphaPhoneLetters("ab\nc"));
+  EXPECT_TRUE(FullyMatchesAlphaPhoneLetters("1-800-MICROSOFT"));
+  EXPECT_FALSE(FullyMatchesAlphaPhoneLetters("1-800-MICROSOFT 1"));
+  EXPECT_FALSE(FullyMatchesAlphaPhoneLetters("a1b2c\n"));
+
+  // Agrees with the regular expression it replaces, including on the
+  // characters matching [a-z] case-insensitively and the line terminators.
+  static const char* const kAlphabet[] = {
+    "1", "a", "Z", "-", "\n", "\r", "\xC5\xBF" /* U+017F */,
+    "\xE2\x84\xAA" /* U+212A */, "\xC2\x85" /* U+0085 */,
+    "\xE2\x80\xA8" /* U+2028 */, "\xC3\xA9" /* U+00E9 */,
+  };
+  const int alphabet_size = sizeof(kAlphabet) / sizeof(kAlphabet[0]);
+  const RegExpFactory regexp_factory;
+  const scoped_ptr<const RegExp> regexp(
+      regexp_factory.CreateRegExp("(?i)(?:.*?[a-z]){3}"));
+  unsigned int random = 1;
+  for (int iteration = 0; iteration < 20000; ++iteration) {
+    random = random * 1103515245 + 12345;
+    const int length = (random >> 16) % 10;
+    string input;
+    for (int i = 0; i < length; ++i) {
+      random = random * 1103515245 + 12345;
+      input.append(kAlphabet[(random >> 16) % alphabet_size]);
+    }
+    EXPECT_EQ(regexp->PartialMatch(input), ContainsAlphaPhoneLetters(input))
+        << input;
+    EXPECT_EQ(regexp->FullMatch(input), FullyMatchesAlphaPhoneLetters(input))
+        << input;
+  }
 }
 
 TEST_F(PhoneNumberUtilTest, IsNANPACountry) {
@@ -2692,6 +2893,32 @@ TEST_F(PhoneNumberUtilTest, FormatInOriginalFormat) {
   EXPECT_EQ("650253000", formatted_number);
 }
 
+TEST_F(PhoneNumberUtilTest, FormatInOriginalFormatWithExtension) {
+  // The digits of the raw input after the national prefix, extension included,
+  // don't form a valid number, so that these numbers aren't considered to have
+  // a national prefix and are kept as entered.
+  static const struct {
+    const char* raw_input;
+    const char* region_code;
+  } kNumbers[] = {
+    { "02087654321 x123", "GB" },
+    { "020 8765 4321 ext. 123", "GB" },
+    { "07912 345678 ext 1", "GB" },
+    { "0343 515 1234 ext 5", "AR" },
+  };
+  for (const auto& test_case : kNumbers) {
+    PhoneNumber phone_number;
+    EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+              phone_util_.ParseAndKeepRawInput(test_case.raw_input,
+                                               test_case.region_code,
+                                               &phone_number));
+    string formatted_number;
+    phone_util_.FormatInOriginalFormat(phone_number, test_case.region_code,
+                                       &formatted_number);
+    EXPECT_EQ(test_case.raw_input, formatted_number);
+  }
+}
+
 TEST_F(PhoneNumberUtilTest, IsPremiumRate) {
   PhoneNumber number;
   number.set_country_code(1);
@@ -2958,6 +3185,10 @@ TEST_F(PhoneNumberUtilTest, NormaliseOtherDigits) {
   static const string kExpectedOutput2("520");
   EXPECT_EQ(kExpectedOutput2, eastern_arabic_input_number)
       << "Conversion did not correctly replace non-latin digits";
+  // Numbers already known to be valid UTF-8 are normalized the same way.
+  EXPECT_EQ(kExpectedOutput, NormalizeUTF8::NormalizeDecimalDigits(
+                                 "\xEF\xBC\x92" "5\xD9\xA5", true));
+  EXPECT_EQ("650", NormalizeUTF8::NormalizeDecimalDigits("650", true));
 }
 
 TEST_F(PhoneNumberUtilTest, NormaliseStripAlphaCharacters) {
@@ -4114,6 +4345,11 @@ TEST_F(PhoneNumberUtilTest, FailedParseOnInvalidNumbers) {
             phone_util_.Parse(";phone-context=",
                               RegionCode::ZZ(), &test_number));
   EXPECT_EQ(PhoneNumber::default_instance(), test_number);
+
+  // A tel URI with nothing but the plus sign.
+  EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER,
+            phone_util_.Parse("tel:+", RegionCode::US(), &test_number));
+  EXPECT_EQ(PhoneNumber::default_instance(), test_number);
 }
 
 TEST_F(PhoneNumberUtilTest, ParseNumbersWithPlusWithNoRegion) {
@@ -4681,6 +4917,134 @@ TEST_F(PhoneNumberUtilTest, ParseAndKeepRaw) {
   EXPECT_EQ(korean_number, test_number);
 }
 
+TEST_F(PhoneNumberUtilTest, ParseIntoArena) {
+  google::protobuf::Arena arena;
+  PhoneNumber* const test_number =
+      google::protobuf::Arena::CreateMessage<PhoneNumber>(&arena);
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+            phone_util_.ParseAndKeepRawInput("1800 six-flag ext. 1234",
+                                             RegionCode::US(), test_number));
+  EXPECT_EQ(&arena, test_number->GetArena());
+
+  PhoneNumber expected_number;
+  expected_number.set_country_code(1);
+  expected_number.set_national_number(uint64{8007493524});
+  expected_number.set_extension("1234");
+  expected_number.set_raw_input("1800 six-flag ext. 1234");
+  expected_number.set_country_code_source(
+      PhoneNumber::FROM_NUMBER_WITHOUT_PLUS_SIGN);
+  EXPECT_EQ(expected_number, *test_number);
+}
+
+TEST_F(PhoneNumberUtilTest, ParseIntoArenaRepeatedly) {
+  google::protobuf::Arena arena;
+  PhoneNumber* const test_number =
+      google::protobuf::Arena::CreateMessage<PhoneNumber>(&arena);
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+            phone_util_.ParseAndKeepRawInput("1800 six-flag ext. 1234",
+                                             RegionCode::US(), test_number));
+  const uint64 space_allocated = arena.SpaceAllocated();
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+              phone_util_.ParseAndKeepRawInput("1800 six-flag ext. 1234",
+                                               RegionCode::US(), test_number));
+    EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER,
+              phone_util_.ParseAndKeepRawInput("invalid", RegionCode::US(),
+                                               test_number));
+    ExecutionBudget budget;
+    EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+              phone_util_.ParseWithBudget("1800 six-flag ext. 1234",
+                                          RegionCode::US(), &budget,
+                                          test_number));
+  }
+  EXPECT_EQ(space_allocated, arena.SpaceAllocated());
+  EXPECT_EQ("1234", test_number->extension());
+}
+
+TEST_F(PhoneNumberUtilTest, ParseBatch) {
+  std::vector<string> numbers_to_parse;
+  numbers_to_parse.push_back("+1 650-253-0000");
+  numbers_to_parse.push_back("invalid");
+  numbers_to_parse.push_back("033316005 ext. 1");
+
+  google::protobuf::Arena arena;
+  std::vector<PhoneNumber*> numbers;
+  std::vector<PhoneNumberUtil::ErrorType> errors;
+  phone_util_.ParseBatch(numbers_to_parse, RegionCode::NZ(), false, &arena,
+                         &numbers, &errors);
+  ASSERT_EQ(3U, numbers.size());
+  ASSERT_EQ(3U, errors.size());
+  for (std::vector<PhoneNumber*>::const_iterator it = numbers.begin();
+       it != numbers.end(); ++it) {
+    EXPECT_EQ(&arena, (*it)->GetArena());
+  }
+
+  PhoneNumber us_number;
+  us_number.set_country_code(1);
+  us_number.set_national_number(uint64{6502530000});
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR, errors[0]);
+  EXPECT_EQ(us_number, *numbers[0]);
+
+  EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER, errors[1]);
+  EXPECT_EQ(PhoneNumber::default_instance(), *numbers[1]);
+
+  PhoneNumber nz_number;
+  nz_number.set_country_code(64);
+  nz_number.set_national_number(33316005ULL);
+  nz_number.set_extension("1");
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR, errors[2]);
+  EXPECT_EQ(nz_number, *numbers[2]);
+
+  // The raw input is kept on request, and the output vectors are reset.
+  numbers_to_parse.resize(1);
+  phone_util_.ParseBatch(numbers_to_parse, RegionCode::NZ(), true, &arena,
+                         &numbers, &errors);
+  ASSERT_EQ(1U, numbers.size());
+  ASSERT_EQ(1U, errors.size());
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR, errors[0]);
+  EXPECT_EQ("+1 650-253-0000", numbers[0]->raw_input());
+  EXPECT_EQ(PhoneNumber::FROM_NUMBER_WITH_PLUS_SIGN,
+            numbers[0]->country_code_source());
+}
+
+TEST_F(PhoneNumberUtilTest, ParseWithBudget) {
+  PhoneNumber us_number;
+  us_number.set_country_code(1);
+  us_number.set_national_number(uint64{6502530000});
+
+  ExecutionBudget unlimited_budget;
+  PhoneNumber test_number;
+  EXPECT_EQ(PhoneNumberUtil::NO_PARSING_ERROR,
+            phone_util_.ParseWithBudget("+1 650-253-0000", RegionCode::NZ(),
+                                        &unlimited_budget, &test_number));
+  EXPECT_EQ(us_number, test_number);
+  EXPECT_FALSE(unlimited_budget.IsExhausted());
+  EXPECT_EQ(PhoneNumberUtil::NOT_A_NUMBER,
+            phone_util_.ParseWithBudget("invalid", RegionCode::NZ(),
+                                        &unlimited_budget, &test_number));
+  EXPECT_EQ(us_number, test_number);
+
+  // The number is left unchanged when the budget runs out, whatever the
+  // remaining steps would have decided.
+  ExecutionBudget budget;
+  budget.set_max_steps(3);
+  test_number.Clear();
+  EXPECT_EQ(PhoneNumberUtil::DEADLINE_EXCEEDED,
+            phone_util_.ParseWithBudget("+1 650-253-0000", RegionCode::NZ(),
+                                        &budget, &test_number));
+  EXPECT_EQ(PhoneNumber::default_instance(), test_number);
+  EXPECT_TRUE(budget.IsExhausted());
+  EXPECT_EQ(PhoneNumberUtil::DEADLINE_EXCEEDED,
+            phone_util_.ParseWithBudget("invalid", RegionCode::NZ(), &budget,
+                                        &test_number));
+
+  ExecutionBudget expired_budget;
+  expired_budget.set_deadline(ExecutionBudget::Clock::now());
+  EXPECT_EQ(PhoneNumberUtil::DEADLINE_EXCEEDED,
+            phone_util_.ParseWithBudget("+1 650-253-0000", RegionCode::NZ(),
+                                        &expired_budget, &test_number));
+}
+
 TEST_F(PhoneNumberUtilTest, ParseItalianLeadingZeros) {
   PhoneNumber zeros_number;
   zeros_number.set_country_code(61);
@@ -0,0 +1,207 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "record_batches.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+namespace {
+
+// Reads all the batches of contents.
+vector<string> ReadAllBatches(const string& contents, size_t block_size,
+                              int batch_size, int64* records) {
+  FILE* const file = tmpfile();
+  EXPECT_TRUE(file != NULL);
+  fwrite(contents.data(), 1, contents.size(), file);
+  rewind(file);
+  BatchReader reader(file, block_size, batch_size);
+  vector<string> batches;
+  string batch;
+  while (reader.Next(&batch)) {
+    batches.push_back(batch);
+  }
+  EXPECT_FALSE(reader.error());
+  EXPECT_EQ(static_cast<int64>(contents.size()), reader.bytes_read());
+  *records = reader.records();
+  fclose(file);
+  return batches;
+}
+
+}  // namespace
+
+TEST(RecordBatchesTest, SplitFields) {
+  vector<string> fields;
+  SplitFields("+41 44 668 1800,CH,,x", ',', &fields);
+  ASSERT_EQ(4U, fields.size());
+  EXPECT_EQ("+41 44 668 1800", fields[0]);
+  EXPECT_EQ("CH", fields[1]);
+  EXPECT_EQ("", fields[2]);
+  EXPECT_EQ("x", fields[3]);
+
+  // Quoted fields may contain the delimiter, newlines and double quotes.
+  SplitFields("\"Smith, \"\"Jo\"\"\",\"044 668\n1800\"\tCH", ',', &fields);
+  ASSERT_EQ(2U, fields.size());
+  EXPECT_EQ("Smith, \"Jo\"", fields[0]);
+  EXPECT_EQ("044 668\n1800\tCH", fields[1]);
+
+  SplitFields("", '\t', &fields);
+  ASSERT_EQ(1U, fields.size());
+  EXPECT_EQ("", fields[0]);
+}
+
+TEST(RecordBatchesTest, AppendFieldQuotesWhenNeeded) {
+  string output;
+  AppendField("+41446681800", ',', &output);
+  EXPECT_EQ(",+41446681800", output);
+  output.clear();
+  AppendField("Zurich, CH", ',', &output);
+  EXPECT_EQ(",\"Zurich, CH\"", output);
+  output.clear();
+  AppendField("Zurich, CH", '\t', &output);
+  EXPECT_EQ("\tZurich, CH", output);
+
+  // The quoted fields are split back into the same values.
+  static const char* const kValues[] = {
+    "say \"hi\"", "two\nlines", "a,b", "",
+  };
+  output = "record";
+  for (const char* value : kValues) {
+    AppendField(value, ',', &output);
+  }
+  vector<string> fields;
+  ASSERT_EQ(output.size(), FindEndOfRecord(output + "\n"));
+  SplitFields(output, ',', &fields);
+  ASSERT_EQ(5U, fields.size());
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(kValues[i], fields[i + 1]);
+  }
+}
+
+TEST(RecordBatchesTest, FindEndOfRecord) {
+  EXPECT_EQ(3U, FindEndOfRecord("abc\ndef\n"));
+  EXPECT_EQ(0U, FindEndOfRecord("\n"));
+  EXPECT_EQ(string::npos, FindEndOfRecord("abc"));
+  // Newlines between double quotes don't end the record.
+  EXPECT_EQ(9U, FindEndOfRecord("a,\"b\nc\",d\ne\n"));
+  EXPECT_EQ(9U, FindEndOfRecord("\"a\"\"\nb\"\"\"\n"));
+  EXPECT_EQ(string::npos, FindEndOfRecord("a,\"b\nc\n"));
+}
+
+TEST(RecordBatchesTest, ReadsBatchesOfCompleteRecords) {
+  int64 records;
+  // The blocks are shorter than the records, which span several of them.
+  vector<string> batches =
+      ReadAllBatches("1,a\n2,b\r\n3,c\n4,d\n5,e", 3, 2, &records);
+  ASSERT_EQ(3U, batches.size());
+  EXPECT_EQ("1,a\n2,b\r\n", batches[0]);
+  EXPECT_EQ("3,c\n4,d\n", batches[1]);
+  // The last record gets the newline it lacks.
+  EXPECT_EQ("5,e\n", batches[2]);
+  EXPECT_EQ(5, records);
+
+  batches = ReadAllBatches("1,\"a\nb\"\n2,\"c\"\"\nd\"\n3\n", 4, 2, &records);
+  ASSERT_EQ(2U, batches.size());
+  EXPECT_EQ("1,\"a\nb\"\n2,\"c\"\"\nd\"\n", batches[0]);
+  EXPECT_EQ("3\n", batches[1]);
+  EXPECT_EQ(3, records);
+
+  // A quoted field which isn't closed goes on to the end of the input.
+  batches = ReadAllBatches("1\n2,\"a\n3\n", 1024, 10, &records);
+  ASSERT_EQ(1U, batches.size());
+  EXPECT_EQ("1\n2,\"a\n3\n\n", batches[0]);
+  EXPECT_EQ(2, records);
+
+  batches = ReadAllBatches("", 16, 10, &records);
+  EXPECT_TRUE(batches.empty());
+  EXPECT_EQ(0, records);
+}
+
+TEST(RecordBatchesTest, QueueWritesBatchesInInputOrder) {
+  const int kNumBatches = 100;
+  const int kNumWorkers = 4;
+  BatchQueue queue(8);
+  vector<std::thread> workers;
+  for (int i = 0; i < kNumWorkers; ++i) {
+    workers.push_back(std::thread([&queue] {
+      while (Batch* const batch = queue.PopInput()) {
+        batch->output = batch->input + "!";
+        queue.PushOutput(batch);
+      }
+    }));
+  }
+  std::thread reader([&queue] {
+    for (int i = 0; i < kNumBatches; ++i) {
+      Batch* const batch = new Batch();
+      batch->sequence = i;
+      batch->input = std::to_string(i);
+      queue.PushInput(batch);
+    }
+    queue.Close();
+  });
+  int64 expected_sequence = 0;
+  while (Batch* const batch = queue.PopOutput()) {
+    EXPECT_EQ(expected_sequence, batch->sequence);
+    EXPECT_EQ(std::to_string(expected_sequence) + "!", batch->output);
+    ++expected_sequence;
+    delete batch;
+    queue.Release();
+  }
+  EXPECT_EQ(kNumBatches, expected_sequence);
+  reader.join();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+TEST(RecordBatchesTest, QueueWaitsForMissingBatches) {
+  BatchQueue queue(3);
+  Batch* batches[3];
+  for (int i = 0; i < 3; ++i) {
+    batches[i] = new Batch();
+    batches[i]->sequence = i;
+    queue.PushInput(batches[i]);
+  }
+  queue.Close();
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(batches[i], queue.PopInput());
+  }
+  EXPECT_TRUE(queue.PopInput() == NULL);
+  // The batches are processed out of order, and the first one comes last.
+  queue.PushOutput(batches[2]);
+  queue.PushOutput(batches[1]);
+  std::thread worker([&queue, &batches] { queue.PushOutput(batches[0]); });
+  for (int i = 0; i < 3; ++i) {
+    Batch* const batch = queue.PopOutput();
+    EXPECT_EQ(batches[i], batch);
+    delete batch;
+    queue.Release();
+  }
+  EXPECT_TRUE(queue.PopOutput() == NULL);
+  worker.join();
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
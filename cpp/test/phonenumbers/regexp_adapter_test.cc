@@ -193,6 +193,51 @@ TEST_F(RegExpAdapterTest, TestFindAndConsume) {
   }
 }
 
+TEST_F(RegExpAdapterTest, TestConsumeStringView) {
+  for (TestContextIterator it = contexts_.begin(); it != contexts_.end();
+       ++it) {
+    const RegExpTestContext& context = **it;
+    const string input("+1-123-456-789");
+    size_t end = 0;
+
+    // Anchored matching fails when the input doesn't start with a match.
+    ASSERT_FALSE(context.digits->Consume(input, &end)) << ErrorMessage(context);
+    ASSERT_EQ(0U, end) << ErrorMessage(context);
+
+    // Anchored matching from an offset.
+    ASSERT_TRUE(context.digits->Consume(input, 1, true, &end))
+        << ErrorMessage(context);
+    ASSERT_EQ(2U, end) << ErrorMessage(context);
+    ASSERT_FALSE(context.digits->Consume(input, 2, true, &end))
+        << ErrorMessage(context);
+
+    // Unanchored matching from an offset.
+    ASSERT_TRUE(context.digits->Consume(input, 2, false, &end))
+        << ErrorMessage(context);
+    ASSERT_EQ(6U, end) << ErrorMessage(context);
+    ASSERT_TRUE(context.two_digit_groups->Consume(input, 0, false, &end))
+        << ErrorMessage(context);
+    ASSERT_EQ(6U, end) << ErrorMessage(context);
+    ASSERT_FALSE(context.parentheses_digits->Consume(input, 0, false, NULL))
+        << ErrorMessage(context);
+
+    // The end offset is optional.
+    ASSERT_TRUE(context.digits->Consume(input, 3, true, NULL))
+        << ErrorMessage(context);
+
+    // Matching never starts past the end of the input.
+    ASSERT_FALSE(context.digits->Consume(input, input.size() + 1, false, &end))
+        << ErrorMessage(context);
+    ASSERT_FALSE(context.digits->Consume("", &end)) << ErrorMessage(context);
+
+    // Offsets are expressed in bytes of the UTF-8 input.
+    const string utf8_input("\xE2\x84\xA1" "12" /* "℡12" */);
+    ASSERT_TRUE(context.digits->Consume(utf8_input, 0, false, &end))
+        << ErrorMessage(context);
+    ASSERT_EQ(5U, end) << ErrorMessage(context);
+  }
+}
+
 TEST_F(RegExpAdapterTest, TestPartialMatch) {
   for (TestContextIterator it = contexts_.begin(); it != contexts_.end();
        ++it) {
@@ -0,0 +1,356 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/region_phonenumberutil.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/metadata.h"
+#include "phonenumbers/phonemetadata.pb.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/regexp_adapter.h"
+#include "phonenumbers/regexp_factory.h"
+#include "phonenumbers/region_metadata_for_testing.h"
+#include "phonenumber_generator.h"
+#include "region_metadata_generator.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::set;
+using std::string;
+using std::vector;
+
+namespace {
+
+const int kNumbersPerType = 3;
+
+bool Matches(const vector<uint16>& transitions, const vector<uint8>& accepting,
+             const string& digits) {
+  int state = 1;
+  for (char digit : digits) {
+    state = transitions[10 * state + (digit - '0')];
+  }
+  return accepting[state] != 0;
+}
+
+// Adds number and the numbers differing from it by one digit, to exercise the
+// edges of the patterns.
+void AddVariants(const string& number, set<string>* variants) {
+  variants->insert(number);
+  for (size_t i = 0; i <= number.length(); ++i) {
+    if (i < number.length()) {
+      variants->insert(number.substr(0, i) + number.substr(i + 1));
+    }
+    for (char digit = '0'; digit <= '9'; ++digit) {
+      variants->insert(number.substr(0, i) + digit + number.substr(i));
+      if (i < number.length()) {
+        string changed(number);
+        changed[i] = digit;
+        variants->insert(changed);
+      }
+    }
+  }
+}
+
+// Returns whether RegionPhoneNumberUtil::Parse() accepts the characters of
+// number.
+bool HasOnlySupportedCharacters(const string& number) {
+  return number.find_first_not_of("0123456789+ -./()[]") == string::npos;
+}
+
+}  // namespace
+
+TEST(RegionMetadataGeneratorTest, CompilesPatternsLikeTheRegExpEngine) {
+  PhoneMetadataCollection collection;
+  ASSERT_TRUE(collection.ParseFromArray(metadata_get(), metadata_size()));
+  const RegExpFactory regexp_factory;
+  for (const PhoneMetadata& metadata : collection.metadata()) {
+    const PhoneNumberDesc* const descs[] = {
+      &metadata.general_desc(), &metadata.fixed_line(), &metadata.mobile(),
+      &metadata.toll_free(), &metadata.premium_rate(), &metadata.shared_cost(),
+      &metadata.personal_number(), &metadata.voip(), &metadata.pager(),
+      &metadata.uan(), &metadata.voicemail(),
+    };
+    set<string> numbers;
+    for (const PhoneNumberDesc* desc : descs) {
+      if (desc->has_example_number()) {
+        AddVariants(desc->example_number(), &numbers);
+      }
+    }
+    for (const PhoneNumberDesc* desc : descs) {
+      const string& pattern = desc->national_number_pattern();
+      if (pattern.empty()) {
+        continue;
+      }
+      vector<uint16> transitions;
+      vector<uint8> accepting;
+      string error;
+      ASSERT_TRUE(
+          CompileDigitAutomaton(pattern, &transitions, &accepting, &error))
+          << error;
+      EXPECT_EQ(10 * accepting.size(), transitions.size());
+      const scoped_ptr<const RegExp> regexp(
+          regexp_factory.CreateRegExp(pattern));
+      for (const string& number : numbers) {
+        EXPECT_EQ(regexp->FullMatch(number),
+                  Matches(transitions, accepting, number))
+            << pattern << " " << number;
+      }
+    }
+  }
+}
+
+TEST(RegionMetadataGeneratorTest, CompilesMinimalAutomata) {
+  vector<uint16> transitions;
+  vector<uint8> accepting;
+  string error;
+  ASSERT_TRUE(CompileDigitAutomaton("(?:1|2)\\d?|[12]\\d", &transitions,
+                                    &accepting, &error));
+  // The rejecting state, the initial state, and the states after one and two
+  // digits.
+  EXPECT_EQ(4U, accepting.size());
+  EXPECT_TRUE(Matches(transitions, accepting, "1"));
+  EXPECT_TRUE(Matches(transitions, accepting, "29"));
+  EXPECT_FALSE(Matches(transitions, accepting, "3"));
+  EXPECT_FALSE(Matches(transitions, accepting, "123"));
+
+  ASSERT_TRUE(CompileDigitAutomaton("[^0]+(?:00)*", &transitions, &accepting,
+                                    &error));
+  EXPECT_TRUE(Matches(transitions, accepting, "1"));
+  EXPECT_TRUE(Matches(transitions, accepting, "2300"));
+  EXPECT_FALSE(Matches(transitions, accepting, ""));
+  EXPECT_FALSE(Matches(transitions, accepting, "230"));
+
+  EXPECT_FALSE(CompileDigitAutomaton("\\w{3}", &transitions, &accepting,
+                                     &error));
+  EXPECT_FALSE(error.empty());
+  EXPECT_FALSE(CompileDigitAutomaton("\\d+?", &transitions, &accepting,
+                                     &error));
+}
+
+TEST(RegionMetadataGeneratorTest, ExpandsPrefixesInMatchingOrder) {
+  vector<vector<uint16> > prefixes;
+  string error;
+  ASSERT_TRUE(ExpandDigitPrefixes("0(?:11|1)?", &prefixes, &error));
+  ASSERT_EQ(3U, prefixes.size());
+  EXPECT_EQ(vector<uint16>({ 1 << 0, 1 << 1, 1 << 1 }), prefixes[0]);
+  EXPECT_EQ(vector<uint16>({ 1 << 0, 1 << 1 }), prefixes[1]);
+  EXPECT_EQ(vector<uint16>({ 1 << 0 }), prefixes[2]);
+
+  // The alternatives are tried in order, not from the longest.
+  ASSERT_TRUE(ExpandDigitPrefixes("00|0[01]1", &prefixes, &error));
+  ASSERT_EQ(2U, prefixes.size());
+  EXPECT_EQ(vector<uint16>({ 1 << 0, 1 << 0 }), prefixes[0]);
+  EXPECT_EQ(vector<uint16>({ 1 << 0, 1 << 0 | 1 << 1, 1 << 1 }), prefixes[1]);
+
+  EXPECT_FALSE(ExpandDigitPrefixes("0\\d*", &prefixes, &error));
+  EXPECT_FALSE(error.empty());
+}
+
+class RegionPhoneNumberUtilTest : public testing::Test {
+ public:
+  // This type is neither copyable nor movable.
+  RegionPhoneNumberUtilTest(const RegionPhoneNumberUtilTest&) = delete;
+  RegionPhoneNumberUtilTest& operator=(const RegionPhoneNumberUtilTest&) =
+      delete;
+
+ protected:
+  RegionPhoneNumberUtilTest() : phone_util_(*PhoneNumberUtil::GetInstance()) {}
+
+  // Checks that RegionUtil parses number_to_parse, and validates and formats
+  // the result, as PhoneNumberUtil does with the region of RegionUtil.
+  template <typename RegionUtil>
+  void ExpectSameResults(const string& number_to_parse) {
+    const string region_code = RegionUtil::GetRegionCode();
+    PhoneNumber number;
+    const PhoneNumberUtil::ErrorType error =
+        phone_util_.Parse(number_to_parse, region_code, &number);
+    RegionPhoneNumber region_number;
+    const typename RegionUtil::ErrorType region_error =
+        RegionUtil::Parse(number_to_parse, &region_number);
+    if (!HasOnlySupportedCharacters(number_to_parse)) {
+      EXPECT_EQ(RegionUtil::NOT_A_NUMBER, region_error) << number_to_parse;
+      return;
+    }
+    if (error == PhoneNumberUtil::NO_PARSING_ERROR &&
+        number.country_code() != RegionUtil::GetCountryCode()) {
+      // The numbers of other countries aren't supported.
+      EXPECT_EQ(RegionUtil::INVALID_COUNTRY_CODE_ERROR, region_error)
+          << number_to_parse;
+      return;
+    }
+    ASSERT_EQ(static_cast<int>(error), static_cast<int>(region_error))
+        << number_to_parse << " in " << region_code;
+    if (error != PhoneNumberUtil::NO_PARSING_ERROR) {
+      return;
+    }
+    EXPECT_EQ(number.country_code(), region_number.country_code);
+    EXPECT_EQ(number.national_number(), region_number.national_number)
+        << number_to_parse << " in " << region_code;
+    EXPECT_EQ(number.italian_leading_zero(),
+              region_number.italian_leading_zero);
+    EXPECT_EQ(number.number_of_leading_zeros(),
+              region_number.number_of_leading_zeros);
+    EXPECT_EQ(static_cast<int>(phone_util_.GetNumberType(number)),
+              static_cast<int>(RegionUtil::GetNumberType(region_number)))
+        << number_to_parse << " in " << region_code;
+    EXPECT_EQ(phone_util_.IsValidNumberForRegion(number, region_code),
+              RegionUtil::IsValidNumber(region_number));
+    EXPECT_EQ(static_cast<int>(phone_util_.IsPossibleNumberWithReason(number)),
+              static_cast<int>(
+                  RegionUtil::IsPossibleNumberWithReason(region_number)));
+    const PhoneNumberUtil::PhoneNumberFormat kFormats[] = {
+      PhoneNumberUtil::E164, PhoneNumberUtil::INTERNATIONAL,
+      PhoneNumberUtil::NATIONAL, PhoneNumberUtil::RFC3966,
+    };
+    for (PhoneNumberUtil::PhoneNumberFormat format : kFormats) {
+      string formatted;
+      string region_formatted;
+      phone_util_.Format(number, format, &formatted);
+      RegionUtil::Format(
+          region_number,
+          static_cast<typename RegionUtil::PhoneNumberFormat>(format),
+          &region_formatted);
+      EXPECT_EQ(formatted, region_formatted)
+          << number_to_parse << " in " << region_code << " format " << format;
+    }
+  }
+
+  // Compares the results of RegionUtil and PhoneNumberUtil on random numbers
+  // of each type of the region, written in various ways, and on the numbers
+  // differing from them by one digit.
+  template <typename RegionUtil>
+  void ExpectSameResultsForRegion() {
+    const string region_code = RegionUtil::GetRegionCode();
+    const string country_code = std::to_string(RegionUtil::GetCountryCode());
+    PhoneNumberGenerator generator(phone_util_, 1);
+    set<PhoneNumberUtil::PhoneNumberType> types;
+    phone_util_.GetSupportedTypesForRegion(region_code, &types);
+    set<string> inputs;
+    for (PhoneNumberUtil::PhoneNumberType type : types) {
+      PhoneNumber number;
+      for (int i = 0; i < kNumbersPerType; ++i) {
+        if (!generator.Generate(region_code, type, &number)) {
+          continue;
+        }
+        number.clear_extension();
+        string formatted;
+        phone_util_.Format(number, PhoneNumberUtil::E164, &formatted);
+        inputs.insert(formatted);
+        inputs.insert("00" + formatted.substr(1));
+        inputs.insert("011" + formatted.substr(1));
+        inputs.insert("++" + formatted.substr(1));
+        phone_util_.Format(number, PhoneNumberUtil::INTERNATIONAL, &formatted);
+        inputs.insert(formatted);
+        phone_util_.Format(number, PhoneNumberUtil::NATIONAL, &formatted);
+        inputs.insert(formatted);
+        generator.FormatMessy(number, region_code, &formatted);
+        inputs.insert(formatted);
+        string national_number;
+        phone_util_.GetNationalSignificantNumber(number, &national_number);
+        set<string> variants;
+        AddVariants(national_number, &variants);
+        for (const string& variant : variants) {
+          inputs.insert(variant);
+          inputs.insert("0" + variant);
+          inputs.insert("+" + country_code + variant);
+          inputs.insert(country_code + variant);
+        }
+      }
+    }
+    for (const string& input : inputs) {
+      ExpectSameResults<RegionUtil>(input);
+    }
+  }
+
+  const PhoneNumberUtil& phone_util_;
+};
+
+TEST_F(RegionPhoneNumberUtilTest, Parse) {
+  RegionPhoneNumber number;
+  EXPECT_EQ(RegionPhoneNumberUtilDE::NO_PARSING_ERROR,
+            RegionPhoneNumberUtilDE::Parse("030 123456", &number));
+  EXPECT_EQ(49, number.country_code);
+  EXPECT_EQ(30123456U, number.national_number);
+  EXPECT_FALSE(number.italian_leading_zero);
+
+  EXPECT_EQ(RegionPhoneNumberUtilIT::NO_PARSING_ERROR,
+            RegionPhoneNumberUtilIT::Parse("+39 02 3661 8300", &number));
+  EXPECT_EQ(39, number.country_code);
+  EXPECT_EQ(236618300U, number.national_number);
+  EXPECT_TRUE(number.italian_leading_zero);
+
+  EXPECT_EQ(RegionPhoneNumberUtilDE::NOT_A_NUMBER,
+            RegionPhoneNumberUtilDE::Parse("030 123456 ext. 7", &number));
+  EXPECT_EQ(RegionPhoneNumberUtilDE::NOT_A_NUMBER,
+            RegionPhoneNumberUtilDE::Parse("+1", &number));
+  EXPECT_EQ(RegionPhoneNumberUtilDE::TOO_SHORT_AFTER_IDD,
+            RegionPhoneNumberUtilDE::Parse("0049", &number));
+  // The numbers of other countries aren't supported.
+  EXPECT_EQ(RegionPhoneNumberUtilDE::INVALID_COUNTRY_CODE_ERROR,
+            RegionPhoneNumberUtilDE::Parse("+1 650 253 0000", &number));
+}
+
+TEST_F(RegionPhoneNumberUtilTest, Format) {
+  RegionPhoneNumber number;
+  ASSERT_EQ(RegionPhoneNumberUtilNZ::NO_PARSING_ERROR,
+            RegionPhoneNumberUtilNZ::Parse("+64 3 331 6005", &number));
+  string formatted;
+  RegionPhoneNumberUtilNZ::Format(number, RegionPhoneNumberUtilNZ::E164,
+                                  &formatted);
+  EXPECT_EQ("+6433316005", formatted);
+  RegionPhoneNumberUtilNZ::Format(
+      number, RegionPhoneNumberUtilNZ::INTERNATIONAL, &formatted);
+  EXPECT_EQ("+64 3-331 6005", formatted);
+  RegionPhoneNumberUtilNZ::Format(number, RegionPhoneNumberUtilNZ::NATIONAL,
+                                  &formatted);
+  EXPECT_EQ("03-331 6005", formatted);
+  RegionPhoneNumberUtilNZ::Format(number, RegionPhoneNumberUtilNZ::RFC3966,
+                                  &formatted);
+  EXPECT_EQ("tel:+64-3-331-6005", formatted);
+}
+
+TEST_F(RegionPhoneNumberUtilTest, AgreesWithPhoneNumberUtilOnEdgeCases) {
+  const char* const kInputs[] = {
+    "", "1", "12", "1-2", "123", "+", "++", "+1", "+12", "+ +49 30 123456",
+    "(030) 123456", "[030] 123456.", "0", "00", "000", "0049", "+0049 30 1234567",
+    "49 30 123456", "+49 030 123456", "+800 1234 5678", "+999 1234 5678",
+    "030 123456 ~ 7", "030x123456",
+  };
+  for (const char* input : kInputs) {
+    ExpectSameResults<RegionPhoneNumberUtilDE>(input);
+    ExpectSameResults<RegionPhoneNumberUtilUS>(input);
+  }
+}
+
+TEST_F(RegionPhoneNumberUtilTest, AgreesWithPhoneNumberUtil) {
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilBR>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilDE>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilIT>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilJP>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilKR>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilNZ>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilRU>();
+  ExpectSameResultsForRegion<RegionPhoneNumberUtilUS>();
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,91 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/rfc3966_tokenizer.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+TEST(Rfc3966TokenizerTest, TokenizeTelUri) {
+  TelUri tel_uri;
+  EXPECT_FALSE(TokenizeTelUri("+1-650-253-0000", &tel_uri));
+  EXPECT_FALSE(TokenizeTelUri("TEL:+1-650-253-0000", &tel_uri));
+
+  ASSERT_TRUE(TokenizeTelUri("tel:+1-650-253-0000", &tel_uri));
+  EXPECT_EQ("+1-650-253-0000", tel_uri.number);
+  EXPECT_FALSE(tel_uri.has_extension);
+  EXPECT_FALSE(tel_uri.has_isdn_subaddress);
+  EXPECT_FALSE(tel_uri.has_phone_context);
+
+  ASSERT_TRUE(TokenizeTelUri("tel:", &tel_uri));
+  EXPECT_EQ("", tel_uri.number);
+
+  const string uri(
+      "tel:253-0000;ext=123;isub=1411;phone-context=+1-650;unknown=1");
+  ASSERT_TRUE(TokenizeTelUri(uri, &tel_uri));
+  EXPECT_EQ("253-0000", tel_uri.number);
+  EXPECT_TRUE(tel_uri.has_extension);
+  EXPECT_EQ("123", tel_uri.extension);
+  EXPECT_TRUE(tel_uri.has_isdn_subaddress);
+  EXPECT_EQ("1411", tel_uri.isdn_subaddress);
+  EXPECT_TRUE(tel_uri.has_phone_context);
+  EXPECT_EQ("+1-650", tel_uri.phone_context);
+  // The components are views of the input.
+  EXPECT_EQ(uri.data() + 4, tel_uri.number.data());
+
+  // Only the first parameter of each kind is used, and an empty value is
+  // reported as such.
+  ASSERT_TRUE(TokenizeTelUri("tel:1234;phone-context=;phone-context=a.b",
+                             &tel_uri));
+  EXPECT_TRUE(tel_uri.has_phone_context);
+  EXPECT_EQ("", tel_uri.phone_context);
+
+  // Parameter names are case-sensitive.
+  ASSERT_TRUE(TokenizeTelUri("tel:1234;EXT=5", &tel_uri));
+  EXPECT_FALSE(tel_uri.has_extension);
+}
+
+TEST(Rfc3966TokenizerTest, IsValidAsciiPhoneContext) {
+  // Global numbers.
+  EXPECT_TRUE(IsValidAsciiPhoneContext("+1"));
+  EXPECT_TRUE(IsValidAsciiPhoneContext("+1-(650).253"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("+"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("+-."));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("+1 650"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("1650"));
+
+  // Domain names.
+  EXPECT_TRUE(IsValidAsciiPhoneContext("example.com"));
+  EXPECT_TRUE(IsValidAsciiPhoneContext("example.com."));
+  EXPECT_TRUE(IsValidAsciiPhoneContext("a"));
+  EXPECT_TRUE(IsValidAsciiPhoneContext("3com.b--2"));
+  EXPECT_TRUE(IsValidAsciiPhoneContext("my-host.example.org"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext(""));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("."));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("example..com"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext(".example.com"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("-host.com"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("host-.com"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("example.3com"));
+  EXPECT_FALSE(IsValidAsciiPhoneContext("example.c_m"));
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -42,5 +42,16 @@ TEST(UnicodeTextTest, Iterator) {
   }
 }
 
+TEST(UnicodeTextTest, PointToValidUTF8) {
+  const string number("\xEF\xBC\x91" "2");
+  UnicodeText number_as_unicode;
+  number_as_unicode.PointToValidUTF8(number.data(), number.size());
+  EXPECT_TRUE(number_as_unicode.UTF8WasValid());
+  EXPECT_EQ(number.data(), number_as_unicode.utf8_data());
+  UnicodeText::const_iterator it = number_as_unicode.begin();
+  EXPECT_EQ(0xFF11, *it);
+  EXPECT_EQ('2', *++it);
+}
+
 } // namespace phonenumbers
 } // namespace i18n
@@ -0,0 +1,97 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumbers/utf/unilib.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "phonenumbers/utf/utf.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+
+namespace {
+
+// Decodes every character, like SpanInterchangeValid() did before it skipped
+// the ASCII characters.
+int ReferenceSpanInterchangeValid(const string& text) {
+  const char* p = text.data();
+  const char* const end = text.data() + text.size();
+  while (p < end) {
+    Rune rune;
+    const int bytes_consumed =
+        charntorune(&rune, p, static_cast<int>(end - p));
+    if ((rune == Runeerror && bytes_consumed <= 1) ||
+        (rune >= 0x00 && rune <= 0x08) || rune == 0x0B ||
+        (rune >= 0x0E && rune <= 0x1F) || (rune >= 0x7F && rune <= 0x9F) ||
+        (rune >= 0xD800 && rune <= 0xDFFF) ||
+        (rune >= 0xFDD0 && rune <= 0xFDEF) || (rune & 0xFFFE) == 0xFFFE) {
+      break;
+    }
+    p += bytes_consumed;
+  }
+  return static_cast<int>(p - text.data());
+}
+
+}  // namespace
+
+TEST(UniLibTest, SpanInterchangeValidAscii) {
+  EXPECT_EQ(0, UniLib::SpanInterchangeValidAscii(""));
+  EXPECT_EQ(15, UniLib::SpanInterchangeValidAscii("+1 650-253-0000"));
+  EXPECT_EQ(20,
+            UniLib::SpanInterchangeValidAscii("+1 650-253-0000\t\r\n\f~"));
+  // Stops at the first character which isn't ASCII or is a control.
+  EXPECT_EQ(11, UniLib::SpanInterchangeValidAscii("+1 650-253-\xEF\xBC\x90"));
+  EXPECT_EQ(11, UniLib::SpanInterchangeValidAscii("+1 650-253-\x7F" "0000"));
+  EXPECT_EQ(9, UniLib::SpanInterchangeValidAscii(string("123456789\0", 10)));
+  EXPECT_EQ(11, UniLib::SpanInterchangeValidAscii("12345678901\x01"));
+}
+
+TEST(UniLibTest, SpanInterchangeValid) {
+  EXPECT_TRUE(UniLib::IsInterchangeValid("+1 650-253-0000"));
+  EXPECT_TRUE(UniLib::IsInterchangeValid("\xEF\xBC\x8B\xEF\xBC\x91 650"));
+  EXPECT_FALSE(UniLib::IsInterchangeValid("+1 650-253-\xC3"));
+  EXPECT_FALSE(UniLib::IsInterchangeValid("+1 650-253-\x1B"));
+
+  // Agrees with decoding every character, wherever the ASCII characters,
+  // controls and other characters are in the eight-byte words.
+  static const char* const kAlphabet[] = {
+    "1", "-", " ", "~", "\t", "\n", "\x7F", "\x01", "\xC2\x85" /* U+0085 */,
+    "\xC3\xA9" /* U+00E9 */, "\xEF\xBC\x91" /* U+FF11 */,
+    "\xF0\x9F\x93\x9E" /* U+1F4DE */, "\xEF\xBF\xBD" /* U+FFFD */,
+    "\xEF\xBF\xBE" /* U+FFFE */, "\xC3", "\x80",
+  };
+  const int alphabet_size = sizeof(kAlphabet) / sizeof(kAlphabet[0]);
+  unsigned int random = 1;
+  for (int iteration = 0; iteration < 20000; ++iteration) {
+    random = random * 1103515245 + 12345;
+    const int length = (random >> 16) % 40;
+    string input;
+    for (int i = 0; i < length; ++i) {
+      random = random * 1103515245 + 12345;
+      const int index = (random >> 16) % (2 * alphabet_size);
+      // Mostly printable ASCII, like phone numbers.
+      input.append(kAlphabet[index < alphabet_size ? index : index % 4]);
+    }
+    EXPECT_EQ(ReferenceSpanInterchangeValid(input),
+              UniLib::SpanInterchangeValid(input)) << input;
+  }
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,107 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Writes the header defining the metadata of regions for
+// RegionPhoneNumberUtil, from the metadata compiled into the library, e.g. for
+// firmware handling German numbers only:
+//
+//   generate_region_metadata --output=region_metadata_de.h DE
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "phonenumbers/metadata.h"
+#include "phonenumbers/phonemetadata.pb.h"
+#include "region_metadata_generator.h"
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+int PrintHelp(const string& message) {
+  fprintf(stderr, "error: %s\n", message.c_str());
+  fprintf(stderr,
+          "usage: generate_region_metadata --output=FILE REGION...\n"
+          "Writes the metadata of the regions, such as DE, for "
+          "RegionPhoneNumberUtil.\n");
+  return 1;
+}
+
+// Returns the include guard of the header at path, e.g.
+// I18N_PHONENUMBERS_REGION_METADATA_DE_H_ for region_metadata_de.h.
+string GetHeaderGuard(const string& path) {
+  const size_t slash = path.find_last_of("/\\");
+  const string name = slash == string::npos ? path : path.substr(slash + 1);
+  string header_guard = "I18N_PHONENUMBERS_";
+  for (char c : name) {
+    if (c >= 'a' && c <= 'z') {
+      header_guard.push_back(static_cast<char>(c - 'a' + 'A'));
+    } else if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+      header_guard.push_back(c);
+    } else {
+      header_guard.push_back('_');
+    }
+  }
+  return header_guard + "_";
+}
+
+int Main(int argc, const char* argv[]) {
+  string output_path;
+  vector<string> region_codes;
+  for (int i = 1; i < argc; ++i) {
+    const string argument(argv[i]);
+    if (argument.compare(0, 9, "--output=") == 0) {
+      output_path = argument.substr(9);
+    } else if (argument.compare(0, 1, "-") == 0) {
+      return PrintHelp("unknown argument " + argument);
+    } else {
+      region_codes.push_back(argument);
+    }
+  }
+  if (output_path.empty() || region_codes.empty()) {
+    return PrintHelp("missing output or regions");
+  }
+
+  PhoneMetadataCollection collection;
+  if (!collection.ParseFromArray(metadata_get(), metadata_size())) {
+    fprintf(stderr, "error: could not parse the metadata\n");
+    return 1;
+  }
+  string header;
+  string error;
+  if (!GenerateRegionMetadataHeader(collection, region_codes,
+                                    GetHeaderGuard(output_path), &header,
+                                    &error)) {
+    fprintf(stderr, "error: %s\n", error.c_str());
+    return 1;
+  }
+  FILE* const output = fopen(output_path.c_str(), "w");
+  if (!output) {
+    fprintf(stderr, "error: could not open %s\n", output_path.c_str());
+    return 1;
+  }
+  const bool written =
+      fwrite(header.data(), 1, header.size(), output) == header.size();
+  return fclose(output) == 0 && written ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace phonenumbers
+}  // namespace i18n
+
+int main(int argc, const char* argv[]) {
+  return i18n::phonenumbers::Main(argc, argv);
+}
@@ -0,0 +1,542 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Parses the phone numbers of a delimited text file, and appends the requested
+// columns to each of its records, e.g. to clean up the numbers of a CSV file
+// with the region of each number in its third column:
+//
+//   phonenumber_bulk --input=contacts.csv --delimiter=, --column=1
+//       --region_column=2 --operations=parse,valid,e164 > cleaned.csv
+//
+// Like in CSV files, fields between double quotes may contain the delimiter and
+// newlines, see record_batches.h.
+//
+// The input is read in large blocks and split into batches of records, which
+// are processed by a pool of threads and written in input order. The throughput
+// and the time spent in each stage are reported on the standard error, so this
+// also benchmarks the library end to end, e.g. on the output of
+// phonenumber_generate.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/base/memory/scoped_ptr.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/shortnumberinfo.h"
+#include "phonenumbers/stringutil.h"
+#include "record_batches.h"
+
+#ifdef I18N_PHONENUMBERS_USE_GEOCODER
+#include <unicode/locid.h>
+
+#include "phonenumbers/geocoding/phonenumber_offline_geocoder.h"
+#endif  // I18N_PHONENUMBERS_USE_GEOCODER
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+// The input is read in blocks of this size.
+const size_t kReadBlockSize = 8 << 20;
+
+enum Operation {
+  PARSE,
+  VALID,
+  TYPE,
+  REGION,
+  E164,
+  INTERNATIONAL,
+  NATIONAL,
+  GEOCODE,
+  SHORT_NUMBER,
+};
+
+const char* const kOperationNames[] = {
+  "parse", "valid", "type", "region", "e164", "international", "national",
+  "geocode", "short",
+};
+
+enum Stage {
+  READ_STAGE,
+  PARSE_STAGE,
+  VALIDATE_STAGE,
+  FORMAT_STAGE,
+  GEOCODE_STAGE,
+  SHORT_NUMBER_STAGE,
+  WRITE_STAGE,
+  NUM_STAGES,
+};
+
+const char* const kStageNames[] = {
+  "read", "parse", "validate", "format", "geocode", "short", "write",
+};
+
+const char* const kErrorNames[] = {
+  "OK", "INVALID_COUNTRY_CODE", "NOT_A_NUMBER", "TOO_SHORT_AFTER_IDD",
+  "TOO_SHORT_NSN", "TOO_LONG_NSN", "DEADLINE_EXCEEDED",
+};
+
+const char* const kTypeNames[] = {
+  "FIXED_LINE", "MOBILE", "FIXED_LINE_OR_MOBILE", "TOLL_FREE", "PREMIUM_RATE",
+  "SHARED_COST", "VOIP", "PERSONAL_NUMBER", "PAGER", "UAN", "VOICEMAIL",
+  "UNKNOWN",
+};
+
+const char* const kShortNumberCostNames[] = {
+  "TOLL_FREE", "STANDARD_RATE", "PREMIUM_RATE", "UNKNOWN_COST",
+};
+
+struct Options {
+  Options()
+      : input_path("-"),
+        output_path("-"),
+        delimiter('\t'),
+        column(0),
+        region_column(-1),
+        default_region("ZZ"),
+        locale("en"),
+        threads(std::thread::hardware_concurrency()),
+        batch_size(4096) {
+    operations.push_back(PARSE);
+    operations.push_back(VALID);
+    operations.push_back(TYPE);
+    operations.push_back(E164);
+  }
+
+  // "-" for the standard input and output.
+  string input_path;
+  string output_path;
+  char delimiter;
+  int column;
+  // -1 if every number is parsed with default_region.
+  int region_column;
+  string default_region;
+  string locale;
+  vector<Operation> operations;
+  int threads;
+  int batch_size;
+};
+
+// The time spent in each stage.
+struct StageTimes {
+  StageTimes() {
+    for (int i = 0; i < NUM_STAGES; ++i) {
+      durations[i] = Clock::duration::zero();
+    }
+  }
+
+  void Add(const StageTimes& other) {
+    for (int i = 0; i < NUM_STAGES; ++i) {
+      durations[i] += other.durations[i];
+    }
+  }
+
+  Clock::duration durations[NUM_STAGES];
+};
+
+// Adds the time elapsed since the previous lap to the stage of each lap.
+class StageClock {
+ public:
+  explicit StageClock(StageTimes* times)
+      : times_(times),
+        last_lap_(Clock::now()) {}
+
+  void Lap(Stage stage) {
+    const Clock::time_point now = Clock::now();
+    times_->durations[stage] += now - last_lap_;
+    last_lap_ = now;
+  }
+
+  // Starts a new lap without attributing the elapsed time to a stage, e.g.
+  // after waiting for another thread.
+  void Skip() {
+    last_lap_ = Clock::now();
+  }
+
+ private:
+  StageTimes* const times_;
+  Clock::time_point last_lap_;
+};
+
+// Processes the records of the batches. It is shared by the worker threads.
+class RecordProcessor {
+ public:
+  explicit RecordProcessor(const Options& options)
+      : options_(options),
+        phone_util_(*PhoneNumberUtil::GetInstance()) {
+    for (vector<Operation>::const_iterator it = options.operations.begin();
+         it != options.operations.end(); ++it) {
+      if (*it == SHORT_NUMBER && !short_info_.get()) {
+        short_info_.reset(new ShortNumberInfo());
+      }
+#ifdef I18N_PHONENUMBERS_USE_GEOCODER
+      if (*it == GEOCODE && !geocoder_.get()) {
+        geocoder_.reset(new PhoneNumberOfflineGeocoder());
+        locale_ = icu::Locale::createFromName(options.locale.c_str());
+      }
+#endif  // I18N_PHONENUMBERS_USE_GEOCODER
+    }
+  }
+
+  void ProcessBatch(Batch* batch, StageTimes* times) const {
+    StageClock clock(times);
+    vector<string> fields;
+    PhoneNumber number;
+    string value;
+    absl::string_view input(batch->input);
+    batch->output.clear();
+    batch->output.reserve(batch->input.size() * 2);
+    while (!input.empty()) {
+      // The last record of the input may end in a quoted field which isn't
+      // closed.
+      const size_t record_end =
+          std::min(FindEndOfRecord(input), input.size() - 1);
+      absl::string_view record = input.substr(0, record_end);
+      input.remove_prefix(record_end + 1);
+      if (!record.empty() && record.back() == '\r') {
+        record.remove_suffix(1);
+      }
+      ProcessRecord(record, &clock, &fields, &number, &value, &batch->output);
+    }
+  }
+
+ private:
+  void ProcessRecord(absl::string_view record, StageClock* clock,
+                     vector<string>* fields, PhoneNumber* number,
+                     string* value, string* output) const {
+    SplitFields(record, options_.delimiter, fields);
+    const string& region =
+        options_.region_column >= 0 &&
+                options_.region_column < static_cast<int>(fields->size())
+            ? (*fields)[options_.region_column]
+            : options_.default_region;
+    const string empty;
+    const string& text = options_.column < static_cast<int>(fields->size())
+        ? (*fields)[options_.column]
+        : empty;
+    const PhoneNumberUtil::ErrorType error =
+        phone_util_.Parse(text, region, number);
+    clock->Lap(PARSE_STAGE);
+
+    output->append(record.data(), record.size());
+    for (vector<Operation>::const_iterator it = options_.operations.begin();
+         it != options_.operations.end(); ++it) {
+      value->clear();
+      if (*it == PARSE) {
+        value->assign(kErrorNames[error]);
+      } else if (error == PhoneNumberUtil::NO_PARSING_ERROR) {
+        ComputeValue(*it, *number, text, region, clock, value);
+      }
+      AppendField(*value, options_.delimiter, output);
+    }
+    output->push_back('\n');
+  }
+
+  void ComputeValue(Operation operation, const PhoneNumber& number,
+                    const string& text, const string& region,
+                    StageClock* clock, string* value) const {
+    switch (operation) {
+      case PARSE:
+        break;
+      case VALID:
+        value->assign(phone_util_.IsValidNumber(number) ? "true" : "false");
+        clock->Lap(VALIDATE_STAGE);
+        break;
+      case TYPE:
+        value->assign(kTypeNames[phone_util_.GetNumberType(number)]);
+        clock->Lap(VALIDATE_STAGE);
+        break;
+      case REGION:
+        phone_util_.GetRegionCodeForNumber(number, value);
+        clock->Lap(VALIDATE_STAGE);
+        break;
+      case E164:
+        phone_util_.Format(number, PhoneNumberUtil::E164, value);
+        clock->Lap(FORMAT_STAGE);
+        break;
+      case INTERNATIONAL:
+        phone_util_.Format(number, PhoneNumberUtil::INTERNATIONAL, value);
+        clock->Lap(FORMAT_STAGE);
+        break;
+      case NATIONAL:
+        phone_util_.Format(number, PhoneNumberUtil::NATIONAL, value);
+        clock->Lap(FORMAT_STAGE);
+        break;
+      case GEOCODE:
+#ifdef I18N_PHONENUMBERS_USE_GEOCODER
+        value->assign(geocoder_->GetDescriptionForNumber(number, locale_));
+        clock->Lap(GEOCODE_STAGE);
+#endif  // I18N_PHONENUMBERS_USE_GEOCODER
+        break;
+      case SHORT_NUMBER:
+        if (short_info_->IsEmergencyNumber(text, region)) {
+          value->assign("EMERGENCY");
+        } else if (short_info_->IsValidShortNumberForRegion(number, region)) {
+          value->assign(kShortNumberCostNames[
+              short_info_->GetExpectedCostForRegion(number, region)]);
+        } else {
+          value->assign("NOT_SHORT");
+        }
+        clock->Lap(SHORT_NUMBER_STAGE);
+        break;
+    }
+  }
+
+  const Options& options_;
+  const PhoneNumberUtil& phone_util_;
+  scoped_ptr<const ShortNumberInfo> short_info_;
+#ifdef I18N_PHONENUMBERS_USE_GEOCODER
+  scoped_ptr<const PhoneNumberOfflineGeocoder> geocoder_;
+  icu::Locale locale_;
+#endif  // I18N_PHONENUMBERS_USE_GEOCODER
+};
+
+int PrintHelp(const string& message) {
+  fprintf(stderr, "error: %s\n", message.c_str());
+  fprintf(stderr,
+          "usage: phonenumber_bulk [--input=-] [--output=-] [--delimiter=TAB]\n"
+          "    [--column=0] [--region_column=N] [--region=ZZ]\n"
+          "    [--operations=parse,valid,type,e164] [--locale=en]\n"
+          "    [--threads=N] [--batch_size=4096]\n"
+          "The operations are parse, valid, type, region, e164, "
+          "international,\nnational, geocode and short. Each of them appends "
+          "a column to the records.\n");
+  return 1;
+}
+
+bool ParseInteger(const string& value, int min_value, int* result) {
+  if (value.empty()) {
+    return false;
+  }
+  char* end;
+  const long parsed = strtol(value.c_str(), &end, 10);
+  if (*end != '\0' || parsed < min_value || parsed > kint32max) {
+    return false;
+  }
+  *result = static_cast<int>(parsed);
+  return true;
+}
+
+// Returns an empty string if the options are valid, or the error otherwise.
+string ParseOptions(int argc, const char* argv[], Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    const string argument(argv[i]);
+    const size_t equals = argument.find('=');
+    const string name = argument.substr(0, equals);
+    const string value =
+        equals == string::npos ? "" : argument.substr(equals + 1);
+    if (name == "--input") {
+      options->input_path = value;
+    } else if (name == "--output") {
+      options->output_path = value;
+    } else if (name == "--delimiter") {
+      if (value.size() != 1 || value[0] == '"' || value[0] == '\n') {
+        return "invalid delimiter " + value;
+      }
+      options->delimiter = value[0];
+    } else if (name == "--column") {
+      if (!ParseInteger(value, 0, &options->column)) {
+        return "invalid column " + value;
+      }
+    } else if (name == "--region_column") {
+      if (!ParseInteger(value, 0, &options->region_column)) {
+        return "invalid region column " + value;
+      }
+    } else if (name == "--region") {
+      options->default_region = value;
+    } else if (name == "--locale") {
+      options->locale = value;
+    } else if (name == "--threads") {
+      if (!ParseInteger(value, 1, &options->threads)) {
+        return "invalid number of threads " + value;
+      }
+    } else if (name == "--batch_size") {
+      if (!ParseInteger(value, 1, &options->batch_size)) {
+        return "invalid batch size " + value;
+      }
+    } else if (name == "--operations") {
+      vector<string> operation_names;
+      SplitStringUsing(value, ',', &operation_names);
+      options->operations.clear();
+      for (vector<string>::const_iterator it = operation_names.begin();
+           it != operation_names.end(); ++it) {
+        size_t operation = 0;
+        while (operation < sizeof(kOperationNames) / sizeof(kOperationNames[0])
+               && *it != kOperationNames[operation]) {
+          ++operation;
+        }
+        if (operation == sizeof(kOperationNames) / sizeof(kOperationNames[0])) {
+          return "unknown operation " + *it;
+        }
+#ifndef I18N_PHONENUMBERS_USE_GEOCODER
+        if (operation == GEOCODE) {
+          return "geocode needs a build with BUILD_GEOCODER";
+        }
+#endif  // I18N_PHONENUMBERS_USE_GEOCODER
+        options->operations.push_back(static_cast<Operation>(operation));
+      }
+    } else {
+      return "unknown argument " + argument;
+    }
+  }
+  if (options->threads < 1) {
+    options->threads = 1;
+  }
+  return "";
+}
+
+// Reads the input in blocks, and pushes it to queue in batches of complete
+// records. Returns false on read errors.
+bool ReadBatches(FILE* input, int batch_size, BatchQueue* queue,
+                 StageTimes* times, int64* bytes_read, int64* records) {
+  StageClock clock(times);
+  BatchReader reader(input, kReadBlockSize, batch_size);
+  int64 sequence = 0;
+  for (;;) {
+    Batch* const batch = new Batch();
+    if (!reader.Next(&batch->input)) {
+      delete batch;
+      break;
+    }
+    batch->sequence = sequence++;
+    clock.Lap(READ_STAGE);
+    queue->PushInput(batch);
+    clock.Skip();
+  }
+  clock.Lap(READ_STAGE);
+  queue->Close();
+  *bytes_read = reader.bytes_read();
+  *records = reader.records();
+  return !reader.error();
+}
+
+int Main(int argc, const char* argv[]) {
+  Options options;
+  const string error = ParseOptions(argc, argv, &options);
+  if (!error.empty()) {
+    return PrintHelp(error);
+  }
+  FILE* const input = options.input_path == "-"
+      ? stdin
+      : fopen(options.input_path.c_str(), "rb");
+  if (!input) {
+    fprintf(stderr, "failed to open %s\n", options.input_path.c_str());
+    return 1;
+  }
+  FILE* const output = options.output_path == "-"
+      ? stdout
+      : fopen(options.output_path.c_str(), "wb");
+  if (!output) {
+    fprintf(stderr, "failed to open %s\n", options.output_path.c_str());
+    return 1;
+  }
+
+  const Clock::time_point start = Clock::now();
+  const RecordProcessor processor(options);
+  BatchQueue queue(options.threads * 4);
+  vector<StageTimes> worker_times(options.threads);
+  vector<std::thread> workers;
+  for (int i = 0; i < options.threads; ++i) {
+    StageTimes* const times = &worker_times[i];
+    workers.push_back(std::thread([&processor, &queue, times] {
+      while (Batch* const batch = queue.PopInput()) {
+        processor.ProcessBatch(batch, times);
+        queue.PushOutput(batch);
+      }
+    }));
+  }
+  StageTimes writer_times;
+  bool write_error = false;
+  std::thread writer([&queue, &writer_times, &write_error, output] {
+    StageClock clock(&writer_times);
+    while (Batch* const batch = queue.PopOutput()) {
+      clock.Skip();
+      write_error |= fwrite(batch->output.data(), 1, batch->output.size(),
+                            output) != batch->output.size();
+      delete batch;
+      clock.Lap(WRITE_STAGE);
+      queue.Release();
+    }
+  });
+
+  StageTimes reader_times;
+  int64 bytes_read = 0;
+  int64 records = 0;
+  const bool read_ok = ReadBatches(input, options.batch_size, &queue,
+                                   &reader_times, &bytes_read, &records);
+  for (vector<std::thread>::iterator it = workers.begin(); it != workers.end();
+       ++it) {
+    it->join();
+  }
+  writer.join();
+  write_error |= fflush(output) != 0;
+  const double seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  if (input != stdin) {
+    fclose(input);
+  }
+  if (output != stdout) {
+    write_error |= fclose(output) != 0;
+  }
+
+  StageTimes total_times(reader_times);
+  total_times.Add(writer_times);
+  for (vector<StageTimes>::const_iterator it = worker_times.begin();
+       it != worker_times.end(); ++it) {
+    total_times.Add(*it);
+  }
+  fprintf(stderr, "%lld records, %lld bytes, %d threads, %.3f s\n",
+          static_cast<long long>(records), static_cast<long long>(bytes_read),
+          options.threads, seconds);
+  if (seconds > 0) {
+    fprintf(stderr, "%.0f records/s, %.2f MB/s\n", records / seconds,
+            bytes_read / seconds / (1 << 20));
+  }
+  fprintf(stderr, "stage     thread time (s)  per record (ns)\n");
+  for (int i = 0; i < NUM_STAGES; ++i) {
+    const double stage_seconds =
+        std::chrono::duration<double>(total_times.durations[i]).count();
+    fprintf(stderr, "%-9s %15.3f %16.0f\n", kStageNames[i], stage_seconds,
+            records > 0 ? stage_seconds * 1e9 / records : 0);
+  }
+  if (!read_ok) {
+    fprintf(stderr, "failed to read %s\n", options.input_path.c_str());
+  }
+  if (write_error) {
+    fprintf(stderr, "failed to write %s\n", options.output_path.c_str());
+  }
+  return read_ok && !write_error ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace phonenumbers
+}  // namespace i18n
+
+int main(int argc, const char* argv[]) {
+  return i18n::phonenumbers::Main(argc, argv);
+}
@@ -0,0 +1,284 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Writes a corpus of random valid phone numbers to the standard output, one
+// number per line, for load tests and benchmarks. The numbers cycle through
+// the requested regions and types, e.g. for a million Swiss and German mobile
+// numbers written the way people write them:
+//
+//   phonenumber_generate --regions=CH,DE --types=MOBILE --count=1000000
+//       --format=messy --with_region
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/phonenumberutil.h"
+#include "phonenumbers/stringutil.h"
+#include "phonenumber_generator.h"
+
+namespace i18n {
+namespace phonenumbers {
+namespace {
+
+using std::pair;
+using std::set;
+using std::vector;
+
+// The output is written in blocks of about this size.
+const size_t kOutputBlockSize = 1 << 20;
+
+// The number of times a number is generated again when the generator runs out
+// of tries, before giving up.
+const int kMaxAttempts = 100;
+
+const struct {
+  const char* name;
+  PhoneNumberUtil::PhoneNumberType type;
+} kTypeNames[] = {
+  { "FIXED_LINE", PhoneNumberUtil::FIXED_LINE },
+  { "MOBILE", PhoneNumberUtil::MOBILE },
+  { "FIXED_LINE_OR_MOBILE", PhoneNumberUtil::FIXED_LINE_OR_MOBILE },
+  { "TOLL_FREE", PhoneNumberUtil::TOLL_FREE },
+  { "PREMIUM_RATE", PhoneNumberUtil::PREMIUM_RATE },
+  { "SHARED_COST", PhoneNumberUtil::SHARED_COST },
+  { "VOIP", PhoneNumberUtil::VOIP },
+  { "PERSONAL_NUMBER", PhoneNumberUtil::PERSONAL_NUMBER },
+  { "PAGER", PhoneNumberUtil::PAGER },
+  { "UAN", PhoneNumberUtil::UAN },
+  { "VOICEMAIL", PhoneNumberUtil::VOICEMAIL },
+};
+
+enum OutputFormat {
+  E164,
+  INTERNATIONAL,
+  NATIONAL,
+  MESSY,
+};
+
+struct Options {
+  Options()
+      : count(1000),
+        seed(1),
+        format(E164),
+        extension_percentage(0),
+        with_region(false) {}
+
+  // Empty for all the supported regions and types.
+  vector<string> regions;
+  vector<PhoneNumberUtil::PhoneNumberType> types;
+  int64 count;
+  uint64 seed;
+  OutputFormat format;
+  int extension_percentage;
+  bool with_region;
+};
+
+int PrintHelp(const string& message) {
+  fprintf(stderr, "error: %s\n", message.c_str());
+  fprintf(stderr,
+          "usage: phonenumber_generate [--regions=CH,DE] [--types=MOBILE,...]\n"
+          "    [--count=1000] [--seed=1]\n"
+          "    [--format=e164|international|national|messy]\n"
+          "    [--extension_percentage=0] [--with_region]\n"
+          "Without --regions or --types, all the supported regions and types "
+          "are used.\n"
+          "With --with_region, each line is the number, a tab and its "
+          "region.\n");
+  return 1;
+}
+
+// Parses the decimal integer value into *result, and returns false if value
+// isn't one or is out of [min_value, max_value].
+bool ParseInteger(const string& value, int64 min_value, int64 max_value,
+                  int64* result) {
+  if (value.empty()) {
+    return false;
+  }
+  char* end;
+  *result = strtoll(value.c_str(), &end, 10);
+  return *end == '\0' && *result >= min_value && *result <= max_value;
+}
+
+const char* GetTypeName(PhoneNumberUtil::PhoneNumberType type) {
+  for (size_t i = 0; i < sizeof(kTypeNames) / sizeof(kTypeNames[0]); ++i) {
+    if (type == kTypeNames[i].type) {
+      return kTypeNames[i].name;
+    }
+  }
+  return "UNKNOWN";
+}
+
+bool ParseType(const string& name, PhoneNumberUtil::PhoneNumberType* type) {
+  for (size_t i = 0; i < sizeof(kTypeNames) / sizeof(kTypeNames[0]); ++i) {
+    if (name == kTypeNames[i].name) {
+      *type = kTypeNames[i].type;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns an empty string if the options are valid, or the error otherwise.
+string ParseOptions(int argc, const char* argv[], Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    const string argument(argv[i]);
+    const size_t equals = argument.find('=');
+    const string name = argument.substr(0, equals);
+    const string value =
+        equals == string::npos ? "" : argument.substr(equals + 1);
+    int64 integer;
+    if (name == "--regions") {
+      SplitStringUsing(value, ',', &options->regions);
+    } else if (name == "--types") {
+      vector<string> type_names;
+      SplitStringUsing(value, ',', &type_names);
+      for (vector<string>::const_iterator it = type_names.begin();
+           it != type_names.end(); ++it) {
+        PhoneNumberUtil::PhoneNumberType type;
+        if (!ParseType(*it, &type)) {
+          return "unknown type " + *it;
+        }
+        options->types.push_back(type);
+      }
+    } else if (name == "--count") {
+      if (!ParseInteger(value, 0, kint64max, &options->count)) {
+        return "invalid count " + value;
+      }
+    } else if (name == "--seed") {
+      if (!ParseInteger(value, 0, kint64max, &integer)) {
+        return "invalid seed " + value;
+      }
+      options->seed = integer;
+    } else if (name == "--format") {
+      if (value == "e164") {
+        options->format = E164;
+      } else if (value == "international") {
+        options->format = INTERNATIONAL;
+      } else if (value == "national") {
+        options->format = NATIONAL;
+      } else if (value == "messy") {
+        options->format = MESSY;
+      } else {
+        return "unknown format " + value;
+      }
+    } else if (name == "--extension_percentage") {
+      if (!ParseInteger(value, 0, 100, &integer)) {
+        return "invalid extension percentage " + value;
+      }
+      options->extension_percentage = static_cast<int>(integer);
+    } else if (argument == "--with_region") {
+      options->with_region = true;
+    } else {
+      return "unknown argument " + argument;
+    }
+  }
+  return "";
+}
+
+int Main(int argc, const char* argv[]) {
+  Options options;
+  const string error = ParseOptions(argc, argv, &options);
+  if (!error.empty()) {
+    return PrintHelp(error);
+  }
+  const PhoneNumberUtil& phone_util = *PhoneNumberUtil::GetInstance();
+  if (options.regions.empty()) {
+    set<string> regions;
+    phone_util.GetSupportedRegions(&regions);
+    options.regions.assign(regions.begin(), regions.end());
+  }
+
+  // The numbers cycle through the pairs of a region and a type which have
+  // numbers.
+  PhoneNumberGenerator generator(phone_util, options.seed);
+  generator.set_extension_percentage(options.extension_percentage);
+  PhoneNumber number;
+  vector<pair<string, PhoneNumberUtil::PhoneNumberType> > region_types;
+  for (vector<string>::const_iterator region = options.regions.begin();
+       region != options.regions.end(); ++region) {
+    set<PhoneNumberUtil::PhoneNumberType> types(options.types.begin(),
+                                                options.types.end());
+    if (types.empty()) {
+      phone_util.GetSupportedTypesForRegion(*region, &types);
+    }
+    for (set<PhoneNumberUtil::PhoneNumberType>::const_iterator type =
+             types.begin(); type != types.end(); ++type) {
+      if (generator.Generate(*region, *type, &number)) {
+        region_types.push_back(std::make_pair(*region, *type));
+      }
+    }
+  }
+  if (region_types.empty()) {
+    return PrintHelp("no numbers of the requested regions and types");
+  }
+
+  string output;
+  string formatted;
+  for (int64 i = 0; i < options.count; ++i) {
+    const pair<string, PhoneNumberUtil::PhoneNumberType>& region_type =
+        region_types[i % region_types.size()];
+    // Types with few numbers among the ones matching their pattern may
+    // rarely run out of tries, and are tried again so that exactly --count
+    // numbers are written.
+    int attempts = 1;
+    while (!generator.Generate(region_type.first, region_type.second,
+                               &number)) {
+      if (++attempts > kMaxAttempts) {
+        fprintf(stderr, "error: found no %s number for %s\n",
+                GetTypeName(region_type.second), region_type.first.c_str());
+        return 1;
+      }
+    }
+    switch (options.format) {
+      case E164:
+        phone_util.Format(number, PhoneNumberUtil::E164, &formatted);
+        break;
+      case INTERNATIONAL:
+        phone_util.Format(number, PhoneNumberUtil::INTERNATIONAL, &formatted);
+        break;
+      case NATIONAL:
+        phone_util.Format(number, PhoneNumberUtil::NATIONAL, &formatted);
+        break;
+      case MESSY:
+        generator.FormatMessy(number, region_type.first, &formatted);
+        break;
+    }
+    output.append(formatted);
+    if (options.with_region) {
+      output.push_back('\t');
+      output.append(region_type.first);
+    }
+    output.push_back('\n');
+    if (output.size() >= kOutputBlockSize) {
+      fwrite(output.data(), 1, output.size(), stdout);
+      output.clear();
+    }
+  }
+  fwrite(output.data(), 1, output.size(), stdout);
+  return ferror(stdout) ? 1 : 0;
+}
+
+}  // namespace
+}  // namespace phonenumbers
+}  // namespace i18n
+
+int main(int argc, const char* argv[]) {
+  return i18n::phonenumbers::Main(argc, argv);
+}
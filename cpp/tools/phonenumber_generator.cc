@@ -0,0 +1,459 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "phonenumber_generator.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "phonenumbers/base/logging.h"
+#include "phonenumbers/default_logger.h"
+#include "phonenumbers/phonemetadata.pb.h"
+#include "phonenumbers/phonenumber.h"
+#include "phonenumbers/phonenumber.pb.h"
+#include "phonenumbers/stl_util.h"
+#include "phonenumbers/stringutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using google::protobuf::RepeatedField;
+using std::vector;
+
+namespace {
+
+// The number of numbers sampled from a pattern before giving up on finding one
+// of the requested type and length.
+const int kMaxTries = 1000;
+
+const char kDigits[] = "0123456789";
+
+// Separators written between the digit groups of messy numbers. The empty
+// separator joins the groups.
+const char* const kSeparators[] = { " ", " ", "-", ".", "/", "", " - " };
+
+// The ways of writing extensions which the parser accepts.
+const char* const kExtensionPrefixes[] = {
+  " ext. ", " ext ", " extn. ", " x", " #", ";ext=",
+};
+
+const PhoneNumberDesc* GetNumberDescByType(
+    const PhoneMetadata& metadata,
+    PhoneNumberUtil::PhoneNumberType type) {
+  switch (type) {
+    case PhoneNumberUtil::PREMIUM_RATE:
+      return &metadata.premium_rate();
+    case PhoneNumberUtil::TOLL_FREE:
+      return &metadata.toll_free();
+    case PhoneNumberUtil::MOBILE:
+      return &metadata.mobile();
+    case PhoneNumberUtil::FIXED_LINE:
+    case PhoneNumberUtil::FIXED_LINE_OR_MOBILE:
+      return &metadata.fixed_line();
+    case PhoneNumberUtil::SHARED_COST:
+      return &metadata.shared_cost();
+    case PhoneNumberUtil::VOIP:
+      return &metadata.voip();
+    case PhoneNumberUtil::PERSONAL_NUMBER:
+      return &metadata.personal_number();
+    case PhoneNumberUtil::PAGER:
+      return &metadata.pager();
+    case PhoneNumberUtil::UAN:
+      return &metadata.uan();
+    case PhoneNumberUtil::VOICEMAIL:
+      return &metadata.voicemail();
+    default:
+      return NULL;
+  }
+}
+
+// Returns true if a number of type generated_type was asked for when type was
+// requested.
+bool IsOfRequestedType(PhoneNumberUtil::PhoneNumberType generated_type,
+                       PhoneNumberUtil::PhoneNumberType type) {
+  if (generated_type == type) {
+    return true;
+  }
+  switch (type) {
+    case PhoneNumberUtil::FIXED_LINE:
+    case PhoneNumberUtil::MOBILE:
+      return generated_type == PhoneNumberUtil::FIXED_LINE_OR_MOBILE;
+    case PhoneNumberUtil::FIXED_LINE_OR_MOBILE:
+      return generated_type == PhoneNumberUtil::FIXED_LINE ||
+             generated_type == PhoneNumberUtil::MOBILE;
+    default:
+      return false;
+  }
+}
+
+bool IsAsciiDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+// Appends the full-width form of the ASCII digit c, U+FF10 to U+FF19.
+void AppendFullWidthDigit(char c, string* output) {
+  output->append("\xEF\xBC");
+  output->push_back(static_cast<char>(0x90 + (c - '0')));
+}
+
+}  // namespace
+
+// A national number pattern, parsed to sample the digit strings it matches.
+// Only the syntax of the metadata patterns is supported: digits, \d,
+// character classes of digits and ranges of digits, groups, alternations, and
+// the ?, {n} and {n,m} quantifiers.
+class PhoneNumberGenerator::DigitPattern {
+ public:
+  // Returns NULL if pattern isn't made of the syntax above.
+  static const DigitPattern* Compile(const string& pattern) {
+    DigitPattern* digit_pattern = new DigitPattern();
+    size_t position = 0;
+    if (!ParseAlternatives(pattern, &position, &digit_pattern->alternatives_) ||
+        position != pattern.size()) {
+      delete digit_pattern;
+      return NULL;
+    }
+    return digit_pattern;
+  }
+
+  // Replaces digits with a random string matching the pattern.
+  void Sample(PhoneNumberGenerator* generator, string* digits) const {
+    digits->clear();
+    SampleAlternatives(alternatives_, generator, digits);
+  }
+
+ private:
+  // An element of a pattern, with its quantifier.
+  struct Node {
+    Node() : min_count(1), max_count(1) {}
+
+    // The digits matched by a digit or a character class, and empty for a
+    // group.
+    string digits;
+    // The alternatives of a group, each made of a sequence of nodes.
+    vector<vector<Node> > alternatives;
+    int min_count;
+    int max_count;
+  };
+
+  DigitPattern() {}
+
+  // Parses the alternatives starting at position, up to the end of the
+  // pattern or the closing parenthesis of the group they're in.
+  static bool ParseAlternatives(const string& pattern, size_t* position,
+                                vector<vector<Node> >* alternatives) {
+    alternatives->push_back(vector<Node>());
+    while (*position < pattern.size() && pattern[*position] != ')') {
+      if (pattern[*position] == '|') {
+        alternatives->push_back(vector<Node>());
+        ++*position;
+        continue;
+      }
+      Node node;
+      if (!ParseAtom(pattern, position, &node) ||
+          !ParseQuantifier(pattern, position, &node)) {
+        return false;
+      }
+      alternatives->back().push_back(std::move(node));
+    }
+    return true;
+  }
+
+  static bool ParseAtom(const string& pattern, size_t* position, Node* node) {
+    const char c = pattern[*position];
+    if (IsAsciiDigit(c)) {
+      node->digits.assign(1, c);
+      ++*position;
+      return true;
+    }
+    if (pattern.compare(*position, 2, "\\d") == 0) {
+      node->digits = kDigits;
+      *position += 2;
+      return true;
+    }
+    if (c == '[') {
+      ++*position;
+      while (*position < pattern.size() && pattern[*position] != ']') {
+        if (pattern.compare(*position, 2, "\\d") == 0) {
+          node->digits.append(kDigits);
+          *position += 2;
+          continue;
+        }
+        const char first = pattern[*position];
+        if (!IsAsciiDigit(first)) {
+          return false;
+        }
+        if (*position + 2 < pattern.size() &&
+            pattern[*position + 1] == '-' &&
+            IsAsciiDigit(pattern[*position + 2])) {
+          for (char digit = first; digit <= pattern[*position + 2]; ++digit) {
+            node->digits.push_back(digit);
+          }
+          *position += 3;
+        } else {
+          node->digits.push_back(first);
+          ++*position;
+        }
+      }
+      if (*position == pattern.size() || node->digits.empty()) {
+        return false;
+      }
+      ++*position;
+      return true;
+    }
+    if (c == '(') {
+      ++*position;
+      if (pattern.compare(*position, 2, "?:") == 0) {
+        *position += 2;
+      }
+      if (!ParseAlternatives(pattern, position, &node->alternatives) ||
+          *position == pattern.size()) {
+        return false;
+      }
+      ++*position;
+      return true;
+    }
+    return false;
+  }
+
+  // Parses the quantifier at position, if any. Unbounded quantifiers aren't
+  // supported.
+  static bool ParseQuantifier(const string& pattern, size_t* position,
+                              Node* node) {
+    if (*position == pattern.size()) {
+      return true;
+    }
+    if (pattern[*position] == '?') {
+      node->min_count = 0;
+      ++*position;
+      return true;
+    }
+    if (pattern[*position] != '{') {
+      return true;
+    }
+    const size_t end = pattern.find('}', *position);
+    if (end == string::npos) {
+      return false;
+    }
+    const string bounds = pattern.substr(*position + 1, end - *position - 1);
+    const size_t comma = bounds.find(',');
+    if (bounds.empty() ||
+        bounds.find_first_not_of("0123456789,") != string::npos ||
+        comma == 0 || comma == bounds.size() - 1) {
+      return false;
+    }
+    safe_strto32(bounds.substr(0, comma), &node->min_count);
+    if (comma == string::npos) {
+      node->max_count = node->min_count;
+    } else {
+      safe_strto32(bounds.substr(comma + 1), &node->max_count);
+    }
+    *position = end + 1;
+    return node->min_count <= node->max_count;
+  }
+
+  static void SampleAlternatives(const vector<vector<Node> >& alternatives,
+                                 PhoneNumberGenerator* generator,
+                                 string* digits) {
+    const vector<Node>& sequence = alternatives[generator->Uniform(
+        static_cast<int>(alternatives.size()))];
+    for (vector<Node>::const_iterator it = sequence.begin();
+         it != sequence.end(); ++it) {
+      const int count = it->min_count +
+          generator->Uniform(it->max_count - it->min_count + 1);
+      for (int i = 0; i < count; ++i) {
+        if (it->digits.empty()) {
+          SampleAlternatives(it->alternatives, generator, digits);
+        } else {
+          digits->push_back(it->digits[generator->Uniform(
+              static_cast<int>(it->digits.size()))]);
+        }
+      }
+    }
+  }
+
+  vector<vector<Node> > alternatives_;
+};
+
+PhoneNumberGenerator::PhoneNumberGenerator(const PhoneNumberUtil& util,
+                                           uint64 seed)
+    : phone_util_(util),
+      random_state_(seed),
+      extension_percentage_(0) {}
+
+PhoneNumberGenerator::~PhoneNumberGenerator() {
+  gtl::STLDeleteContainerPairSecondPointers(digit_patterns_.begin(),
+                                            digit_patterns_.end());
+}
+
+bool PhoneNumberGenerator::Generate(const string& region_code,
+                                    PhoneNumberUtil::PhoneNumberType type,
+                                    PhoneNumber* number) {
+  DCHECK(number);
+  const PhoneMetadata* const metadata =
+      phone_util_.GetMetadataForRegion(region_code);
+  if (!metadata) {
+    return false;
+  }
+  const PhoneNumberDesc* desc = GetNumberDescByType(*metadata, type);
+  if (!desc || !desc->has_national_number_pattern()) {
+    return false;
+  }
+  // Descriptions with the same possible lengths as the general description
+  // leave them out.
+  const RepeatedField<int>& possible_lengths =
+      desc->possible_length_size() > 0
+          ? desc->possible_length()
+          : metadata->general_desc().possible_length();
+  if (possible_lengths.size() == 0 || possible_lengths.Get(0) == -1) {
+    return false;
+  }
+  const DigitPattern* digit_pattern =
+      GetDigitPattern(desc->national_number_pattern());
+  if (!digit_pattern) {
+    return false;
+  }
+  // The number may also match the pattern of a type taking precedence, e.g.
+  // PREMIUM_RATE over FIXED_LINE, or be invalid, so it's checked like any
+  // other number.
+  string national_number;
+  for (int tries = 0; tries < kMaxTries; ++tries) {
+    digit_pattern->Sample(this, &national_number);
+    if (std::find(possible_lengths.begin(), possible_lengths.end(),
+                  static_cast<int>(national_number.size())) ==
+            possible_lengths.end()) {
+      continue;
+    }
+    number->Clear();
+    number->set_country_code(metadata->country_code());
+    phone_util_.SetItalianLeadingZerosForPhoneNumber(national_number, number);
+    uint64 national_number_as_int;
+    safe_strtou64(national_number, &national_number_as_int);
+    number->set_national_number(national_number_as_int);
+    if (!phone_util_.IsValidNumberForRegion(*number, region_code) ||
+        !IsOfRequestedType(phone_util_.GetNumberType(*number), type)) {
+      continue;
+    }
+    if (Uniform(100) < extension_percentage_) {
+      string extension;
+      for (int i = 1 + Uniform(5); i > 0; --i) {
+        extension.push_back(kDigits[Uniform(10)]);
+      }
+      number->set_extension(extension);
+    }
+    return true;
+  }
+  VLOG(1) << "Found no number of type " << static_cast<int>(type) << " for "
+          << region_code << " in " << kMaxTries << " tries.";
+  return false;
+}
+
+void PhoneNumberGenerator::FormatMessy(const PhoneNumber& number,
+                                       const string& region_code,
+                                       string* formatted) {
+  DCHECK(formatted);
+  static const PhoneNumberUtil::PhoneNumberFormat kFormats[] = {
+    PhoneNumberUtil::NATIONAL, PhoneNumberUtil::INTERNATIONAL,
+    PhoneNumberUtil::E164,
+  };
+  PhoneNumber number_without_extension(number);
+  number_without_extension.clear_extension();
+  const PhoneNumberUtil::PhoneNumberFormat format = kFormats[Uniform(3)];
+  string standard;
+  phone_util_.Format(number_without_extension, format, &standard);
+  if (format == PhoneNumberUtil::NATIONAL) {
+    PhoneNumber parsed_number;
+    if (phone_util_.Parse(standard, region_code, &parsed_number) !=
+            PhoneNumberUtil::NO_PARSING_ERROR ||
+        !ExactlySameAs(parsed_number, number_without_extension)) {
+      phone_util_.Format(number_without_extension,
+                         PhoneNumberUtil::INTERNATIONAL, &standard);
+    }
+  }
+
+  // The digit groups of the standard format are kept, and each separator
+  // between them is either kept or replaced.
+  const bool full_width = Uniform(4) == 0;
+  formatted->clear();
+  size_t position = 0;
+  if (!standard.empty() && standard[0] == '+') {
+    formatted->append(full_width ? "\xEF\xBC\x8B" /* "＋" */ : "+");
+    position = 1;
+  }
+  while (position < standard.size()) {
+    const size_t group_end =
+        std::min(standard.find_first_not_of(kDigits, position),
+                 standard.size());
+    for (; position < group_end; ++position) {
+      if (full_width) {
+        AppendFullWidthDigit(standard[position], formatted);
+      } else {
+        formatted->push_back(standard[position]);
+      }
+    }
+    const size_t separator_end =
+        std::min(standard.find_first_of(kDigits, position), standard.size());
+    if (separator_end == standard.size()) {
+      // Trailing characters aren't digit separators, and are kept.
+      formatted->append(standard, position, string::npos);
+      break;
+    }
+    if (Uniform(2) == 0) {
+      formatted->append(standard, position, separator_end - position);
+    } else {
+      formatted->append(kSeparators[Uniform(
+          sizeof(kSeparators) / sizeof(kSeparators[0]))]);
+    }
+    position = separator_end;
+  }
+
+  if (number.has_extension()) {
+    formatted->append(kExtensionPrefixes[Uniform(
+        sizeof(kExtensionPrefixes) / sizeof(kExtensionPrefixes[0]))]);
+    formatted->append(number.extension());
+  }
+}
+
+int PhoneNumberGenerator::Uniform(int n) {
+  DCHECK_GT(n, 0);
+  // SplitMix64, which is fast and gives the same numbers on every platform
+  // unlike the distributions of <random>.
+  random_state_ += 0x9E3779B97F4A7C15ULL;
+  uint64 z = random_state_;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  return static_cast<int>(z % static_cast<uint64>(n));
+}
+
+const PhoneNumberGenerator::DigitPattern* PhoneNumberGenerator::GetDigitPattern(
+    const string& pattern) {
+  map<string, const DigitPattern*>::const_iterator it =
+      digit_patterns_.find(pattern);
+  if (it != digit_patterns_.end()) {
+    return it->second;
+  }
+  const DigitPattern* digit_pattern = DigitPattern::Compile(pattern);
+  if (!digit_pattern) {
+    LOG(WARNING) << "Unsupported national number pattern: " << pattern;
+  }
+  // Unsupported patterns are kept too, so that they are neither compiled nor
+  // reported again.
+  digit_patterns_.insert(std::make_pair(pattern, digit_pattern));
+  return digit_pattern;
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,113 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generates random valid phone numbers of a region and type, for load tests
+// and benchmarks which need many more numbers than the single example number
+// per type of the metadata. The numbers are sampled from the national number
+// patterns of the metadata, so they are valid but not necessarily in use.
+//
+// The generator isn't part of the library. It is compiled into the tools, tests
+// and benchmarks which use it, and samples the metadata of the PhoneNumberUtil
+// it is given, which also checks the type of the numbers sampled.
+//
+// PhoneNumberGenerator generator(*PhoneNumberUtil::GetInstance(), 42);
+// PhoneNumber number;
+// string formatted;
+// if (generator.Generate("CH", PhoneNumberUtil::MOBILE, &number)) {
+//   generator.FormatMessy(number, "CH", &formatted);  // e.g. "078.123 45 67"
+// }
+
+#ifndef I18N_PHONENUMBERS_TOOLS_PHONENUMBER_GENERATOR_H_
+#define I18N_PHONENUMBERS_TOOLS_PHONENUMBER_GENERATOR_H_
+
+#include <map>
+#include <string>
+
+#include "phonenumbers/base/basictypes.h"
+#include "phonenumbers/phonenumberutil.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::map;
+using std::string;
+
+class PhoneNumber;
+
+// The same seed generates the same sequence of numbers with the same metadata,
+// on every platform.
+//
+// This class isn't thread-safe.
+class PhoneNumberGenerator {
+ public:
+  PhoneNumberGenerator(const PhoneNumberUtil& util, uint64 seed);
+
+  // This type is neither copyable nor movable.
+  PhoneNumberGenerator(const PhoneNumberGenerator&) = delete;
+  PhoneNumberGenerator& operator=(const PhoneNumberGenerator&) = delete;
+
+  ~PhoneNumberGenerator();
+
+  // Sets the percentage of the generated numbers which have an extension of 1
+  // to 5 digits. It is 0 by default.
+  void set_extension_percentage(int extension_percentage) {
+    extension_percentage_ = extension_percentage;
+  }
+
+  // Generates a random number which is valid for region_code and of the given
+  // type. FIXED_LINE and MOBILE numbers may be FIXED_LINE_OR_MOBILE numbers in
+  // the regions where both types share patterns, and either of them is
+  // generated when FIXED_LINE_OR_MOBILE is requested. Returns false if the
+  // region has no numbers of this type, see
+  // PhoneNumberUtil::GetSupportedTypesForRegion(). Types with few numbers
+  // among the ones matching their pattern may also rarely run out of tries, in
+  // which case trying again may find a number.
+  bool Generate(const string& region_code,
+                PhoneNumberUtil::PhoneNumberType type,
+                PhoneNumber* number);
+
+  // Formats number the way people in region_code write numbers: in national,
+  // international or E164 format with random punctuation, sometimes with
+  // full-width digits, and with the extension written in one of the ways the
+  // parser accepts. Parsing the result with region_code gives the number back,
+  // unless the parser doesn't give it back from its E164 format either. The
+  // numbers whose national format doesn't parse back, e.g. because it starts
+  // with the international prefix of the region, aren't written in national
+  // format.
+  void FormatMessy(const PhoneNumber& number, const string& region_code,
+                   string* formatted);
+
+ private:
+  class DigitPattern;
+
+  // Returns a random number in [0, n), n > 0.
+  int Uniform(int n);
+
+  // Returns the compiled national number pattern, compiling it the first time,
+  // or NULL if it uses a regular expression syntax the metadata doesn't use.
+  const DigitPattern* GetDigitPattern(const string& pattern);
+
+  const PhoneNumberUtil& phone_util_;
+  uint64 random_state_;
+  int extension_percentage_;
+
+  // The patterns compiled so far, owned by this generator, and NULL for the
+  // unsupported ones. Regions sharing a pattern share its compiled form.
+  map<string, const DigitPattern*> digit_patterns_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_TOOLS_PHONENUMBER_GENERATOR_H_
@@ -0,0 +1,212 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "record_batches.h"
+
+#include <string.h>
+
+namespace i18n {
+namespace phonenumbers {
+
+size_t FindEndOfRecord(absl::string_view text) {
+  const char* const data = text.data();
+  bool in_quotes = false;
+  size_t position = 0;
+  for (;;) {
+    const void* const newline =
+        memchr(data + position, '\n', text.size() - position);
+    if (!newline) {
+      return string::npos;
+    }
+    const size_t end = static_cast<const char*>(newline) - data;
+    // Each double quote before the newline opens or closes a quoted field, so
+    // that the "" standing for a double quote leaves it open.
+    const void* quote;
+    while ((quote = memchr(data + position, '"', end - position)) != NULL) {
+      in_quotes = !in_quotes;
+      position = static_cast<const char*>(quote) - data + 1;
+    }
+    if (!in_quotes) {
+      return end;
+    }
+    position = end + 1;
+  }
+}
+
+void SplitFields(absl::string_view record, char delimiter,
+                 vector<string>* fields) {
+  fields->clear();
+  fields->push_back(string());
+  bool in_quotes = false;
+  for (size_t i = 0; i < record.size(); ++i) {
+    const char c = record[i];
+    if (c == '"') {
+      if (in_quotes && i + 1 < record.size() && record[i + 1] == '"') {
+        fields->back().push_back('"');
+        ++i;
+      } else {
+        in_quotes = !in_quotes;
+      }
+    } else if (c == delimiter && !in_quotes) {
+      fields->push_back(string());
+    } else {
+      fields->back().push_back(c);
+    }
+  }
+}
+
+void AppendField(const string& value, char delimiter, string* output) {
+  output->push_back(delimiter);
+  if (value.find_first_of(string(1, delimiter) + "\"\r\n") == string::npos) {
+    output->append(value);
+    return;
+  }
+  output->push_back('"');
+  for (string::const_iterator it = value.begin(); it != value.end(); ++it) {
+    if (*it == '"') {
+      output->push_back('"');
+    }
+    output->push_back(*it);
+  }
+  output->push_back('"');
+}
+
+BatchReader::BatchReader(FILE* input, size_t block_size, int batch_size)
+    : input_(input),
+      block_size_(block_size),
+      batch_size_(batch_size),
+      block_(block_size),
+      complete_length_(0),
+      complete_records_(0),
+      end_of_input_(false),
+      error_(false),
+      bytes_read_(0),
+      records_(0) {}
+
+bool BatchReader::Next(string* batch) {
+  batch->clear();
+  for (;;) {
+    // Records spanning several blocks are scanned again from their start once
+    // the next block is read.
+    while (complete_records_ < batch_size_) {
+      const size_t length = FindEndOfRecord(
+          absl::string_view(pending_).substr(complete_length_));
+      if (length == string::npos) {
+        break;
+      }
+      complete_length_ += length + 1;
+      ++complete_records_;
+    }
+    if (complete_records_ == batch_size_ || end_of_input_) {
+      break;
+    }
+    ReadBlock();
+    if (error_) {
+      return false;
+    }
+  }
+  if (end_of_input_ && complete_records_ < batch_size_ &&
+      complete_length_ < pending_.size()) {
+    // The last record may lack its newline, or end in a quoted field which
+    // isn't closed.
+    pending_.push_back('\n');
+    complete_length_ = pending_.size();
+    ++complete_records_;
+  }
+  if (complete_records_ == 0) {
+    return false;
+  }
+  batch->assign(pending_, 0, complete_length_);
+  pending_.erase(0, complete_length_);
+  records_ += complete_records_;
+  complete_length_ = 0;
+  complete_records_ = 0;
+  return true;
+}
+
+void BatchReader::ReadBlock() {
+  const size_t size = fread(&block_[0], 1, block_size_, input_);
+  if (size < block_size_) {
+    error_ = ferror(input_) != 0;
+    end_of_input_ = true;
+  }
+  bytes_read_ += size;
+  pending_.append(&block_[0], size);
+}
+
+BatchQueue::BatchQueue(int max_batches_in_flight)
+    : max_batches_in_flight_(max_batches_in_flight),
+      batches_in_flight_(0),
+      next_sequence_to_write_(0),
+      closed_(false) {}
+
+void BatchQueue::PushInput(Batch* batch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  slot_available_.wait(lock, [this] {
+    return batches_in_flight_ < max_batches_in_flight_;
+  });
+  ++batches_in_flight_;
+  input_.push_back(batch);
+  input_available_.notify_one();
+}
+
+void BatchQueue::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = true;
+  input_available_.notify_all();
+  output_available_.notify_all();
+}
+
+Batch* BatchQueue::PopInput() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  input_available_.wait(lock, [this] { return closed_ || !input_.empty(); });
+  if (input_.empty()) {
+    return NULL;
+  }
+  Batch* const batch = input_.front();
+  input_.pop_front();
+  return batch;
+}
+
+void BatchQueue::PushOutput(Batch* batch) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  output_[batch->sequence] = batch;
+  output_available_.notify_one();
+}
+
+Batch* BatchQueue::PopOutput() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  output_available_.wait(lock, [this] {
+    return output_.count(next_sequence_to_write_) > 0 ||
+           (closed_ && batches_in_flight_ == 0);
+  });
+  map<int64, Batch*>::iterator it = output_.find(next_sequence_to_write_);
+  if (it == output_.end()) {
+    return NULL;
+  }
+  Batch* const batch = it->second;
+  output_.erase(it);
+  ++next_sequence_to_write_;
+  return batch;
+}
+
+void BatchQueue::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  --batches_in_flight_;
+  slot_available_.notify_one();
+  output_available_.notify_one();
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
@@ -0,0 +1,152 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Reads the records of a delimited text file in batches, splits them into
+// fields and hands the batches from the reader to the worker threads and back
+// to the writer in input order, for phonenumber_bulk.
+//
+// Records end with a newline, and fields are separated by a delimiter. Like in
+// CSV files, fields between double quotes may contain the delimiter and
+// newlines, and "" stands for a double quote in them.
+
+#ifndef I18N_PHONENUMBERS_TOOLS_RECORD_BATCHES_H_
+#define I18N_PHONENUMBERS_TOOLS_RECORD_BATCHES_H_
+
+#include <stdio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::map;
+using std::string;
+using std::vector;
+
+// Returns the length of the first record of text, up to and excluding the
+// newline ending it, or string::npos if text has no complete record.
+size_t FindEndOfRecord(absl::string_view text);
+
+// Splits record into its fields.
+void SplitFields(absl::string_view record, char delimiter,
+                 vector<string>* fields);
+
+// Appends the delimiter and value to output, quoting value if needed.
+void AppendField(const string& value, char delimiter, string* output);
+
+// Reads the complete records of a file in blocks, and cuts them into batches.
+// The last record doesn't need to end with a newline.
+class BatchReader {
+ public:
+  // The file is read in blocks of block_size bytes, and each batch but the
+  // last one has batch_size records.
+  BatchReader(FILE* input, size_t block_size, int batch_size);
+
+  // This type is neither copyable nor movable.
+  BatchReader(const BatchReader&) = delete;
+  BatchReader& operator=(const BatchReader&) = delete;
+
+  // Replaces batch with the next batch of records, each of them followed by a
+  // newline. Returns false once all of them were read, or on read errors.
+  bool Next(string* batch);
+
+  // Returns true if reading the file failed.
+  bool error() const { return error_; }
+
+  int64 bytes_read() const { return bytes_read_; }
+  int64 records() const { return records_; }
+
+ private:
+  // Reads the next block of the file into pending_.
+  void ReadBlock();
+
+  FILE* const input_;
+  const size_t block_size_;
+  const int batch_size_;
+  vector<char> block_;
+  // The bytes read but not returned yet.
+  string pending_;
+  // The length of the complete records at the start of pending_, and their
+  // number.
+  size_t complete_length_;
+  int complete_records_;
+  bool end_of_input_;
+  bool error_;
+  int64 bytes_read_;
+  int64 records_;
+};
+
+// Complete records of the input, and their output once processed.
+struct Batch {
+  int64 sequence;
+  string input;
+  string output;
+};
+
+// Hands the batches read to the worker threads, and the processed batches to
+// the writer in input order. The number of batches in flight is bounded, so
+// that memory use doesn't depend on the size of the input.
+//
+// This class is thread-safe.
+class BatchQueue {
+ public:
+  explicit BatchQueue(int max_batches_in_flight);
+
+  // This type is neither copyable nor movable.
+  BatchQueue(const BatchQueue&) = delete;
+  BatchQueue& operator=(const BatchQueue&) = delete;
+
+  // Blocks while too many batches are in flight.
+  void PushInput(Batch* batch);
+
+  // Called once all the input has been pushed.
+  void Close();
+
+  // Returns the next batch to process, or NULL once all of them were.
+  Batch* PopInput();
+
+  void PushOutput(Batch* batch);
+
+  // Returns the next batch in input order once it's processed, or NULL once all
+  // of them were returned.
+  Batch* PopOutput();
+
+  // Called once a batch returned by PopOutput() is written.
+  void Release();
+
+ private:
+  const int max_batches_in_flight_;
+  std::mutex mutex_;
+  std::condition_variable slot_available_;
+  std::condition_variable input_available_;
+  std::condition_variable output_available_;
+  int batches_in_flight_;
+  std::deque<Batch*> input_;
+  map<int64, Batch*> output_;
+  int64 next_sequence_to_write_;
+  bool closed_;
+};
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_TOOLS_RECORD_BATCHES_H_
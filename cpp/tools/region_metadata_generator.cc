@@ -0,0 +1,1090 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "region_metadata_generator.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <utility>
+
+#include "phonenumbers/phonemetadata.pb.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::map;
+using std::pair;
+using std::set;
+
+namespace {
+
+const uint16 kAllDigits = (1 << 10) - 1;
+const int kMaxStates = 65535;
+// The international and national prefix patterns match a few prefixes each.
+const size_t kMaxPrefixes = 256;
+// The capturing groups of the formats are expanded to check the order in which
+// they match.
+const size_t kMaxGroupExpansions = 4096;
+// The number types, in the order of RegionPhoneNumberUtil::PhoneNumberType.
+const int kNumTypes = 12;
+
+// A node of the syntax tree of a pattern.
+struct RegexNode {
+  enum Kind {
+    DIGITS,
+    CONCATENATION,
+    ALTERNATION,
+    REPETITION,
+  };
+
+  explicit RegexNode(Kind kind)
+      : kind(kind), digits(0), min(0), max(0), capturing(false) {}
+
+  Kind kind;
+  // The digits matched by a DIGITS node.
+  uint16 digits;
+  vector<RegexNode> children;
+  // The bounds of a REPETITION node, max being -1 if unbounded.
+  int min;
+  int max;
+  // Whether the node is a capturing group.
+  bool capturing;
+};
+
+class RegexParser {
+ public:
+  explicit RegexParser(const string& pattern)
+      : pattern_(pattern), position_(0) {}
+
+  bool Parse(RegexNode* node, string* error) {
+    if (!ParseAlternation(node) || position_ != pattern_.length()) {
+      if (error_.empty()) {
+        error_ = "unexpected character";
+      }
+      char position[16];
+      snprintf(position, sizeof(position), "%d", static_cast<int>(position_));
+      *error = error_ + " at position " + position + " of " + pattern_;
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  bool AtEnd() const {
+    return position_ == pattern_.length();
+  }
+
+  char Peek() const {
+    return AtEnd() ? '\0' : pattern_[position_];
+  }
+
+  bool Fail(const string& error) {
+    error_ = error;
+    return false;
+  }
+
+  bool ParseAlternation(RegexNode* node) {
+    *node = RegexNode(RegexNode::ALTERNATION);
+    for (;;) {
+      node->children.push_back(RegexNode(RegexNode::CONCATENATION));
+      if (!ParseConcatenation(&node->children.back())) {
+        return false;
+      }
+      if (Peek() != '|') {
+        break;
+      }
+      ++position_;
+    }
+    if (node->children.size() == 1) {
+      // Without alternatives, the node is the concatenation itself, so that
+      // the groups of the format patterns are its children.
+      const RegexNode concatenation = node->children.front();
+      *node = concatenation;
+    }
+    return true;
+  }
+
+  bool ParseConcatenation(RegexNode* node) {
+    while (!AtEnd() && Peek() != '|' && Peek() != ')') {
+      node->children.push_back(RegexNode(RegexNode::DIGITS));
+      if (!ParseRepetition(&node->children.back())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool ParseRepetition(RegexNode* node) {
+    if (!ParseAtom(node)) {
+      return false;
+    }
+    for (;;) {
+      int min;
+      int max;
+      if (Peek() == '?') {
+        min = 0;
+        max = 1;
+        ++position_;
+      } else if (Peek() == '*') {
+        min = 0;
+        max = -1;
+        ++position_;
+      } else if (Peek() == '+') {
+        min = 1;
+        max = -1;
+        ++position_;
+      } else if (Peek() == '{') {
+        ++position_;
+        if (!ParseInteger(&min)) {
+          return false;
+        }
+        max = min;
+        if (Peek() == ',') {
+          ++position_;
+          max = -1;
+          if (Peek() != '}' && !ParseInteger(&max)) {
+            return false;
+          }
+        }
+        if (Peek() != '}' || (max != -1 && max < min)) {
+          return Fail("invalid repetition");
+        }
+        ++position_;
+      } else {
+        return true;
+      }
+      if (Peek() == '?' || Peek() == '+') {
+        return Fail("unsupported lazy or possessive quantifier");
+      }
+      RegexNode repetition(RegexNode::REPETITION);
+      repetition.min = min;
+      repetition.max = max;
+      repetition.children.push_back(*node);
+      *node = repetition;
+    }
+  }
+
+  bool ParseInteger(int* value) {
+    if (Peek() < '0' || Peek() > '9') {
+      return Fail("expected a number");
+    }
+    *value = 0;
+    while (Peek() >= '0' && Peek() <= '9') {
+      *value = 10 * *value + (pattern_[position_++] - '0');
+      if (*value > 100) {
+        return Fail("repetition too large");
+      }
+    }
+    return true;
+  }
+
+  bool ParseAtom(RegexNode* node) {
+    const char c = Peek();
+    if (c >= '0' && c <= '9') {
+      *node = RegexNode(RegexNode::DIGITS);
+      node->digits = static_cast<uint16>(1 << (c - '0'));
+      ++position_;
+      return true;
+    }
+    if (c == '\\') {
+      if (pattern_.compare(position_, 2, "\\d") != 0) {
+        return Fail("unsupported escape");
+      }
+      *node = RegexNode(RegexNode::DIGITS);
+      node->digits = kAllDigits;
+      position_ += 2;
+      return true;
+    }
+    if (c == '[') {
+      ++position_;
+      return ParseClass(node);
+    }
+    if (c == '(') {
+      ++position_;
+      const bool capturing = pattern_.compare(position_, 2, "?:") != 0;
+      if (!capturing) {
+        position_ += 2;
+      } else if (Peek() == '?') {
+        return Fail("unsupported group");
+      }
+      if (!ParseAlternation(node)) {
+        return false;
+      }
+      if (Peek() != ')') {
+        return Fail("expected )");
+      }
+      ++position_;
+      if (capturing) {
+        // The group is wrapped so that its contents stay a separate node.
+        RegexNode group(RegexNode::CONCATENATION);
+        group.children.push_back(*node);
+        group.capturing = true;
+        *node = group;
+      }
+      return true;
+    }
+    return Fail("unsupported character");
+  }
+
+  bool ParseClass(RegexNode* node) {
+    *node = RegexNode(RegexNode::DIGITS);
+    const bool negated = Peek() == '^';
+    if (negated) {
+      ++position_;
+    }
+    while (Peek() != ']') {
+      if (pattern_.compare(position_, 2, "\\d") == 0) {
+        node->digits = kAllDigits;
+        position_ += 2;
+        continue;
+      }
+      const char first = Peek();
+      if (first < '0' || first > '9') {
+        return Fail("unsupported character in class");
+      }
+      ++position_;
+      char last = first;
+      if (Peek() == '-') {
+        ++position_;
+        last = Peek();
+        if (last < first || last > '9') {
+          return Fail("invalid range in class");
+        }
+        ++position_;
+      }
+      for (char digit = first; digit <= last; ++digit) {
+        node->digits |= static_cast<uint16>(1 << (digit - '0'));
+      }
+    }
+    ++position_;
+    if (negated) {
+      node->digits = ~node->digits & kAllDigits;
+    }
+    return true;
+  }
+
+  const string pattern_;
+  size_t position_;
+  string error_;
+};
+
+// A nondeterministic automaton with epsilon transitions built from the syntax
+// tree with Thompson's construction.
+class Nfa {
+ public:
+  struct State {
+    vector<pair<uint16, int> > transitions;
+    vector<int> epsilons;
+  };
+
+  explicit Nfa(const RegexNode& node) {
+    AddState();
+    AddState();
+    Build(node, kStart, kAccepting);
+  }
+
+  enum {
+    kStart = 0,
+    kAccepting = 1,
+  };
+
+  const vector<State>& states() const {
+    return states_;
+  }
+
+  // Adds to states the states reachable from them with epsilon transitions.
+  void Close(set<int>* states) const {
+    vector<int> pending(states->begin(), states->end());
+    while (!pending.empty()) {
+      const int state = pending.back();
+      pending.pop_back();
+      for (int next : states_[state].epsilons) {
+        if (states->insert(next).second) {
+          pending.push_back(next);
+        }
+      }
+    }
+  }
+
+ private:
+  int AddState() {
+    states_.push_back(State());
+    return static_cast<int>(states_.size()) - 1;
+  }
+
+  // Adds the paths from from to to matching node, through new states only.
+  void Build(const RegexNode& node, int from, int to) {
+    switch (node.kind) {
+      case RegexNode::DIGITS:
+        states_[from].transitions.push_back(std::make_pair(node.digits, to));
+        break;
+      case RegexNode::CONCATENATION: {
+        int current = from;
+        for (size_t i = 0; i < node.children.size(); ++i) {
+          const int next =
+              i + 1 == node.children.size() ? to : AddState();
+          Build(node.children[i], current, next);
+          current = next;
+        }
+        if (node.children.empty()) {
+          states_[from].epsilons.push_back(to);
+        }
+        break;
+      }
+      case RegexNode::ALTERNATION:
+        for (const RegexNode& child : node.children) {
+          Build(child, from, to);
+        }
+        break;
+      case RegexNode::REPETITION: {
+        const RegexNode& child = node.children.front();
+        int current = from;
+        for (int i = 0; i < node.min; ++i) {
+          const int next = i + 1 == node.min && node.max == node.min
+              ? to : AddState();
+          Build(child, current, next);
+          current = next;
+        }
+        if (node.max == -1) {
+          const int loop = AddState();
+          states_[current].epsilons.push_back(loop);
+          Build(child, loop, loop);
+          states_[loop].epsilons.push_back(to);
+        } else if (node.max > node.min) {
+          for (int i = node.min; i < node.max; ++i) {
+            states_[current].epsilons.push_back(to);
+            const int next = i + 1 == node.max ? to : AddState();
+            Build(child, current, next);
+            current = next;
+          }
+        } else if (node.min == 0) {
+          states_[from].epsilons.push_back(to);
+        }
+        break;
+      }
+    }
+  }
+
+  vector<State> states_;
+};
+
+// Compiles node with the subset construction and minimizes the result.
+bool CompileNode(const RegexNode& node, vector<uint16>* transitions,
+                 vector<uint8>* accepting, string* error) {
+  const Nfa nfa(node);
+  // The sets of states of the nondeterministic automaton, the empty one first.
+  vector<set<int> > subsets(1);
+  map<set<int>, int> subset_ids;
+  subset_ids[subsets[0]] = 0;
+  set<int> start;
+  start.insert(Nfa::kStart);
+  nfa.Close(&start);
+  subset_ids[start] = 1;
+  subsets.push_back(start);
+  vector<int> dfa;
+  for (size_t id = 0; id < subsets.size(); ++id) {
+    for (int digit = 0; digit < 10; ++digit) {
+      set<int> next;
+      for (int state : subsets[id]) {
+        for (const pair<uint16, int>& transition :
+             nfa.states()[state].transitions) {
+          if ((transition.first >> digit) & 1) {
+            next.insert(transition.second);
+          }
+        }
+      }
+      nfa.Close(&next);
+      map<set<int>, int>::const_iterator it = subset_ids.find(next);
+      if (it == subset_ids.end()) {
+        if (subsets.size() > 4 * kMaxStates) {
+          *error = "too many states";
+          return false;
+        }
+        it = subset_ids.insert(
+            std::make_pair(next, static_cast<int>(subsets.size()))).first;
+        subsets.push_back(next);
+      }
+      dfa.push_back(it->second);
+    }
+  }
+
+  // Moore's algorithm: the states are split according to the classes of their
+  // successors until no class is split anymore.
+  const size_t num_states = subsets.size();
+  vector<int> classes(num_states);
+  for (size_t state = 0; state < num_states; ++state) {
+    classes[state] = subsets[state].count(Nfa::kAccepting);
+  }
+  size_t num_classes = 0;
+  for (;;) {
+    map<vector<int>, int> signatures;
+    vector<int> next_classes(num_states);
+    for (size_t state = 0; state < num_states; ++state) {
+      vector<int> signature(1, classes[state]);
+      for (int digit = 0; digit < 10; ++digit) {
+        signature.push_back(classes[dfa[10 * state + digit]]);
+      }
+      next_classes[state] = signatures.insert(
+          std::make_pair(signature, static_cast<int>(signatures.size())))
+          .first->second;
+    }
+    classes.swap(next_classes);
+    if (signatures.size() == num_classes) {
+      break;
+    }
+    num_classes = signatures.size();
+  }
+  if (num_classes > static_cast<size_t>(kMaxStates)) {
+    *error = "too many states";
+    return false;
+  }
+
+  // The classes are numbered in breadth-first order from the initial state,
+  // after the class of the empty set which rejects everything.
+  vector<int> representatives(num_classes, -1);
+  for (size_t state = num_states; state-- > 0;) {
+    representatives[classes[state]] = static_cast<int>(state);
+  }
+  vector<int> numbers(num_classes, -1);
+  vector<int> order;
+  numbers[classes[0]] = 0;
+  order.push_back(classes[0]);
+  if (numbers[classes[1]] == -1) {
+    numbers[classes[1]] = 1;
+    order.push_back(classes[1]);
+  }
+  for (size_t i = 0; i < order.size(); ++i) {
+    const int state = representatives[order[i]];
+    for (int digit = 0; digit < 10; ++digit) {
+      const int next_class = classes[dfa[10 * state + digit]];
+      if (numbers[next_class] == -1) {
+        numbers[next_class] = static_cast<int>(order.size());
+        order.push_back(next_class);
+      }
+    }
+  }
+  transitions->clear();
+  accepting->clear();
+  for (size_t i = 0; i < order.size(); ++i) {
+    const int state = representatives[order[i]];
+    for (int digit = 0; digit < 10; ++digit) {
+      transitions->push_back(
+          static_cast<uint16>(numbers[classes[dfa[10 * state + digit]]]));
+    }
+    accepting->push_back(subsets[state].count(Nfa::kAccepting) ? 1 : 0);
+  }
+  if (order.size() == 1) {
+    // The initial state rejects everything, but must exist.
+    transitions->insert(transitions->end(), 10, 0);
+    accepting->push_back(0);
+  }
+  return true;
+}
+
+typedef vector<vector<uint16> > Expansion;
+
+// Appends to result the concatenations of the sequences of first and second,
+// in order.
+bool Concatenate(const Expansion& first, const Expansion& second,
+                 size_t max_size, Expansion* result) {
+  if (first.size() * second.size() > max_size) {
+    return false;
+  }
+  for (const vector<uint16>& prefix : first) {
+    for (const vector<uint16>& suffix : second) {
+      result->push_back(prefix);
+      result->back().insert(result->back().end(), suffix.begin(),
+                            suffix.end());
+    }
+  }
+  return true;
+}
+
+// Expands the greedy repetition of child at most count times.
+bool ExpandOptionalRepetition(const Expansion& child, int count,
+                              size_t max_size, Expansion* result) {
+  result->clear();
+  if (count > 0) {
+    Expansion rest;
+    if (!ExpandOptionalRepetition(child, count - 1, max_size, &rest) ||
+        !Concatenate(child, rest, max_size, result)) {
+      return false;
+    }
+  }
+  result->push_back(vector<uint16>());
+  return result->size() <= max_size;
+}
+
+// Expands node into the sequences of digit sets it matches, in the order they
+// are tried by a backtracking engine: the alternatives from left to right, and
+// the repetitions from the longest.
+bool Expand(const RegexNode& node, size_t max_size, Expansion* result) {
+  result->clear();
+  switch (node.kind) {
+    case RegexNode::DIGITS:
+      result->push_back(vector<uint16>(1, node.digits));
+      return true;
+    case RegexNode::CONCATENATION: {
+      result->push_back(vector<uint16>());
+      for (const RegexNode& child : node.children) {
+        Expansion child_expansion;
+        Expansion concatenation;
+        if (!Expand(child, max_size, &child_expansion) ||
+            !Concatenate(*result, child_expansion, max_size, &concatenation)) {
+          return false;
+        }
+        result->swap(concatenation);
+      }
+      return true;
+    }
+    case RegexNode::ALTERNATION:
+      for (const RegexNode& child : node.children) {
+        Expansion child_expansion;
+        if (!Expand(child, max_size, &child_expansion)) {
+          return false;
+        }
+        result->insert(result->end(), child_expansion.begin(),
+                       child_expansion.end());
+        if (result->size() > max_size) {
+          return false;
+        }
+      }
+      return true;
+    case RegexNode::REPETITION: {
+      if (node.max == -1) {
+        return false;
+      }
+      Expansion child;
+      if (!Expand(node.children.front(), max_size, &child)) {
+        return false;
+      }
+      result->push_back(vector<uint16>());
+      for (int i = 0; i < node.min; ++i) {
+        Expansion concatenation;
+        if (!Concatenate(*result, child, max_size, &concatenation)) {
+          return false;
+        }
+        result->swap(concatenation);
+      }
+      Expansion optional;
+      Expansion concatenation;
+      if (!ExpandOptionalRepetition(child, node.max - node.min, max_size,
+                                    &optional) ||
+          !Concatenate(*result, optional, max_size, &concatenation)) {
+        return false;
+      }
+      result->swap(concatenation);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns whether the strings matched by the group are tried from the longest
+// by a backtracking engine, and whether, for any input, the lengths of the
+// prefixes of the input it matches are consecutive. Splitting a number into
+// the groups by trying the longest match of each group first then gives the
+// same result as the engine.
+bool IsGreedyGroup(const RegexNode& group, string* error) {
+  Expansion expansion;
+  if (!Expand(group, kMaxGroupExpansions, &expansion)) {
+    *error = "unbounded or too large group";
+    return false;
+  }
+  for (size_t i = 1; i < expansion.size(); ++i) {
+    if (expansion[i].size() > expansion[i - 1].size()) {
+      *error = "group not matching its longest strings first";
+      return false;
+    }
+  }
+  vector<uint16> transitions;
+  vector<uint8> accepting;
+  if (!CompileNode(group, &transitions, &accepting, error)) {
+    return false;
+  }
+  // Searches for a path from an accepting state through a rejecting state to
+  // an accepting state.
+  const size_t num_states = accepting.size();
+  vector<bool> visited(num_states, false);
+  vector<int> pending;
+  for (size_t state = 1; state < num_states; ++state) {
+    if (accepting[state]) {
+      for (int digit = 0; digit < 10; ++digit) {
+        const int next = transitions[10 * state + digit];
+        if (next != 0 && !accepting[next] && !visited[next]) {
+          visited[next] = true;
+          pending.push_back(next);
+        }
+      }
+    }
+  }
+  while (!pending.empty()) {
+    const int state = pending.back();
+    pending.pop_back();
+    for (int digit = 0; digit < 10; ++digit) {
+      const int next = transitions[10 * state + digit];
+      if (accepting[next]) {
+        *error = "group matching lengths which aren't consecutive";
+        return false;
+      }
+      if (next != 0 && !visited[next]) {
+        visited[next] = true;
+        pending.push_back(next);
+      }
+    }
+  }
+  return true;
+}
+
+// The C++ code generated for a region.
+class RegionWriter {
+ public:
+  RegionWriter(const PhoneMetadata& metadata, const string& table_namespace)
+      : metadata_(metadata), table_namespace_(table_namespace) {}
+
+  bool Write(const vector<int>& country_codes, string* output,
+             string* error) {
+    string country_codes_table;
+    AppendNumbers(country_codes, &country_codes_table);
+    tables_ += "inline constexpr int kCountryCodes[] = {\n" +
+               country_codes_table + "};\n";
+
+    string international_prefixes;
+    string national_prefixes;
+    int num_international_prefixes;
+    int num_national_prefixes;
+    if (!WritePrefixes(metadata_.international_prefix(), "International",
+                       &international_prefixes, &num_international_prefixes,
+                       error) ||
+        !WritePrefixes(metadata_.national_prefix_for_parsing(), "National",
+                       &national_prefixes, &num_national_prefixes, error)) {
+      return false;
+    }
+
+    const PhoneNumberDesc* descs[kNumTypes] = {
+      &metadata_.fixed_line(), &metadata_.mobile(), &metadata_.fixed_line(),
+      &metadata_.toll_free(), &metadata_.premium_rate(),
+      &metadata_.shared_cost(), &metadata_.voip(),
+      &metadata_.personal_number(), &metadata_.pager(), &metadata_.uan(),
+      &metadata_.voicemail(), &metadata_.general_desc(),
+    };
+    string possible_lengths;
+    string local_only_lengths;
+    string patterns;
+    uint32 types_without_numbers = 0;
+    for (int type = 0; type < kNumTypes; ++type) {
+      const PhoneNumberDesc& desc = *descs[type];
+      AppendNumber(LengthMask(desc.possible_length()), "u", &possible_lengths);
+      AppendNumber(LengthMask(desc.possible_length_local_only()), "u",
+                   &local_only_lengths);
+      if (desc.possible_length_size() == 1 && desc.possible_length(0) == -1) {
+        types_without_numbers |= 1 << type;
+      }
+      string automaton;
+      if (!WriteAutomaton(desc.national_number_pattern(), &automaton, error)) {
+        return false;
+      }
+      patterns += "    " + automaton + ",\n";
+    }
+
+    string national_formats;
+    string international_formats;
+    int num_national_formats;
+    int num_international_formats;
+    if (!WriteFormats(metadata_.number_format(), true, "National",
+                      &national_formats, &num_national_formats, error) ||
+        !WriteFormats(metadata_.intl_number_format_size() > 0
+                          ? metadata_.intl_number_format()
+                          : metadata_.number_format(),
+                      false, "International", &international_formats,
+                      &num_international_formats, error)) {
+      return false;
+    }
+
+    const string& region_code = metadata_.id();
+    output->append("namespace " + table_namespace_ + " {\n\n" + tables_ +
+                   "\n}  // namespace " + table_namespace_ + "\n\n");
+    output->append("inline constexpr RegionMetadata kRegionMetadata" +
+                   region_code + " = {\n");
+    output->append("  \"" + region_code + "\",\n");
+    output->append("  " + std::to_string(metadata_.country_code()) + ",\n");
+    output->append("  " + table_namespace_ + "::kCountryCodes, " +
+                   std::to_string(country_codes.size()) + ",\n");
+    output->append("  " + international_prefixes + ", " +
+                   std::to_string(num_international_prefixes) + ",\n");
+    output->append("  " + national_prefixes + ", " +
+                   std::to_string(num_national_prefixes) + ",\n");
+    output->append("  {\n" + possible_lengths + "  },\n");
+    output->append("  {\n" + local_only_lengths + "  },\n");
+    output->append("  {\n" + patterns + "  },\n");
+    output->append("  " + std::to_string(types_without_numbers) + "u,\n");
+    output->append(metadata_.same_mobile_and_fixed_line_pattern()
+                       ? "  true,\n" : "  false,\n");
+    output->append("  " + national_formats + ", " +
+                   std::to_string(num_national_formats) + ",\n");
+    output->append("  " + international_formats + ", " +
+                   std::to_string(num_international_formats) + ",\n");
+    output->append("};\n\n");
+    output->append("typedef RegionPhoneNumberUtil<kRegionMetadata" +
+                   region_code + "> RegionPhoneNumberUtil" + region_code +
+                   ";\n\n");
+    return true;
+  }
+
+ private:
+  static uint32 LengthMask(
+      const google::protobuf::RepeatedField<int>& lengths) {
+    uint32 mask = 0;
+    for (int length : lengths) {
+      if (length >= 0 && length < 32) {
+        mask |= uint32{1} << length;
+      }
+    }
+    return mask;
+  }
+
+  // Appends numbers to output, wrapping the lines at 80 columns, or after
+  // numbers_per_line numbers if not 0.
+  template <typename T>
+  static void AppendNumbers(const vector<T>& numbers, string* output,
+                            size_t numbers_per_line = 0) {
+    string line = " ";
+    for (size_t i = 0; i < numbers.size(); ++i) {
+      const string item = " " + std::to_string(numbers[i]) + ",";
+      if (numbers_per_line != 0 ? i > 0 && i % numbers_per_line == 0
+                                : line.length() + item.length() > 80) {
+        output->append(line + "\n");
+        line = " ";
+      }
+      line += item;
+    }
+    if (line.length() > 1) {
+      output->append(line + "\n");
+    }
+  }
+
+  static void AppendNumber(uint32 number, const string& suffix,
+                           string* output) {
+    output->append("    " + std::to_string(number) + suffix + ",\n");
+  }
+
+  static string Quote(const string& value) {
+    string quoted = "\"";
+    for (char c : value) {
+      if (c == '"' || c == '\\') {
+        quoted.push_back('\\');
+      }
+      quoted.push_back(c);
+    }
+    return quoted + "\"";
+  }
+
+  // Sets automaton to the DigitAutomaton initializer of pattern, sharing the
+  // tables of the patterns already written.
+  bool WriteAutomaton(const string& pattern, string* automaton,
+                      string* error) {
+    if (pattern.empty()) {
+      *automaton = "{ NULL, NULL }";
+      return true;
+    }
+    map<string, string>::const_iterator it = automata_.find(pattern);
+    if (it == automata_.end()) {
+      RegexNode node(RegexNode::DIGITS);
+      vector<uint16> transitions;
+      vector<uint8> accepting;
+      if (!RegexParser(pattern).Parse(&node, error) ||
+          !CompileNode(node, &transitions, &accepting, error)) {
+        *error += " in " + pattern;
+        return false;
+      }
+      const string name =
+          "kAutomaton" + std::to_string(automata_.size());
+      tables_ += "inline constexpr uint16 " + name + "Transitions[] = {\n";
+      // The transitions of each state are on a line of their own.
+      AppendNumbers(transitions, &tables_, 10);
+      tables_ += "};\ninline constexpr uint8 " + name + "Accepting[] = {\n";
+      AppendNumbers(accepting, &tables_);
+      tables_ += "};\n";
+      it = automata_.insert(std::make_pair(
+          pattern, "{ " + table_namespace_ + "::" + name + "Transitions, " +
+                   table_namespace_ + "::" + name + "Accepting }")).first;
+    }
+    *automaton = it->second;
+    return true;
+  }
+
+  // Sets table to the name of the table of the prefixes matched by pattern,
+  // or to NULL if there is none.
+  bool WritePrefixes(const string& pattern, const string& name, string* table,
+                     int* num_prefixes, string* error) {
+    *num_prefixes = 0;
+    if (pattern.empty()) {
+      *table = "NULL";
+      return true;
+    }
+    vector<vector<uint16> > prefixes;
+    if (!ExpandDigitPrefixes(pattern, &prefixes, error)) {
+      return false;
+    }
+    string entries;
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      const string digits =
+          "k" + name + "Prefix" + std::to_string(i) + "Digits";
+      tables_ += "inline constexpr uint16 " + digits + "[] = {";
+      for (size_t j = 0; j < prefixes[i].size(); ++j) {
+        tables_ += (j == 0 ? " " : ", ") + std::to_string(prefixes[i][j]);
+      }
+      // Arrays can't be empty.
+      tables_ += prefixes[i].empty() ? " 0 };\n" : " };\n";
+      entries += "  { " + digits + ", " + std::to_string(prefixes[i].size()) +
+                 " },\n";
+    }
+    tables_ += "inline constexpr DigitPrefix k" + name + "Prefixes[] = {\n" +
+               entries + "};\n";
+    *table = table_namespace_ + "::k" + name + "Prefixes";
+    *num_prefixes = static_cast<int>(prefixes.size());
+    return true;
+  }
+
+  // Sets format_rule to the format of number_format, the national prefix
+  // formatting rule applied for national formats as
+  // PhoneNumberUtil::FormatNsnUsingPatternWithCarrier() does.
+  static bool GetFormatRule(const NumberFormat& number_format, bool national,
+                            int num_groups, string* format_rule,
+                            string* error) {
+    *format_rule = number_format.format();
+    const string& national_prefix_formatting_rule =
+        number_format.national_prefix_formatting_rule();
+    if (national && !national_prefix_formatting_rule.empty()) {
+      size_t first_group = 0;
+      while (first_group + 1 < format_rule->length() &&
+             !((*format_rule)[first_group] == '$' &&
+               (*format_rule)[first_group + 1] >= '0' &&
+               (*format_rule)[first_group + 1] <= '9')) {
+        ++first_group;
+      }
+      if (first_group + 1 < format_rule->length()) {
+        const string group_reference = format_rule->substr(first_group, 2);
+        string replacement;
+        for (size_t i = 0; i < national_prefix_formatting_rule.length(); ++i) {
+          if (national_prefix_formatting_rule.compare(i, 2, "$1") == 0) {
+            replacement += group_reference;
+            ++i;
+          } else {
+            replacement.push_back(national_prefix_formatting_rule[i]);
+          }
+        }
+        format_rule->replace(first_group, 2, replacement);
+      }
+    }
+    for (size_t i = 0; i < format_rule->length(); ++i) {
+      const char c = (*format_rule)[i];
+      if (c == '\\' ||
+          (c == '$' && (i + 1 == format_rule->length() ||
+                        (*format_rule)[i + 1] < '1' ||
+                        (*format_rule)[i + 1] > '0' + num_groups))) {
+        *error = "unsupported format " + *format_rule;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool WriteFormats(
+      const google::protobuf::RepeatedPtrField<NumberFormat>& number_formats,
+      bool national, const string& name, string* table, int* num_formats,
+      string* error) {
+    *num_formats = number_formats.size();
+    if (number_formats.empty()) {
+      *table = "NULL";
+      return true;
+    }
+    string entries;
+    for (int i = 0; i < number_formats.size(); ++i) {
+      const NumberFormat& number_format = number_formats.Get(i);
+      RegexNode node(RegexNode::DIGITS);
+      if (!RegexParser(number_format.pattern()).Parse(&node, error)) {
+        return false;
+      }
+      // The pattern must be a concatenation of capturing groups.
+      vector<RegexNode> groups;
+      if (node.capturing) {
+        groups.push_back(node);
+      } else if (node.kind == RegexNode::CONCATENATION) {
+        groups = node.children;
+      }
+      if (groups.empty() || groups.size() > 9) {
+        *error = "unsupported format pattern " + number_format.pattern();
+        return false;
+      }
+      string group_automata;
+      for (size_t j = 0; j < groups.size(); ++j) {
+        if (!groups[j].capturing || !IsGreedyGroup(groups[j], error)) {
+          *error = "unsupported format pattern " + number_format.pattern() +
+                   (error->empty() ? "" : ": " + *error);
+          return false;
+        }
+        string automaton;
+        if (!WriteAutomaton(GroupPattern(number_format.pattern(), j),
+                            &automaton, error)) {
+          return false;
+        }
+        group_automata += "  " + automaton + ",\n";
+      }
+      string format_rule;
+      if (!GetFormatRule(number_format, national,
+                         static_cast<int>(groups.size()), &format_rule,
+                         error)) {
+        return false;
+      }
+      const string groups_table =
+          "k" + name + "Format" + std::to_string(i) + "Groups";
+      tables_ += "inline constexpr DigitAutomaton " + groups_table + "[] = {\n" +
+                 group_automata + "};\n";
+      string leading_digits = "{ NULL, NULL }";
+      const int num_leading_digits = number_format.leading_digits_pattern_size();
+      if (num_leading_digits > 0 &&
+          !WriteAutomaton(
+              number_format.leading_digits_pattern(num_leading_digits - 1),
+              &leading_digits, error)) {
+        return false;
+      }
+      entries += "  {\n    " + leading_digits + ",\n    " + groups_table +
+                 ", " + std::to_string(groups.size()) + ",\n    " +
+                 Quote(format_rule) + ",\n  },\n";
+    }
+    tables_ += "inline constexpr RegionNumberFormat k" + name +
+               "Formats[] = {\n" + entries + "};\n";
+    *table = table_namespace_ + "::k" + name + "Formats";
+    return true;
+  }
+
+  // Returns the pattern of the capturing group index of pattern, which is a
+  // concatenation of capturing groups.
+  static string GroupPattern(const string& pattern, size_t index) {
+    size_t start = 0;
+    for (size_t group = 0; group <= index; ++group) {
+      int depth = 0;
+      size_t end = start;
+      do {
+        if (pattern[end] == '(') {
+          ++depth;
+        } else if (pattern[end] == ')') {
+          --depth;
+        } else if (pattern[end] == '[') {
+          end = pattern.find(']', end);
+        }
+        ++end;
+      } while (depth > 0);
+      if (group == index) {
+        return pattern.substr(start + 1, end - start - 2);
+      }
+      start = end;
+    }
+    return "";
+  }
+
+  const PhoneMetadata& metadata_;
+  const string table_namespace_;
+  // The definitions of the tables of the region.
+  string tables_;
+  // The DigitAutomaton initializers of the patterns already written.
+  map<string, string> automata_;
+};
+
+}  // namespace
+
+bool CompileDigitAutomaton(const string& pattern, vector<uint16>* transitions,
+                           vector<uint8>* accepting, string* error) {
+  RegexNode node(RegexNode::DIGITS);
+  return RegexParser(pattern).Parse(&node, error) &&
+         CompileNode(node, transitions, accepting, error);
+}
+
+bool ExpandDigitPrefixes(const string& pattern,
+                         vector<vector<uint16> >* prefixes, string* error) {
+  RegexNode node(RegexNode::DIGITS);
+  if (!RegexParser(pattern).Parse(&node, error)) {
+    return false;
+  }
+  if (!Expand(node, kMaxPrefixes, prefixes)) {
+    *error = "unbounded or too large prefix pattern " + pattern;
+    return false;
+  }
+  return true;
+}
+
+bool GenerateRegionMetadataHeader(const PhoneMetadataCollection& collection,
+                                  const vector<string>& region_codes,
+                                  const string& header_guard, string* output,
+                                  string* error) {
+  set<int> country_code_set;
+  map<int, int> num_regions_for_country_code;
+  for (const PhoneMetadata& metadata : collection.metadata()) {
+    country_code_set.insert(metadata.country_code());
+    ++num_regions_for_country_code[metadata.country_code()];
+  }
+  const vector<int> country_codes(country_code_set.begin(),
+                                  country_code_set.end());
+
+  output->assign(
+      "// Generated by generate_region_metadata. Do not edit.\n\n"
+      "#ifndef " + header_guard + "\n#define " + header_guard + "\n\n"
+      "#include <cstddef>\n\n"
+      "#include \"phonenumbers/base/basictypes.h\"\n"
+      "#include \"phonenumbers/region_phonenumberutil.h\"\n\n"
+      "namespace i18n {\nnamespace phonenumbers {\n\n");
+  for (const string& region_code : region_codes) {
+    const PhoneMetadata* metadata = NULL;
+    for (const PhoneMetadata& candidate : collection.metadata()) {
+      if (candidate.id() == region_code) {
+        metadata = &candidate;
+      }
+    }
+    if (!metadata || region_code.length() != 2 ||
+        region_code[0] < 'A' || region_code[0] > 'Z' ||
+        region_code[1] < 'A' || region_code[1] > 'Z') {
+      *error = "unknown region " + region_code;
+      return false;
+    }
+    if (num_regions_for_country_code[metadata->country_code()] > 1 &&
+        !metadata->main_country_for_code()) {
+      *error = region_code + " isn't the main region of its country code";
+      return false;
+    }
+    if (!metadata->national_prefix_transform_rule().empty()) {
+      *error = region_code + " has a national prefix transform rule";
+      return false;
+    }
+    string table_namespace = "region_metadata_";
+    table_namespace.push_back(static_cast<char>(region_code[0] - 'A' + 'a'));
+    table_namespace.push_back(static_cast<char>(region_code[1] - 'A' + 'a'));
+    RegionWriter writer(*metadata, table_namespace);
+    string region_error;
+    if (!writer.Write(country_codes, output, &region_error)) {
+      *error = region_code + ": " + region_error;
+      return false;
+    }
+  }
+  output->append("}  // namespace phonenumbers\n}  // namespace i18n\n\n"
+                 "#endif  // " + header_guard + "\n");
+  return true;
+}
+
+}  // namespace phonenumbers
+}  // namespace i18n
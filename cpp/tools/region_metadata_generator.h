@@ -0,0 +1,67 @@
+// Copyright (C) 2026 The Libphonenumber Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Generates the RegionMetadata of regions for RegionPhoneNumberUtil, see
+// region_phonenumberutil.h. The patterns of the metadata are compiled into
+// minimal deterministic automata over the digits, and the international and
+// national prefixes are expanded into the prefixes they match.
+//
+// Only the subset of the regular expression syntax used by the metadata is
+// supported: digits, \d, character classes of digits, groups, alternations and
+// the greedy quantifiers ?, *, +, {n}, {n,} and {n,m}.
+
+#ifndef I18N_PHONENUMBERS_TOOLS_REGION_METADATA_GENERATOR_H_
+#define I18N_PHONENUMBERS_TOOLS_REGION_METADATA_GENERATOR_H_
+
+#include <string>
+#include <vector>
+
+#include "phonenumbers/base/basictypes.h"
+
+namespace i18n {
+namespace phonenumbers {
+
+using std::string;
+using std::vector;
+
+class PhoneMetadataCollection;
+
+// Compiles pattern into the minimal deterministic automaton matching the same
+// strings of digits, in the layout of DigitAutomaton: state 0 rejects every
+// input, state 1 is the initial state and transitions holds 10 transitions per
+// state. Returns false and sets error if pattern isn't supported or the
+// automaton has more than 65535 states.
+bool CompileDigitAutomaton(const string& pattern, vector<uint16>* transitions,
+                           vector<uint8>* accepting, string* error);
+
+// Expands pattern, which must match a bounded number of strings, into the
+// sequences of digit sets it matches, in the order a backtracking regular
+// expression engine tries them. Bit d of a digit set is set if it contains d.
+bool ExpandDigitPrefixes(const string& pattern,
+                         vector<vector<uint16> >* prefixes, string* error);
+
+// Writes to output a header defining the RegionMetadata of each region of
+// region_codes, kRegionMetadataDE for DE, and the RegionPhoneNumberUtilDE
+// typedef. Returns false and sets error if a region isn't supported: regions
+// which share their country calling code without being the main one, and
+// regions with a national prefix transform rule are not.
+bool GenerateRegionMetadataHeader(const PhoneMetadataCollection& collection,
+                                  const vector<string>& region_codes,
+                                  const string& header_guard, string* output,
+                                  string* error);
+
+}  // namespace phonenumbers
+}  // namespace i18n
+
+#endif  // I18N_PHONENUMBERS_TOOLS_REGION_METADATA_GENERATOR_H_